@@ -0,0 +1,147 @@
+#include "AllocationCounter.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+
+#if defined(__GLIBC__) || defined(_WIN32)
+#include <malloc.h>
+#endif
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::atomic<std::uint64_t> allocations{0};
+std::atomic<std::uint64_t> heldBytes{0};
+
+// Adds a block to heldBytes when it is allocated and subtracts it when it is freed
+void track(void* memory, bool allocated) {
+#ifdef __GLIBC__
+    const std::uint64_t size = malloc_usable_size(memory);
+    if (allocated) {
+        heldBytes.fetch_add(size, std::memory_order_relaxed);
+    } else {
+        heldBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+#else
+    (void)memory;
+    (void)allocated;
+#endif
+}
+
+void release(void* memory) {
+    if (memory != nullptr) {
+        track(memory, false);
+    }
+    std::free(memory);
+}
+
+void* allocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        track(memory, true);
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+// std::pmr::new_delete_resource() allocates through the aligned forms, so they are counted too
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    const auto align = static_cast<std::size_t>(alignment);
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+#ifdef _WIN32
+    if (void* memory = _aligned_malloc(rounded, align)) {
+#else
+    if (void* memory = std::aligned_alloc(align, rounded)) {
+#endif
+        track(memory, true);
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void freeAligned(void* memory) {
+#ifdef _WIN32
+    _aligned_free(memory);
+#else
+    release(memory);
+#endif
+}
+
+} // namespace
+
+std::uint64_t AllocationCounter::count() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::liveBytes() {
+    return heldBytes.load(std::memory_order_relaxed);
+}
+
+std::uint64_t AllocationCounter::residentBytes() {
+#ifdef __GLIBC__
+    malloc_trim(0);
+#endif
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    std::uint64_t totalPages = 0;
+    std::uint64_t residentPages = 0;
+    if (statm >> totalPages >> residentPages) {
+        return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+// Replacements of the global allocation functions; the array and sized forms forward here
+void* operator new(std::size_t size) {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return allocate(size);
+}
+
+void operator delete(void* memory) noexcept {
+    release(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    release(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    release(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    release(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    freeAligned(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    freeAligned(memory);
+}
@@ -0,0 +1,41 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+/**
+ * @brief Counts the calls to the global operator new made by the benchmark process.
+ *
+ * AllocationCounter.cpp replaces the global operator new/delete of oop_bench, so
+ * every heap allocation of the model code is counted. Read the count before and
+ * after the code under test:
+ *
+ *     const auto before = AllocationCounter::count();
+ *     buildMenu();
+ *     state.setCounter("allocs", AllocationCounter::count() - before);
+ */
+class AllocationCounter {
+public:
+    /**
+     * @brief Returns the number of allocations since the process started.
+     */
+    static std::uint64_t count();
+
+    /**
+     * @brief Returns the bytes of the heap blocks allocated and not yet freed, or 0 where it cannot be read.
+     *
+     * Blocks are counted at their usable size (glibc only), so the allocator's rounding
+     * is included; the difference between two readings is the memory a structure holds.
+     */
+    static std::uint64_t liveBytes();
+
+    /**
+     * @brief Returns the resident set size of the process in bytes, or 0 where it cannot be read.
+     *
+     * Free heap pages are handed back to the operating system first (glibc only), so
+     * the difference between two readings reflects the memory still in use.
+     */
+    static std::uint64_t residentBytes();
+};
+
+#endif // ALLOCATION_COUNTER_H
@@ -0,0 +1,235 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace {
+
+// Result of one benchmark run with one argument
+struct BenchmarkResult {
+    std::string name;
+    std::int64_t iterations;
+    double realNanoseconds; // Per iteration
+    double cpuNanoseconds;  // Per iteration
+    double itemsPerSecond;
+    std::map<std::string, double> counters;
+};
+
+struct Options {
+    std::string filter;
+    double minTime = 0.2;
+    std::int64_t maxSize = -1;
+    std::string format = "console";
+    std::string outFile;
+};
+
+std::vector<std::unique_ptr<BenchmarkDefinition>>& registry() {
+    static std::vector<std::unique_ptr<BenchmarkDefinition>> definitions;
+    return definitions;
+}
+
+// Escapes a string for a JSON string literal
+std::string jsonEscape(const std::string& text) {
+    std::string escaped;
+    for (const char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void printJson(std::ostream& os, const std::vector<BenchmarkResult>& results, const char* executable) {
+    const std::time_t now = std::time(nullptr);
+    char date[64];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << "{\n  \"context\": {\n";
+    os << "    \"date\": \"" << date << "\",\n";
+    os << "    \"executable\": \"" << jsonEscape(executable) << "\",\n";
+    os << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+    os << "    \"library_build_type\": \"release\"\n";
+#else
+    os << "    \"library_build_type\": \"debug\"\n";
+#endif
+    os << "  },\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto& result = results[i];
+        os << "    {\n";
+        os << "      \"name\": \"" << jsonEscape(result.name) << "\",\n";
+        os << "      \"iterations\": " << result.iterations << ",\n";
+        os << "      \"real_time\": " << std::setprecision(10) << result.realNanoseconds << ",\n";
+        os << "      \"cpu_time\": " << result.cpuNanoseconds << ",\n";
+        os << "      \"time_unit\": \"ns\"";
+        if (result.itemsPerSecond > 0) {
+            os << ",\n      \"items_per_second\": " << result.itemsPerSecond;
+        }
+        for (const auto& [counter, value] : result.counters) {
+            os << ",\n      \"" << jsonEscape(counter) << "\": " << value;
+        }
+        os << "\n    }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+void printConsoleLine(const BenchmarkResult& result) {
+    std::cout << std::left << std::setw(48) << result.name << std::right
+              << std::setw(14) << std::fixed << std::setprecision(0) << result.realNanoseconds << " ns"
+              << std::setw(14) << result.cpuNanoseconds << " ns"
+              << std::setw(12) << result.iterations;
+    if (result.itemsPerSecond > 0) {
+        std::cout << "  items/s=" << std::setprecision(3) << std::scientific << result.itemsPerSecond;
+    }
+    for (const auto& [counter, value] : result.counters) {
+        std::cout << "  " << counter << "=" << std::setprecision(3) << std::defaultfloat << value;
+    }
+    std::cout << std::defaultfloat << "\n";
+}
+
+// Runs one benchmark with growing iteration counts until it lasts at least minTime
+BenchmarkResult runOne(const std::string& name, const BenchmarkDefinition::Function& function,
+                       std::int64_t argument, double minTime) {
+    std::int64_t iterations = 1;
+    while (true) {
+        BenchmarkState state(argument, iterations);
+        function(state);
+        const double wall = state.wallSecondsElapsed();
+        if (wall >= minTime || iterations >= 1'000'000'000) {
+            BenchmarkResult result{name, iterations, wall * 1e9 / static_cast<double>(iterations),
+                                   state.cpuSecondsElapsed() * 1e9 / static_cast<double>(iterations), 0, state.counterValues()};
+            if (state.itemsProcessedCount() > 0 && wall > 0) {
+                result.itemsPerSecond = static_cast<double>(state.itemsProcessedCount()) / wall;
+            }
+            return result;
+        }
+        // Predict the iterations needed, growing at most 10x per attempt
+        const double factor = wall > 0 ? std::min(10.0, std::max(1.4 * minTime / wall, 1.5)) : 10.0;
+        iterations = std::max(iterations + 1, static_cast<std::int64_t>(std::ceil(static_cast<double>(iterations) * factor)));
+    }
+}
+
+Options parseOptions(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const auto value = [&](const std::string& flag) -> const char* {
+            return argument.rfind(flag + "=", 0) == 0 ? argv[i] + flag.size() + 1 : nullptr;
+        };
+        if (const char* filter = value("--benchmark_filter")) {
+            options.filter = filter;
+        } else if (const char* minTime = value("--benchmark_min_time")) {
+            options.minTime = std::stod(minTime);
+        } else if (const char* maxSize = value("--benchmark_max_size")) {
+            options.maxSize = std::stoll(maxSize);
+        } else if (const char* format = value("--benchmark_format")) {
+            options.format = format;
+        } else if (const char* outFile = value("--benchmark_out")) {
+            options.outFile = outFile;
+        } else {
+            std::cerr << "Unknown option: " << argument << "\n";
+        }
+    }
+    return options;
+}
+
+} // namespace
+
+void BenchmarkState::start() {
+    running = true;
+    wallStart = Clock::now();
+    cpuStart = std::clock();
+}
+
+void BenchmarkState::finish() {
+    if (running) {
+        pauseTiming();
+    }
+}
+
+void BenchmarkState::pauseTiming() {
+    wallSeconds += std::chrono::duration<double>(Clock::now() - wallStart).count();
+    cpuSeconds += static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    running = false;
+}
+
+void BenchmarkState::resumeTiming() {
+    start();
+}
+
+BenchmarkDefinition* BenchmarkDefinition::arg(std::int64_t value) {
+    arguments.push_back(value);
+    return this;
+}
+
+BenchmarkDefinition* BenchmarkDefinition::rangeMultiplier(std::int64_t value) {
+    multiplier = value;
+    return this;
+}
+
+BenchmarkDefinition* BenchmarkDefinition::range(std::int64_t low, std::int64_t high) {
+    for (std::int64_t value = low; value < high; value *= multiplier) {
+        arguments.push_back(value);
+    }
+    arguments.push_back(high);
+    return this;
+}
+
+BenchmarkDefinition* BenchmarkRunner::add(const std::string& name, BenchmarkDefinition::Function function) {
+    registry().push_back(std::make_unique<BenchmarkDefinition>(name, std::move(function)));
+    return registry().back().get();
+}
+
+int BenchmarkRunner::runAll(int argc, char* argv[]) {
+    const Options options = parseOptions(argc, argv);
+    const bool json = options.format == "json";
+    if (!json) {
+        std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(17) << "Time"
+                  << std::setw(17) << "CPU" << std::setw(12) << "Iterations" << "\n"
+                  << std::string(94, '-') << "\n";
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& definition : registry()) {
+        std::vector<std::int64_t> arguments = definition->arguments;
+        if (arguments.empty()) {
+            arguments.push_back(0);
+        }
+        for (const std::int64_t argument : arguments) {
+            if (options.maxSize >= 0 && argument > options.maxSize) {
+                continue;
+            }
+            std::string name = definition->name;
+            if (!definition->arguments.empty()) {
+                name += '/';
+                name += std::to_string(argument);
+            }
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+            results.push_back(runOne(name, definition->function, argument, options.minTime));
+            if (!json) {
+                printConsoleLine(results.back());
+            }
+        }
+    }
+
+    if (json) {
+        printJson(std::cout, results, argv[0]);
+    }
+    if (!options.outFile.empty()) {
+        std::ofstream out(options.outFile);
+        printJson(out, results, argv[0]);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    return BenchmarkRunner::runAll(argc, argv);
+}
@@ -0,0 +1,182 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Minimal Google-Benchmark-style harness for the oop_bench target.
+ *
+ * Benchmarks are plain functions taking a BenchmarkState&, registered with the
+ * BENCHMARK macro and run once per argument:
+ *
+ *     void BM_Sort(BenchmarkState& state) {
+ *         auto menu = makeMenu(state.range());
+ *         for (auto _ : state) { ... }
+ *         state.setItemsProcessed(state.iterations() * state.range());
+ *     }
+ *     BENCHMARK(BM_Sort)->rangeMultiplier(10)->range(10, 1'000'000);
+ *
+ * Command line: --benchmark_filter=<substring> --benchmark_min_time=<seconds>
+ * --benchmark_max_size=<n> --benchmark_format=<console|json> --benchmark_out=<file>
+ */
+class BenchmarkState {
+public:
+    BenchmarkState(std::int64_t argument, std::int64_t maxIterations)
+        : argument(argument), maxIterations(maxIterations) {}
+
+    /**
+     * @brief Returns the argument the benchmark runs with (e.g., catalog size).
+     */
+    [[nodiscard]] std::int64_t range() const { return argument; }
+
+    /**
+     * @brief Returns the number of iterations of the timed loop.
+     */
+    [[nodiscard]] std::int64_t iterations() const { return maxIterations; }
+
+    /**
+     * @brief Stops the clock while per-iteration setup runs.
+     */
+    void pauseTiming();
+
+    /**
+     * @brief Restarts the clock after pauseTiming().
+     */
+    void resumeTiming();
+
+    /**
+     * @brief Reports the number of items handled, used to compute items per second.
+     */
+    void setItemsProcessed(std::int64_t items) { itemsProcessed = items; }
+
+    /**
+     * @brief Attaches a custom counter to the result (e.g., bytes, allocations per item).
+     */
+    void setCounter(const std::string& name, double value) { counters[name] = value; }
+
+    // Iteration support for "for (auto _ : state)"; the loop variable's type is marked unused
+    struct [[maybe_unused]] Value {};
+    struct Iterator {
+        BenchmarkState* state;
+        std::int64_t remaining;
+        bool operator!=(const Iterator& other) const {
+            if (remaining != other.remaining) {
+                return true;
+            }
+            state->finish();
+            return false;
+        }
+        Iterator& operator++() {
+            --remaining;
+            return *this;
+        }
+        Value operator*() const { return {}; }
+    };
+    Iterator begin() {
+        start();
+        return {this, maxIterations};
+    }
+    Iterator end() { return {this, 0}; }
+
+    // Measurements read by the runner once the timed loop is over
+    [[nodiscard]] double wallSecondsElapsed() const { return wallSeconds; }
+    [[nodiscard]] double cpuSecondsElapsed() const { return cpuSeconds; }
+    [[nodiscard]] std::int64_t itemsProcessedCount() const { return itemsProcessed; }
+    [[nodiscard]] const std::map<std::string, double>& counterValues() const { return counters; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::int64_t argument;
+    std::int64_t maxIterations;
+    std::int64_t itemsProcessed = 0;
+    std::map<std::string, double> counters;
+
+    Clock::time_point wallStart;
+    std::clock_t cpuStart = 0;
+    double wallSeconds = 0;
+    double cpuSeconds = 0;
+    bool running = false;
+
+    void start();
+    void finish();
+};
+
+/**
+ * @brief Registered benchmark with its list of arguments.
+ */
+class BenchmarkDefinition {
+public:
+    using Function = std::function<void(BenchmarkState&)>;
+
+    BenchmarkDefinition(std::string name, Function function) : name(std::move(name)), function(std::move(function)) {}
+
+    /**
+     * @brief Adds a single argument.
+     */
+    BenchmarkDefinition* arg(std::int64_t value);
+
+    /**
+     * @brief Sets the factor between consecutive arguments generated by range().
+     */
+    BenchmarkDefinition* rangeMultiplier(std::int64_t multiplier);
+
+    /**
+     * @brief Adds the arguments low, low * multiplier, ... up to and including high.
+     */
+    BenchmarkDefinition* range(std::int64_t low, std::int64_t high);
+
+private:
+    friend class BenchmarkRunner;
+
+    std::string name;
+    Function function;
+    std::vector<std::int64_t> arguments;
+    std::int64_t multiplier = 8;
+};
+
+/**
+ * @brief Keeps the registered benchmarks and runs them.
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * @brief Registers a benchmark; used by the BENCHMARK macro.
+     */
+    static BenchmarkDefinition* add(const std::string& name, BenchmarkDefinition::Function function);
+
+    /**
+     * @brief Parses the command line, runs the selected benchmarks and prints the results.
+     *
+     * @return The process exit code.
+     */
+    static int runAll(int argc, char* argv[]);
+};
+
+/**
+ * @brief Prevents the compiler from optimizing away a computed value.
+ */
+template <typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+#define BENCHMARK_CONCAT_INNER(a, b) a##b
+#define BENCHMARK_CONCAT(a, b) BENCHMARK_CONCAT_INNER(a, b)
+#define BENCHMARK(function) \
+    static BenchmarkDefinition* BENCHMARK_CONCAT(benchmarkRegistration_, __LINE__) = \
+        BenchmarkRunner::add(#function, function)
+
+#endif // BENCHMARK_H
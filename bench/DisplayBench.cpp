@@ -0,0 +1,50 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Lunch.h"
+#include "../h/MenuContext.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuRenderer.h"
+
+// Throughput of the wire formats of the display strategies over a generated menu of
+// range() dishes. Each format is selected through MenuContext, as a kiosk request
+// would, and encoded into a renderer that is reused between iterations.
+
+namespace {
+
+constexpr std::int64_t DishesPerCategory = 100;
+
+void runEncode(BenchmarkState& state, MenuFormat format) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    MenuContext context(nullptr);
+    context.setFormat(format);
+    MenuRenderer renderer;
+    std::size_t bytes = 0;
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        renderer.clear();
+        context.encodeMenu(menu, renderer);
+        bytes = renderer.view().size();
+        doNotOptimize(renderer.view());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("bytes", static_cast<double>(bytes));
+    state.setCounter("allocs/encode", static_cast<double>(AllocationCounter::count() - before)
+                                          / static_cast<double>(state.iterations()));
+}
+
+void BM_EncodeText(BenchmarkState& state) {
+    runEncode(state, MenuFormat::Text);
+}
+BENCHMARK(BM_EncodeText)->rangeMultiplier(10)->range(100, 1'000'000);
+
+void BM_EncodeJson(BenchmarkState& state) {
+    runEncode(state, MenuFormat::Json);
+}
+BENCHMARK(BM_EncodeJson)->rangeMultiplier(10)->range(100, 1'000'000);
+
+void BM_EncodeBinary(BenchmarkState& state) {
+    runEncode(state, MenuFormat::Binary);
+}
+BENCHMARK(BM_EncodeBinary)->rangeMultiplier(10)->range(100, 1'000'000);
+
+} // namespace
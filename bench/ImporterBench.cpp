@@ -0,0 +1,83 @@
+#include "Benchmark.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuImporter.h"
+#include <sstream>
+#include <string>
+
+// Import throughput of CSV and JSON Lines exports (up to 1M rows), single-threaded and on every core
+
+namespace {
+
+constexpr std::int64_t MinDishes = 10'000;
+constexpr std::int64_t MaxDishes = 1'000'000;
+
+// Renders generated dishes in the importer's CSV or JSON Lines layout
+std::string makeExport(std::size_t dishes, ImportFormat format) {
+    static constexpr const char* typeNames[] = {"VEGETABLE", "DAIRY", "MEAT", "SPICE", "SAUCE", "DESSERT", "CEREAL"};
+    std::ostringstream out;
+    if (format == ImportFormat::Csv) {
+        out << "category,dish,price,weight,ingredients\n";
+    }
+    MenuGenerator generator;
+    generator.streamCategories(dishes, 100, [&](Category&& category) {
+        for (const auto& dish : category.getDishes()) {
+            if (format == ImportFormat::Csv) {
+                out << category.getName() << ',' << dish.getName() << ',' << dish.getPrice() << ',' << dish.getWeight() << ',';
+                const char* separator = "";
+                for (const auto& ingredient : dish.getIngredients()) {
+                    out << separator << ingredient.getName() << ':' << typeNames[static_cast<int>(ingredient.getType())];
+                    separator = ";";
+                }
+            } else {
+                out << R"({"category":")" << category.getName() << R"(","dish":")" << dish.getName()
+                    << R"(","price":)" << dish.getPrice() << R"(,"weight":)" << dish.getWeight() << R"(,"ingredients":[)";
+                const char* separator = "";
+                for (const auto& ingredient : dish.getIngredients()) {
+                    out << separator << R"({"name":")" << ingredient.getName() << R"(","type":")"
+                        << typeNames[static_cast<int>(ingredient.getType())] << "\"}";
+                    separator = ",";
+                }
+                out << "]}";
+            }
+            out << '\n';
+        }
+    });
+    return out.str();
+}
+
+void runImport(BenchmarkState& state, ImportFormat format, unsigned threads) {
+    const std::string text = makeExport(static_cast<std::size_t>(state.range()), format);
+    ImportOptions options;
+    options.format = format;
+    options.threads = threads;
+    options.chunkSize = 1u << 20;
+    double megabytesPerSecond = 0;
+    for (auto _ : state) {
+        state.pauseTiming();
+        std::istringstream input(text);
+        state.resumeTiming();
+        std::size_t dishes = 0;
+        const ImportReport report = MenuImporter(options).importDishes(input, [&](std::string_view, Dish&&) { ++dishes; });
+        megabytesPerSecond = report.megabytesPerSecond();
+        doNotOptimize(dishes);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("MB/s", megabytesPerSecond);
+}
+
+void BM_MenuImporterCsvSingleThread(BenchmarkState& state) {
+    runImport(state, ImportFormat::Csv, 1);
+}
+BENCHMARK(BM_MenuImporterCsvSingleThread)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuImporterCsv(BenchmarkState& state) {
+    runImport(state, ImportFormat::Csv, 0);
+}
+BENCHMARK(BM_MenuImporterCsv)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuImporterJsonLines(BenchmarkState& state) {
+    runImport(state, ImportFormat::JsonLines, 0);
+}
+BENCHMARK(BM_MenuImporterJsonLines)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+} // namespace
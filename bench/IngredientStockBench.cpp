@@ -0,0 +1,123 @@
+#include "Benchmark.h"
+#include "../h/IngredientStock.h"
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Latency of reserving and releasing a dish while range() other threads do the same.
+// In the "Popular" benchmarks every thread orders the same dish, so all of them update
+// the same four ingredient counters; in "Spread" each thread orders its own dish. The
+// baseline keeps the whole stock in one map behind a global mutex.
+
+namespace {
+
+constexpr std::int64_t MinThreads = 1;
+constexpr std::int64_t MaxThreads = 8;
+constexpr std::int64_t PlentyOfUnits = std::int64_t{1} << 40;
+
+Dish makeDish(const std::string& name) {
+    return Dish(name, 25.0, 300.0f,
+                {Ingredient(name + " base", FoodType::CEREAL), Ingredient(name + " sauce", FoodType::SAUCE),
+                 Ingredient(name + " cheese", FoodType::DAIRY), Ingredient(name + " topping", FoodType::VEGETABLE)});
+}
+
+// Baseline: the same all-or-nothing reservation, under one lock
+class LockedStock {
+public:
+    void setStock(const Ingredient& ingredient, std::int64_t units) {
+        const std::scoped_lock lock(mutex);
+        levels[ingredient.getSymbol()] = units;
+    }
+
+    bool reserve(const Dish& dish) {
+        const std::scoped_lock lock(mutex);
+        for (const auto& ingredient : dish.getIngredients()) {
+            if (levels[ingredient.getSymbol()] < 1) {
+                return false;
+            }
+        }
+        for (const auto& ingredient : dish.getIngredients()) {
+            --levels[ingredient.getSymbol()];
+        }
+        return true;
+    }
+
+    void release(const Dish& dish) {
+        const std::scoped_lock lock(mutex);
+        for (const auto& ingredient : dish.getIngredients()) {
+            ++levels[ingredient.getSymbol()];
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<Symbol, std::int64_t> levels;
+};
+
+template <typename Stock>
+void runReservations(BenchmarkState& state, bool popular) {
+    Stock stock;
+    const auto threads = static_cast<std::size_t>(state.range());
+    std::vector<Dish> dishes;
+    for (std::size_t i = 0; i <= threads; ++i) {
+        dishes.push_back(makeDish(popular ? std::string("Margherita") : "Pizza " + std::to_string(i)));
+        for (const auto& ingredient : dishes.back().getIngredients()) {
+            stock.setStock(ingredient, PlentyOfUnits);
+        }
+    }
+    std::vector<std::jthread> others;
+    for (std::size_t i = 1; i <= threads; ++i) {
+        others.emplace_back([&stock, &dish = dishes[i]](std::stop_token stop) {
+            while (!stop.stop_requested()) {
+                if (stock.reserve(dish)) {
+                    stock.release(dish);
+                }
+            }
+        });
+    }
+    for (auto _ : state) {
+        if (stock.reserve(dishes.front())) {
+            stock.release(dishes.front());
+        }
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_StockPopularDish(BenchmarkState& state) {
+    runReservations<IngredientStock>(state, true);
+}
+BENCHMARK(BM_StockPopularDish)->rangeMultiplier(2)->range(MinThreads, MaxThreads);
+
+void BM_StockSpreadDishes(BenchmarkState& state) {
+    runReservations<IngredientStock>(state, false);
+}
+BENCHMARK(BM_StockSpreadDishes)->rangeMultiplier(2)->range(MinThreads, MaxThreads);
+
+void BM_LockedStockPopularDish(BenchmarkState& state) {
+    runReservations<LockedStock>(state, true);
+}
+BENCHMARK(BM_LockedStockPopularDish)->rangeMultiplier(2)->range(MinThreads, MaxThreads);
+
+void BM_LockedStockSpreadDishes(BenchmarkState& state) {
+    runReservations<LockedStock>(state, false);
+}
+BENCHMARK(BM_LockedStockSpreadDishes)->rangeMultiplier(2)->range(MinThreads, MaxThreads);
+
+// A dish ordered constantly but checked for display even more often: availability is one load
+void BM_StockDishAvailability(BenchmarkState& state) {
+    IngredientStock stock;
+    const Dish dish = makeDish("Quattro Formaggi");
+    for (const auto& ingredient : dish.getIngredients()) {
+        stock.setStock(ingredient, PlentyOfUnits);
+    }
+    stock.trackDish(dish);
+    for (auto _ : state) {
+        doNotOptimize(stock.isAvailable(dish));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StockDishAvailability);
+
+} // namespace
@@ -0,0 +1,78 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuJournal.h"
+#include <filesystem>
+#include <string>
+
+// Cost of journaling a menu change. With group commit the change only encodes its
+// record; the writer thread writes and fsyncs several changes at once. The baseline
+// waits for the fsync of every change, as a naive write-ahead log would.
+// Recovery replays range() journal records on top of the base snapshot.
+
+namespace {
+
+// A fresh journal directory, removed when the benchmark ends
+class JournalDirectory {
+public:
+    explicit JournalDirectory(const char* name) : path((std::filesystem::temp_directory_path() / name).string()) {
+        std::filesystem::remove_all(path);
+    }
+    ~JournalDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path, error);
+    }
+    JournalDirectory(const JournalDirectory&) = delete;
+    JournalDirectory& operator=(const JournalDirectory&) = delete;
+
+    const std::string path;
+};
+
+template <bool CommitEachChange>
+void runPriceUpdates(BenchmarkState& state) {
+    const JournalDirectory directory("oop_bench_journal");
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(1000, 100);
+    const std::string category(menu.getCategory().front().getName());
+    const std::string dish(menu.getCategory().front().getDishes().front().getName());
+    MenuJournal journal(menu, directory.path, {.compactAfterBytes = 0});
+    std::int64_t bani = 1000;
+    for (auto _ : state) {
+        menu.updateDishPrice(category, dish, Money::fromBani(++bani));
+        if constexpr (CommitEachChange) {
+            journal.commit();
+        }
+    }
+    journal.commit();
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("changes/sync", static_cast<double>(state.iterations()) / static_cast<double>(std::max<std::uint64_t>(journal.syncs(), 1)));
+}
+
+void BM_JournalGroupCommit(BenchmarkState& state) {
+    runPriceUpdates<false>(state);
+}
+BENCHMARK(BM_JournalGroupCommit);
+
+void BM_JournalSyncEachChange(BenchmarkState& state) {
+    runPriceUpdates<true>(state);
+}
+BENCHMARK(BM_JournalSyncEachChange);
+
+void BM_JournalRecover(BenchmarkState& state) {
+    const JournalDirectory directory("oop_bench_journal_recover");
+    {
+        Lunch menu = MenuGenerator().nextMenu<Lunch>(10'000, 100);
+        const std::string category(menu.getCategory().front().getName());
+        const std::string dish(menu.getCategory().front().getDishes().front().getName());
+        MenuJournal journal(menu, directory.path, {.compactAfterBytes = 0});
+        for (std::int64_t i = 0; i < state.range(); ++i) {
+            menu.updateDishPrice(category, dish, Money::fromBani(1000 + i));
+        }
+    }
+    for (auto _ : state) {
+        doNotOptimize(MenuJournal::recover(directory.path));
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_JournalRecover)->rangeMultiplier(10)->range(1000, 100'000);
+
+} // namespace
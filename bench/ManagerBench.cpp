@@ -0,0 +1,133 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuManager.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Latency of reading the published menu while range() other threads read it too and
+// an admin thread publishes a new version every millisecond. The manager's read()
+// only compares a version counter; snapshot() copies the atomic shared pointer (one
+// shared reference count); the baseline is a shared pointer guarded by a mutex.
+// Last, the demo's read path: read() looking a dish up by category and dish name,
+// which resolves the name through the symbol table without a lock.
+
+namespace {
+
+constexpr std::int64_t MinReaders = 1;
+constexpr std::int64_t MaxReaders = 8;
+
+Money lookupPrice(const Menu& menu) {
+    return menu.getCategory().front().getDishes().front().getPrice();
+}
+
+// Baseline: every read locks a mutex to copy the current pointer
+class LockedMenu {
+public:
+    std::shared_ptr<const Menu> get() const {
+        std::lock_guard lock(mutex);
+        return menu;
+    }
+
+    void set(std::shared_ptr<const Menu> next) {
+        std::lock_guard lock(mutex);
+        menu = std::move(next);
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::shared_ptr<const Menu> menu;
+};
+
+// Background readers and a publisher, stopped and joined when it goes out of scope
+template <typename Read, typename Publish>
+class Contention {
+public:
+    Contention(std::int64_t readers, Read read, Publish publish) {
+        for (std::int64_t i = 0; i < readers; ++i) {
+            threads.emplace_back([read](std::stop_token stop) {
+                while (!stop.stop_requested()) {
+                    doNotOptimize(read());
+                }
+            });
+        }
+        threads.emplace_back([publish](std::stop_token stop) mutable {
+            while (!stop.stop_requested()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                publish();
+            }
+        });
+    }
+
+private:
+    std::vector<std::jthread> threads;
+};
+
+template <typename Read, typename Publish>
+void runReads(BenchmarkState& state, Read read, Publish publish) {
+    const Contention contention(state.range(), read, publish);
+    for (auto _ : state) {
+        doNotOptimize(read());
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_ManagerRead(BenchmarkState& state) {
+    MenuManager& manager = MenuManager::getInstance();
+    manager.setMenu(std::make_unique<Lunch>(MenuGenerator().nextMenu<Lunch>(100, 10)));
+    std::int64_t bani = 1000;
+    runReads(state,
+             [&manager] { return manager.read(lookupPrice); },
+             [&manager, bani]() mutable {
+                 manager.update([&bani](Menu& menu) {
+                     const Category& category = menu.getCategory().front();
+                     menu.updateDishPrice(category.getName(), category.getDishes().front().getName(), Money::fromBani(++bani));
+                 });
+             });
+    manager.setMenu(nullptr);
+}
+BENCHMARK(BM_ManagerRead)->rangeMultiplier(2)->range(MinReaders, MaxReaders);
+
+void BM_ManagerSnapshot(BenchmarkState& state) {
+    MenuManager& manager = MenuManager::getInstance();
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(100, 10);
+    manager.setMenu(menu.clone());
+    runReads(state,
+             [&manager] { return lookupPrice(*manager.snapshot()); },
+             [&manager, &menu] { manager.setMenu(menu.clone()); });
+    manager.setMenu(nullptr);
+}
+BENCHMARK(BM_ManagerSnapshot)->rangeMultiplier(2)->range(MinReaders, MaxReaders);
+
+void BM_MutexRead(BenchmarkState& state) {
+    LockedMenu locked;
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(100, 10);
+    locked.set(menu.clone());
+    runReads(state,
+             [&locked] { return lookupPrice(*locked.get()); },
+             [&locked, &menu] { locked.set(menu.clone()); });
+}
+BENCHMARK(BM_MutexRead)->rangeMultiplier(2)->range(MinReaders, MaxReaders);
+
+void BM_ManagerFindDish(BenchmarkState& state) {
+    MenuManager& manager = MenuManager::getInstance();
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(100, 10);
+    const Category& last = menu.getCategory().back();
+    const std::string category(last.getName());
+    const std::string dish(last.getDishes().back().getName());
+    manager.setMenu(menu.clone());
+    runReads(state,
+             [&manager, &category, &dish] {
+                 return manager.read([&](const Menu& published) { return published.findDish(category, dish); });
+             },
+             [&manager, &menu] { manager.setMenu(menu.clone()); });
+    manager.setMenu(nullptr);
+}
+BENCHMARK(BM_ManagerFindDish)->rangeMultiplier(2)->range(MinReaders, MaxReaders);
+
+} // namespace
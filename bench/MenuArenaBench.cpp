@@ -0,0 +1,105 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Lunch.h"
+#include "../h/MenuArena.h"
+#include "../h/MenuGenerator.h"
+#include <memory>
+#include <optional>
+
+// Build and teardown of a complete menu tree on the heap versus inside a MenuArena.
+// Both variants deep-copy the same generated menu; the counters are measured once,
+// outside the timed loop: "allocs/dish" counts the calls to operator new and
+// "RSS MB" is the growth of the resident set while the copy is alive.
+
+namespace {
+
+constexpr std::int64_t MinDishes = 1000;
+constexpr std::int64_t MaxDishes = 1'000'000;
+
+// Every string and vector of the copy comes from the global heap
+struct HeapTree {
+    std::unique_ptr<Lunch> menu;
+
+    void build(const Lunch& source) {
+        menu = std::make_unique<Lunch>(source.getCategory());
+    }
+    void clear() {
+        menu.reset();
+    }
+};
+
+// The copy is laid out in the blocks of one arena
+struct ArenaTree {
+    std::optional<MenuArena> arena;
+
+    void build(const Lunch& source) {
+        arena.emplace();
+        arena->copyMenu(source);
+    }
+    void clear() {
+        arena.reset();
+    }
+};
+
+template <typename Tree>
+void measureFootprint(BenchmarkState& state, const Lunch& source) {
+    Tree tree;
+    const std::uint64_t residentBefore = AllocationCounter::residentBytes();
+    const std::uint64_t allocationsBefore = AllocationCounter::count();
+    tree.build(source);
+    const std::uint64_t allocations = AllocationCounter::count() - allocationsBefore;
+    const std::uint64_t residentAfter = AllocationCounter::residentBytes();
+    tree.clear();
+    state.setCounter("allocs/dish", static_cast<double>(allocations) / static_cast<double>(state.range()));
+    state.setCounter("RSS MB", residentAfter > residentBefore ? static_cast<double>(residentAfter - residentBefore) / 1e6 : 0.0);
+}
+
+template <typename Tree>
+void runBuild(BenchmarkState& state) {
+    const Lunch source = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    measureFootprint<Tree>(state, source);
+    for (auto _ : state) {
+        Tree tree;
+        tree.build(source);
+        state.pauseTiming();
+        tree.clear();
+        state.resumeTiming();
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+template <typename Tree>
+void runTeardown(BenchmarkState& state) {
+    const Lunch source = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    measureFootprint<Tree>(state, source);
+    for (auto _ : state) {
+        state.pauseTiming();
+        Tree tree;
+        tree.build(source);
+        state.resumeTiming();
+        tree.clear();
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+void BM_MenuHeapBuild(BenchmarkState& state) {
+    runBuild<HeapTree>(state);
+}
+BENCHMARK(BM_MenuHeapBuild)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuArenaBuild(BenchmarkState& state) {
+    runBuild<ArenaTree>(state);
+}
+BENCHMARK(BM_MenuArenaBuild)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuHeapTeardown(BenchmarkState& state) {
+    runTeardown<HeapTree>(state);
+}
+BENCHMARK(BM_MenuHeapTeardown)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuArenaTeardown(BenchmarkState& state) {
+    runTeardown<ArenaTree>(state);
+}
+BENCHMARK(BM_MenuArenaTeardown)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+} // namespace
@@ -0,0 +1,162 @@
+#include "Benchmark.h"
+#include "../h/Category.h"
+#include "../h/Lunch.h"
+#include "../h/Menu.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuInventory.h"
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+
+// Benchmarks of the menu model hot paths, parameterized by the number of dishes
+
+namespace {
+
+constexpr std::int64_t MinDishes = 10;
+constexpr std::int64_t MaxDishes = 1'000'000;
+
+// Discards everything written to it, used to time print() without a terminal
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Redirects std::cout to a NullBuffer for the lifetime of the object
+class SilencedCout {
+public:
+    SilencedCout() : previous(std::cout.rdbuf(&sink)) {}
+    ~SilencedCout() { std::cout.rdbuf(previous); }
+    SilencedCout(const SilencedCout&) = delete;
+    SilencedCout& operator=(const SilencedCout&) = delete;
+
+private:
+    NullBuffer sink;
+    std::streambuf* previous;
+};
+
+void BM_CategorySortDishesAlphabetically(BenchmarkState& state) {
+    const Category unsorted = MenuGenerator().nextCategory(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        state.pauseTiming();
+        Category category = unsorted;
+        state.resumeTiming();
+        category.sortDishesAlphabetically();
+        doNotOptimize(category);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_CategorySortDishesAlphabetically)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuSortCategories(BenchmarkState& state) {
+    const Lunch unsorted = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    for (auto _ : state) {
+        state.pauseTiming();
+        Lunch menu = unsorted;
+        state.resumeTiming();
+        menu.sortCategories();
+        doNotOptimize(menu);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuSortCategories)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuCalculateTotalPrice(BenchmarkState& state) {
+    const Category order = MenuGenerator().nextCategory(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        doNotOptimize(Menu::calculateTotalPrice(order.getDishes()));
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuCalculateTotalPrice)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_DishIsVegetarian(BenchmarkState& state) {
+    const Category category = MenuGenerator().nextCategory(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        std::size_t vegetarian = 0;
+        for (const auto& dish : category.getDishes()) {
+            vegetarian += dish.isVegetarian() ? 1 : 0;
+        }
+        doNotOptimize(vegetarian);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_DishIsVegetarian)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+// Removes a category and adds it back, so the menu keeps its size between iterations
+void BM_MenuRemoveCategory(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 10);
+    const Category removed = menu.getCategory().front();
+    for (auto _ : state) {
+        menu.removeCategory(removed.getName());
+        menu.addCategory(removed);
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MenuRemoveCategory)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+// Looks up every category by name through the hash index
+void BM_MenuFindCategory(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 10);
+    std::vector<std::string> names;
+    for (const auto& category : menu.getCategory()) {
+        names.emplace_back(category.getName());
+    }
+    for (auto _ : state) {
+        for (const auto& name : names) {
+            doNotOptimize(menu.findCategory(name));
+        }
+    }
+    state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(names.size()));
+}
+BENCHMARK(BM_MenuFindCategory)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuStreamOperator(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    std::ostringstream out;
+    for (auto _ : state) {
+        out.str({});
+        out << menu;
+        doNotOptimize(out);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("bytes", static_cast<double>(out.str().size()));
+}
+BENCHMARK(BM_MenuStreamOperator)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuPrint(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    const SilencedCout silenced;
+    for (auto _ : state) {
+        menu.display();
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuPrint)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuInventoryAddMenu(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    for (auto _ : state) {
+        MenuInventory<Lunch> inventory;
+        inventory.addMenu(menu);
+        doNotOptimize(inventory);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuInventoryAddMenu)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+// Generator throughput; categories are dropped as soon as they are produced
+void BM_MenuGeneratorStreamCategories(BenchmarkState& state) {
+    for (auto _ : state) {
+        MenuGenerator generator;
+        std::size_t dishes = 0;
+        generator.streamCategories(static_cast<std::size_t>(state.range()), 0, [&](Category&& category) {
+            dishes += category.getDishes().size();
+        });
+        doNotOptimize(dishes);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuGeneratorStreamCategories)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+} // namespace
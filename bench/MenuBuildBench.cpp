@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Lunch.h"
+#include "../h/MenuInventory.h"
+#include <string>
+#include <vector>
+
+// Cost of building an N-dish menu and storing it in a MenuInventory, with the
+// "allocs/dish" counter showing whether dishes are deep-copied along the way:
+// the emplace path stays at a constant number of allocations per dish (O(N) in
+// total) while the copying path pays one more for every layer it goes through.
+
+namespace {
+
+constexpr std::int64_t MinDishes = 1000;
+constexpr std::int64_t MaxDishes = 1'000'000;
+constexpr std::size_t DishesPerCategory = 100;
+
+// A few names reused by every dish, so interning does not allocate inside the timed loop
+const std::pmr::vector<Ingredient>& pantry() {
+    static const std::pmr::vector<Ingredient> ingredients = {
+        {"Tomatoes", FoodType::VEGETABLE}, {"Mozzarella", FoodType::DAIRY}, {"Basil", FoodType::SPICE}};
+    return ingredients;
+}
+
+std::string categoryName(std::size_t index) {
+    std::string name = "Category ";
+    name += std::to_string(index);
+    return name;
+}
+
+// Builds the menu through the const-reference API: every layer copies the dishes below it
+void buildByCopy(std::size_t dishes, MenuInventory<Lunch>& inventory) {
+    std::pmr::vector<Category> categories;
+    for (std::size_t first = 0, index = 0; first < dishes; first += DishesPerCategory, ++index) {
+        std::pmr::vector<Dish> categoryDishes;
+        for (std::size_t i = first; i < std::min(dishes, first + DishesPerCategory); ++i) {
+            const std::pmr::vector<Ingredient> ingredients = pantry();
+            const Dish dish("Margherita Pizza", 20.0, 300.0f, ingredients);
+            categoryDishes.push_back(dish);
+        }
+        const Category category(categoryName(index), categoryDishes);
+        categories.push_back(category);
+    }
+    const Lunch menu(categories);
+    inventory.addMenu(menu);
+}
+
+// Builds the menu in place with the emplace builders
+void buildInPlace(std::size_t dishes, MenuInventory<Lunch>& inventory) {
+    Lunch& menu = inventory.emplaceMenu(std::pmr::vector<Category>());
+    for (std::size_t first = 0, index = 0; first < dishes; first += DishesPerCategory, ++index) {
+        const std::string name = categoryName(index);
+        menu.emplaceCategory(name, std::pmr::vector<Dish>());
+        for (std::size_t i = first; i < std::min(dishes, first + DishesPerCategory); ++i) {
+            menu.emplaceDish(name, "Margherita Pizza", 20.0, 300.0f, pantry());
+        }
+    }
+}
+
+template <void (*Build)(std::size_t, MenuInventory<Lunch>&)>
+void runBuild(BenchmarkState& state) {
+    const auto dishes = static_cast<std::size_t>(state.range());
+    MenuInventory<Lunch> warmUp;
+    Build(1, warmUp); // Interns the names once, outside the measurement
+    std::uint64_t allocations = 0;
+    for (auto _ : state) {
+        MenuInventory<Lunch> inventory;
+        const std::uint64_t before = AllocationCounter::count();
+        Build(dishes, inventory);
+        allocations += AllocationCounter::count() - before;
+        doNotOptimize(inventory);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("allocs/dish", static_cast<double>(allocations) / static_cast<double>(state.iterations() * state.range()));
+}
+
+void BM_MenuBuildByCopy(BenchmarkState& state) {
+    runBuild<buildByCopy>(state);
+}
+BENCHMARK(BM_MenuBuildByCopy)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuBuildInPlace(BenchmarkState& state) {
+    runBuild<buildInPlace>(state);
+}
+BENCHMARK(BM_MenuBuildInPlace)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+} // namespace
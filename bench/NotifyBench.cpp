@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Lunch.h"
+#include "../h/NotificationDispatcher.h"
+#include <chrono>
+#include <thread>
+
+// Latency of a menu change (addCategory + removeCategory, two notifications) while an
+// observer takes about range() microseconds per call, e.g. a logger flushing to a slow
+// console. Synchronous delivery pays that cost on the changing thread; the dispatcher
+// moves it to its own thread and pays it once per batch.
+//
+// The price update benchmarks check the typed events: "allocs/change" must stay at 0
+// without observers and with an asynchronous observer, whose events are plain copies.
+
+namespace {
+
+constexpr std::int64_t MinDelayMicros = 1;
+constexpr std::int64_t MaxDelayMicros = 100;
+
+class SlowObserver : public Observer {
+public:
+    explicit SlowObserver(std::int64_t delayMicros) : delay(delayMicros) {}
+
+    void update(const MenuEvent&) override {
+        std::this_thread::sleep_for(delay);
+    }
+
+    void updateBatch(std::span<const MenuEvent>) override {
+        std::this_thread::sleep_for(delay);  // One flush for the whole batch
+    }
+
+private:
+    std::chrono::microseconds delay;
+};
+
+void changeMenu(BenchmarkState& state, Lunch& menu) {
+    for (auto _ : state) {
+        menu.addCategory(Category("Specials", {}));
+        menu.removeCategory("Specials");
+    }
+    state.setItemsProcessed(state.iterations() * 2);
+}
+
+void BM_NotifySync(BenchmarkState& state) {
+    SlowObserver observer(state.range());
+    Lunch menu{std::pmr::vector<Category>()};
+    menu.attach(&observer, Delivery::Sync);
+    changeMenu(state, menu);
+}
+BENCHMARK(BM_NotifySync)->rangeMultiplier(10)->range(MinDelayMicros, MaxDelayMicros);
+
+template <BackpressurePolicy Policy>
+void runAsync(BenchmarkState& state) {
+    SlowObserver observer(state.range());
+    NotificationDispatcher dispatcher({.backpressure = Policy});
+    Lunch menu{std::pmr::vector<Category>()};
+    menu.setDispatcher(&dispatcher);
+    menu.attach(&observer);
+    changeMenu(state, menu);
+    dispatcher.flush();
+    const auto batches = static_cast<double>(std::max<std::uint64_t>(dispatcher.batches(), 1));
+    state.setCounter("msgs/batch", static_cast<double>(dispatcher.delivered()) / batches);
+    state.setCounter("dropped", static_cast<double>(dispatcher.dropped()));
+}
+
+void BM_NotifyAsyncBlock(BenchmarkState& state) {
+    runAsync<BackpressurePolicy::Block>(state);
+}
+BENCHMARK(BM_NotifyAsyncBlock)->rangeMultiplier(10)->range(MinDelayMicros, MaxDelayMicros);
+
+void BM_NotifyAsyncDrop(BenchmarkState& state) {
+    runAsync<BackpressurePolicy::DropNewest>(state);
+}
+BENCHMARK(BM_NotifyAsyncDrop)->rangeMultiplier(10)->range(MinDelayMicros, MaxDelayMicros);
+
+class CountingObserver : public Observer {
+public:
+    void update(const MenuEvent& event) override {
+        total += event.newPrice;
+    }
+
+    Money total;
+};
+
+void runPriceUpdates(BenchmarkState& state, Lunch& menu) {
+    menu.addCategory(Category("Pizza", {Dish("Margherita Pizza", 20.0, 300.0f, {})}));
+    std::int64_t bani = 2000;
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        menu.updateDishPrice("Pizza", "Margherita Pizza", Money::fromBani(++bani));
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("allocs/change", static_cast<double>(AllocationCounter::count() - before) / static_cast<double>(state.iterations()));
+}
+
+void BM_PriceUpdateNoObservers(BenchmarkState& state) {
+    Lunch menu{std::pmr::vector<Category>()};
+    runPriceUpdates(state, menu);
+}
+BENCHMARK(BM_PriceUpdateNoObservers);
+
+void BM_PriceUpdateAsyncObserver(BenchmarkState& state) {
+    CountingObserver observer;
+    NotificationDispatcher dispatcher({.backpressure = BackpressurePolicy::DropNewest});
+    Lunch menu{std::pmr::vector<Category>()};
+    menu.setDispatcher(&dispatcher);
+    menu.attach(&observer);
+    runPriceUpdates(state, menu);
+    dispatcher.flush();
+}
+BENCHMARK(BM_PriceUpdateAsyncObserver);
+
+} // namespace
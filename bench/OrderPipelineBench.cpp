@@ -0,0 +1,77 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/OrderPipeline.h"
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// End-to-end throughput of the order pipeline with range() workers, on a synthetic
+// stream of orders of 1 to 6 lines over a 2000-dish menu; one order in a hundred
+// names a dish that is not on the menu and is rejected. Each iteration submits a
+// burst of orders and drains the pipeline. "p50 us" and "p99 us" are the latencies
+// from submission to completion; each station spends about 2 us per line.
+
+namespace {
+
+constexpr std::size_t OrdersPerBurst = 1000;
+
+std::vector<Order> makeOrderStream(const Menu& menu, std::size_t count) {
+    std::vector<std::pair<std::string, std::string>> dishes;
+    for (const auto& category : menu.getCategory()) {
+        for (const auto& dish : category.getDishes()) {
+            dishes.emplace_back(category.getName(), dish.getName());
+        }
+    }
+    std::mt19937_64 random(2024);
+    std::uniform_int_distribution<std::size_t> pickDish(0, dishes.size() - 1);
+    std::uniform_int_distribution<unsigned> pickLines(1, 6);
+    std::uniform_int_distribution<unsigned> pickQuantity(1, 3);
+    std::vector<Order> orders(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        orders[i].id = i + 1;
+        const unsigned lines = pickLines(random);
+        for (unsigned line = 0; line < lines; ++line) {
+            const auto& [category, dish] = dishes[pickDish(random)];
+            orders[i].lines.push_back({.categoryName = category, .dishName = dish, .quantity = pickQuantity(random)});
+        }
+        if (i % 100 == 99) {
+            orders[i].lines.front().dishName = "Off-menu special";
+        }
+    }
+    return orders;
+}
+
+void cook(KitchenStation, const OrderLine&) {
+    const auto until = std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+void BM_OrderPipeline(BenchmarkState& state) {
+    MenuManager& manager = MenuManager::getInstance();
+    manager.setMenu(std::make_unique<Lunch>(MenuGenerator().nextMenu<Lunch>(2000, 50)));
+    const std::vector<Order> stream = manager.read([](const Menu& menu) { return makeOrderStream(menu, OrdersPerBurst); });
+    ThreadPool pool(static_cast<std::size_t>(state.range()));
+    {
+        OrderPipeline pipeline(manager, pool, {.prepare = cook, .onFinished = {}});
+        for (auto _ : state) {
+            for (const auto& order : stream) {
+                pipeline.submit(order);
+            }
+            pipeline.drain();
+        }
+        const LatencySummary latency = pipeline.latency();
+        state.setItemsProcessed(state.iterations() * static_cast<std::int64_t>(OrdersPerBurst));
+        state.setCounter("p50 us", std::chrono::duration<double, std::micro>(latency.p50).count());
+        state.setCounter("p99 us", std::chrono::duration<double, std::micro>(latency.p99).count());
+        state.setCounter("rejected %", 100.0 * static_cast<double>(pipeline.rejected())
+                                           / static_cast<double>(pipeline.completed() + pipeline.rejected()));
+    }
+    state.setCounter("steals", static_cast<double>(pool.steals()));
+    manager.setMenu(nullptr);
+}
+BENCHMARK(BM_OrderPipeline)->rangeMultiplier(2)->range(1, 8);
+
+} // namespace
@@ -0,0 +1,70 @@
+#include "Benchmark.h"
+#include "../h/PriceTotals.h"
+#include <cstdint>
+#include <vector>
+
+// Throughput of the bulk totaling kernels on batches of order lines (up to 10M)
+
+namespace {
+
+constexpr std::size_t CatalogSize = 4096;
+
+// Deterministic order lines: a dish id per line and the matching price
+struct OrderLines {
+    std::vector<Money> catalogPrices;
+    std::vector<Money> linePrices;
+    std::vector<std::uint32_t> lineDishes;
+
+    explicit OrderLines(std::size_t lines) : catalogPrices(CatalogSize), linePrices(lines), lineDishes(lines) {
+        std::uint64_t state = 42;
+        const auto next = [&state] {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            return state >> 33;
+        };
+        for (auto& price : catalogPrices) {
+            price = Money::fromBani(100 + static_cast<std::int64_t>(next() % 9900));
+        }
+        for (std::size_t i = 0; i < lines; ++i) {
+            lineDishes[i] = static_cast<std::uint32_t>(next() % CatalogSize);
+            linePrices[i] = catalogPrices[lineDishes[i]];
+        }
+    }
+};
+
+void BM_PriceTotalsSumScalar(BenchmarkState& state) {
+    const OrderLines order(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        doNotOptimize(PriceTotals::sumScalar(order.linePrices));
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_PriceTotalsSumScalar)->rangeMultiplier(100)->range(1000, 10'000'000);
+
+void BM_PriceTotalsSum(BenchmarkState& state) {
+    const OrderLines order(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        doNotOptimize(PriceTotals::sum(order.linePrices));
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_PriceTotalsSum)->rangeMultiplier(100)->range(1000, 10'000'000);
+
+void BM_PriceTotalsSumSelectedScalar(BenchmarkState& state) {
+    const OrderLines order(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        doNotOptimize(PriceTotals::sumSelectedScalar(order.catalogPrices, order.lineDishes));
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_PriceTotalsSumSelectedScalar)->rangeMultiplier(100)->range(1000, 10'000'000);
+
+void BM_PriceTotalsSumSelected(BenchmarkState& state) {
+    const OrderLines order(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        doNotOptimize(PriceTotals::sumSelected(order.catalogPrices, order.lineDishes));
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_PriceTotalsSumSelected)->rangeMultiplier(100)->range(1000, 10'000'000);
+
+} // namespace
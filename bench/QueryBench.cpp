@@ -0,0 +1,145 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuQuery.h"
+#include <memory>
+#include <utility>
+#include <vector>
+
+// The same query over a generated menu of range() dishes, three ways: composed with
+// the query templates, written by hand as a loop, and interpreted from a tree of
+// virtual predicate nodes built at runtime. The query keeps the dishes from 15 to
+// 40 RON without meat of the categories open at noon; every other category is
+// open in the evening only.
+
+namespace {
+
+constexpr std::int64_t DishesPerCategory = 100;
+constexpr Money MinPrice = 15.0;
+constexpr Money MaxPrice = 40.0;
+constexpr TimeOfDay Noon(12, 0);
+
+Lunch makeMenu(std::size_t dishes) {
+    MenuGenerator generator;
+    std::pmr::vector<Category> categories;
+    for (std::size_t made = 0; made < dishes; made += DishesPerCategory) {
+        Category category = generator.nextCategory(DishesPerCategory);
+        if (categories.size() % 2 == 1) {
+            category.setAvailability({TimeOfDay(18, 0), TimeOfDay(22, 0)});
+        }
+        categories.push_back(std::move(category));
+    }
+    return Lunch(std::move(categories));
+}
+
+// A predicate tree as a runtime query language would build it from user input
+class Node {
+public:
+    virtual ~Node() = default;
+    [[nodiscard]] virtual bool test(const Category& category, const Dish& dish) const = 0;
+};
+
+class PriceNode : public Node {
+public:
+    PriceNode(Money min, Money max) : min(min), max(max) {}
+    bool test(const Category&, const Dish& dish) const override { return min <= dish.getPrice() && dish.getPrice() <= max; }
+
+private:
+    Money min;
+    Money max;
+};
+
+class DietNode : public Node {
+public:
+    explicit DietNode(DietaryFilter filter) : filter(filter) {}
+    bool test(const Category&, const Dish& dish) const override { return filter.matches(dish.getFoodMask()); }
+
+private:
+    DietaryFilter filter;
+};
+
+class AvailableNode : public Node {
+public:
+    explicit AvailableNode(TimeOfDay time) : time(time) {}
+    bool test(const Category& category, const Dish&) const override { return category.getAvailability().contains(time); }
+
+private:
+    TimeOfDay time;
+};
+
+class AndNode : public Node {
+public:
+    explicit AndNode(std::vector<std::unique_ptr<Node>> children) : children(std::move(children)) {}
+    bool test(const Category& category, const Dish& dish) const override {
+        for (const auto& child : children) {
+            if (!child->test(category, dish)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    std::vector<std::unique_ptr<Node>> children;
+};
+
+template <typename Run>
+void runQuery(BenchmarkState& state, Run run) {
+    const Lunch menu = makeMenu(static_cast<std::size_t>(state.range()));
+    std::vector<const Dish*> results(static_cast<std::size_t>(state.range()));
+    std::size_t found = 0;
+    for (auto _ : state) {
+        found = run(menu, std::span<const Dish*>(results));
+        doNotOptimize(results.data());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("found", static_cast<double>(found));
+}
+
+void BM_QueryComposed(BenchmarkState& state) {
+    const auto noonVegetarian = query::availableAt(Noon) && query::price(MinPrice, MaxPrice)
+                                && query::excludes(FoodType::MEAT);
+    runQuery(state, [&](const Menu& menu, std::span<const Dish*> out) { return query::select(menu, noonVegetarian, out); });
+}
+BENCHMARK(BM_QueryComposed)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_QueryHandWritten(BenchmarkState& state) {
+    runQuery(state, [](const Menu& menu, std::span<const Dish*> out) {
+        std::size_t found = 0;
+        for (const auto& category : menu.getCategory()) {
+            if (!category.getAvailability().contains(Noon)) {
+                continue;
+            }
+            for (const Dish& dish : category.getDishes()) {
+                if (MinPrice <= dish.getPrice() && dish.getPrice() <= MaxPrice
+                    && (dish.getFoodMask() & toFoodMask(FoodType::MEAT)) == 0) {
+                    out[found++] = &dish;
+                }
+            }
+        }
+        return found;
+    });
+}
+BENCHMARK(BM_QueryHandWritten)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_QueryRuntimeTree(BenchmarkState& state) {
+    std::vector<std::unique_ptr<Node>> children;
+    children.push_back(std::make_unique<AvailableNode>(Noon));
+    children.push_back(std::make_unique<PriceNode>(MinPrice, MaxPrice));
+    children.push_back(std::make_unique<DietNode>(DietaryFilter::vegetarian()));
+    const AndNode tree(std::move(children));
+    runQuery(state, [&tree](const Menu& menu, std::span<const Dish*> out) {
+        std::size_t found = 0;
+        for (const auto& category : menu.getCategory()) {
+            for (const Dish& dish : category.getDishes()) {
+                if (tree.test(category, dish)) {
+                    out[found++] = &dish;
+                }
+            }
+        }
+        return found;
+    });
+}
+BENCHMARK(BM_QueryRuntimeTree)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+} // namespace
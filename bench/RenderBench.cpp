@@ -0,0 +1,164 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuRenderCache.h"
+#include "../h/MenuRenderer.h"
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Rendering a generated menu of range() dishes in the operator<< layout: the iostream
+// path the model used before MenuRenderer (one insertion per field, Money::toString
+// temporaries) against the renderer. Both write to a string, then to the null device.
+// Last, redisplaying the menu in the print() layout after one price change, rendered
+// in full against MenuRenderCache, which renders only the changed category again.
+
+namespace {
+
+constexpr std::int64_t DishesPerCategory = 100;
+
+#ifdef _WIN32
+constexpr const char* NullDevice = "NUL";
+#else
+constexpr const char* NullDevice = "/dev/null";
+#endif
+
+// The former operator<< of Menu, Category and Dish
+void streamMenu(std::ostream& os, const Menu& menu) {
+    os << "Menu:\n";
+    for (const auto& category : menu.getCategory()) {
+        os << "Category: " << category.getName() << "\n";
+        for (const auto& dish : category.getDishes()) {
+            os << "Dish: " << dish.getName() << " - Price: " << dish.getPrice() << " RON\n";
+            os << "Ingredients: \n";
+            for (const auto& ingredient : dish.getIngredients()) {
+                os << "  - " << ingredient << "\n";
+            }
+            os << "\n";
+        }
+        os << "\n";
+    }
+}
+
+void setRenderCounters(BenchmarkState& state, std::uint64_t allocationsBefore, std::size_t bytes = 0) {
+    state.setItemsProcessed(state.iterations() * state.range());
+    state.setCounter("allocs/render", static_cast<double>(AllocationCounter::count() - allocationsBefore)
+                                          / static_cast<double>(state.iterations()));
+    if (bytes != 0) {
+        state.setCounter("bytes", static_cast<double>(bytes));
+    }
+}
+
+void BM_RenderIostreamToString(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    std::ostringstream out;
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        out.str({});
+        streamMenu(out, menu);
+        doNotOptimize(out);
+    }
+    setRenderCounters(state, before, out.str().size());
+}
+BENCHMARK(BM_RenderIostreamToString)->rangeMultiplier(10)->range(100, 1'000'000);
+
+void BM_RenderRendererToString(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    MenuRenderer renderer;
+    std::string out;
+    StringSink sink(out);
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        out.clear();
+        renderer.menu(menu);
+        renderer.flushTo(sink);
+        doNotOptimize(out);
+    }
+    setRenderCounters(state, before, out.size());
+}
+BENCHMARK(BM_RenderRendererToString)->rangeMultiplier(10)->range(100, 1'000'000);
+
+void BM_RenderIostreamToDevice(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    std::ofstream out(NullDevice);
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        streamMenu(out, menu);
+        out.flush();
+    }
+    setRenderCounters(state, before);
+}
+BENCHMARK(BM_RenderIostreamToDevice)->rangeMultiplier(10)->range(100, 1'000'000);
+
+void BM_RenderRendererToDevice(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+#ifdef _WIN32
+    const int descriptor = _open(NullDevice, _O_WRONLY);
+#else
+    const int descriptor = open(NullDevice, O_WRONLY);
+#endif
+    MenuRenderer renderer;
+    FdSink sink(descriptor);
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        renderer.menu(menu);
+        renderer.flushTo(sink);
+    }
+    setRenderCounters(state, before);
+#ifdef _WIN32
+    _close(descriptor);
+#else
+    close(descriptor);
+#endif
+}
+BENCHMARK(BM_RenderRendererToDevice)->rangeMultiplier(10)->range(100, 1'000'000);
+
+// Changes the price of a dish of the next category, then renders the whole menu again
+template <typename Render>
+void runRedisplay(BenchmarkState& state, Menu& menu, Render render) {
+    const auto& categories = menu.getCategory();
+    MenuRenderer renderer;
+    render(renderer);  // Warms the cache up
+    renderer.clear();
+    std::size_t next = 0;
+    for (auto _ : state) {
+        const Category& category = categories[next++ % categories.size()];
+        const Dish& dish = category.getDishes().front();
+        menu.updateDishPrice(category.getName(), dish.getName(), dish.getPrice() + Money(0.5));
+        render(renderer);
+        doNotOptimize(renderer.view());
+        renderer.clear();
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+void BM_RenderRedisplayFull(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    runRedisplay(state, menu, [&menu](MenuRenderer& renderer) { renderer.menuListing(menu); });
+}
+BENCHMARK(BM_RenderRedisplayFull)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_RenderRedisplayCached(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    MenuRenderCache cache(menu);
+    std::uint64_t warmUpMisses = 0;
+    runRedisplay(state, menu, [&](MenuRenderer& renderer) {
+        cache.render(RenderFormat::Listing, renderer);
+        warmUpMisses = warmUpMisses == 0 ? cache.misses() : warmUpMisses;
+    });
+    state.setCounter("misses/redisplay", static_cast<double>(cache.misses() - warmUpMisses)
+                                             / static_cast<double>(state.iterations()));
+    state.setCounter("hits/redisplay", static_cast<double>(cache.hits()) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_RenderRedisplayCached)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+} // namespace
@@ -0,0 +1,87 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuSearchIndex.h"
+#include <string>
+#include <vector>
+
+// Query latency of the search index over a generated catalog of range() dishes (up to
+// one million). The queries are taken from real dish names of the catalog: the first
+// letters of a name (prefix), a name with one letter changed (typo, fuzzy), and the
+// first letters of a second word. Building the index is measured separately.
+
+namespace {
+
+constexpr std::int64_t DishesPerCategory = 100;
+constexpr std::size_t QueryCount = 64;
+constexpr std::size_t HitLimit = 10;
+
+enum class QueryKind { Prefix, Typo, SecondWord };
+
+std::vector<std::string> makeQueries(const Menu& menu, QueryKind kind) {
+    std::vector<std::string> queries;
+    const auto& categories = menu.getCategory();
+    for (std::size_t i = 0; queries.size() < QueryCount; ++i) {
+        const Category& category = categories[(i * 7919) % categories.size()];
+        const std::string name(category.getDishes()[i % category.getDishes().size()].getName());
+        switch (kind) {
+            case QueryKind::Prefix:
+                queries.push_back(name.substr(0, 4));
+                break;
+            case QueryKind::Typo: {
+                std::string typo = name;
+                typo[typo.size() / 2] = typo[typo.size() / 2] == 'x' ? 'y' : 'x';
+                queries.push_back(std::move(typo));
+                break;
+            }
+            case QueryKind::SecondWord:
+                if (const auto space = name.find(' '); space != std::string::npos) {
+                    queries.push_back(name.substr(space + 1, 3));
+                }
+                break;
+        }
+    }
+    return queries;
+}
+
+void runQueries(BenchmarkState& state, QueryKind kind) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    const MenuSearchIndex index(menu);
+    const std::vector<std::string> queries = makeQueries(menu, kind);
+    std::size_t next = 0;
+    std::size_t hits = 0;
+    for (auto _ : state) {
+        const auto results = index.search(queries[next++ % queries.size()], HitLimit);
+        hits += results.size();
+        doNotOptimize(results);
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("hits/query", static_cast<double>(hits) / static_cast<double>(state.iterations()));
+}
+
+void BM_SearchPrefix(BenchmarkState& state) {
+    runQueries(state, QueryKind::Prefix);
+}
+BENCHMARK(BM_SearchPrefix)->rangeMultiplier(10)->range(10'000, 1'000'000);
+
+void BM_SearchTypo(BenchmarkState& state) {
+    runQueries(state, QueryKind::Typo);
+}
+BENCHMARK(BM_SearchTypo)->rangeMultiplier(10)->range(10'000, 1'000'000);
+
+void BM_SearchSecondWord(BenchmarkState& state) {
+    runQueries(state, QueryKind::SecondWord);
+}
+BENCHMARK(BM_SearchSecondWord)->rangeMultiplier(10)->range(10'000, 1'000'000);
+
+void BM_SearchIndexBuild(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    for (auto _ : state) {
+        const MenuSearchIndex index(menu);
+        doNotOptimize(index.termCount());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_SearchIndexBuild)->rangeMultiplier(10)->range(10'000, 1'000'000);
+
+} // namespace
@@ -0,0 +1,81 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuSnapshot.h"
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+// Cold start from a binary snapshot versus rebuilding the Menu object graph (up to 1M dishes)
+
+namespace {
+
+constexpr std::int64_t MinDishes = 1000;
+constexpr std::int64_t MaxDishes = 1'000'000;
+
+// Writes a generated lunch menu to a temporary snapshot file, removed when the benchmark ends
+class SnapshotFile {
+public:
+    explicit SnapshotFile(std::size_t dishes)
+        : path((std::filesystem::temp_directory_path() / ("oop_bench_" + std::to_string(dishes) + ".menusnap")).string()) {
+        MenuSnapshot::write(MenuGenerator().nextMenu<Lunch>(dishes, 100), path);
+    }
+    ~SnapshotFile() {
+        std::remove(path.c_str());
+    }
+    SnapshotFile(const SnapshotFile&) = delete;
+    SnapshotFile& operator=(const SnapshotFile&) = delete;
+
+    const std::string path;
+};
+
+void BM_MenuSnapshotOpen(BenchmarkState& state) {
+    const SnapshotFile file(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        const MenuSnapshot snapshot = MenuSnapshot::open(file.path);
+        doNotOptimize(snapshot.dishCount());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuSnapshotOpen)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuSnapshotOpenAndScan(BenchmarkState& state) {
+    const SnapshotFile file(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        const MenuSnapshot snapshot = MenuSnapshot::open(file.path);
+        std::uint32_t vegetarian = 0;
+        for (std::uint32_t i = 0; i < snapshot.categoryCount(); ++i) {
+            const SnapshotCategoryView category = snapshot.category(i);
+            for (std::uint32_t j = 0; j < category.size(); ++j) {
+                vegetarian += category.dish(j).isVegetarian();
+            }
+        }
+        doNotOptimize(vegetarian);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuSnapshotOpenAndScan)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+// Baseline: what startup costs when every Category and Dish is rebuilt as objects
+void BM_MenuSnapshotToMenu(BenchmarkState& state) {
+    const SnapshotFile file(static_cast<std::size_t>(state.range()));
+    for (auto _ : state) {
+        const MenuSnapshot snapshot = MenuSnapshot::open(file.path);
+        doNotOptimize(snapshot.toMenu());
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuSnapshotToMenu)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+void BM_MenuSnapshotWrite(BenchmarkState& state) {
+    const Lunch menu = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), 100);
+    const std::string path = (std::filesystem::temp_directory_path() / "oop_bench_write.menusnap").string();
+    for (auto _ : state) {
+        MenuSnapshot::write(menu, path);
+    }
+    std::remove(path.c_str());
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_MenuSnapshotWrite)->rangeMultiplier(10)->range(MinDishes, MaxDishes);
+
+} // namespace
@@ -0,0 +1,81 @@
+#include "Benchmark.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/ThreadPool.h"
+#include <algorithm>
+#include <optional>
+#include <vector>
+
+// Sorting a generated menu of range() dishes by name, then price: the former way (a
+// comparator reading both dishes' names through the symbol table, one category after
+// the other) against precomputed keys, sequential and on a pool. Last, a single
+// category of range() dishes, which the pool cuts into runs once it is large enough.
+// The copies of the unsorted menu are made and destroyed with the timer paused.
+
+namespace {
+
+constexpr std::int64_t DishesPerCategory = 1'000;
+
+const DishOrdering& byNameThenPrice() {
+    static const DishOrdering ordering({{DishSortField::Name}, {DishSortField::Price}});
+    return ordering;
+}
+
+template <typename Sort>
+void runSort(BenchmarkState& state, const Lunch& unsorted, Sort sort) {
+    std::optional<Lunch> menu;
+    for (auto _ : state) {
+        state.pauseTiming();
+        menu.emplace(unsorted);
+        state.resumeTiming();
+        sort(*menu);
+        doNotOptimize(*menu);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+void BM_SortComparator(BenchmarkState& state) {
+    const Lunch unsorted = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    std::vector<std::pmr::vector<Dish>> categories;
+    for (auto _ : state) {
+        state.pauseTiming();
+        categories.clear();
+        for (const auto& category : unsorted.getCategory()) {
+            categories.emplace_back(category.getDishes().begin(), category.getDishes().end());
+        }
+        state.resumeTiming();
+        for (auto& dishes : categories) {
+            // The former Category::sortDishesAlphabetically, with a second key and stable
+            std::ranges::stable_sort(dishes, [](const Dish& a, const Dish& b) {
+                return a.getName() != b.getName() ? a.getName() < b.getName() : a.getPrice() < b.getPrice();
+            });
+        }
+        doNotOptimize(categories);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+BENCHMARK(BM_SortComparator)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_SortKeys(BenchmarkState& state) {
+    const Lunch unsorted = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    runSort(state, unsorted, [](Lunch& menu) { menu.sortCategories(byNameThenPrice()); });
+}
+BENCHMARK(BM_SortKeys)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_SortKeysParallel(BenchmarkState& state) {
+    const Lunch unsorted = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), DishesPerCategory);
+    ThreadPool pool;
+    runSort(state, unsorted, [&pool](Lunch& menu) { menu.sortCategories(pool, byNameThenPrice()); });
+    state.setCounter("threads", static_cast<double>(pool.size()));
+}
+BENCHMARK(BM_SortKeysParallel)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_SortLargeCategoryParallel(BenchmarkState& state) {
+    const Lunch unsorted = MenuGenerator().nextMenu<Lunch>(static_cast<std::size_t>(state.range()), state.range());
+    ThreadPool pool;
+    runSort(state, unsorted, [&pool](Lunch& menu) { menu.sortCategories(pool, byNameThenPrice()); });
+    state.setCounter("threads", static_cast<double>(pool.size()));
+}
+BENCHMARK(BM_SortLargeCategoryParallel)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+} // namespace
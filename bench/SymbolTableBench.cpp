@@ -0,0 +1,158 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Category.h"
+#include "../h/MenuGenerator.h"
+#include "../h/SymbolTable.h"
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Footprint of the same generated catalog of range() dishes with interned names (the
+// model: a 4-byte Symbol per dish and ingredient) and with owned names (the model
+// before the SymbolTable: a std::string per dish and ingredient). The counters are
+// measured on one copy, outside the timed loop: "allocs/dish" counts the calls to
+// operator new, "bytes/dish" the heap the copy holds. "table MB" is the whole symbol
+// table, which every catalog of the process shares.
+// Last, interning names already in the table while range() other threads intern too,
+// against a table guarded by one mutex like the former SymbolTable.
+
+namespace {
+
+constexpr std::size_t DishesPerCategory = 100;
+
+// The dish model before the SymbolTable
+struct OwnedIngredient {
+    std::string name;
+    FoodType type;
+};
+
+struct OwnedDish {
+    std::string name;
+    Money price;
+    float weight;
+    std::vector<OwnedIngredient> ingredients;
+};
+
+struct OwnedCategory {
+    std::string name;
+    std::vector<OwnedDish> dishes;
+};
+
+std::vector<Category> generateCatalog(std::size_t dishes) {
+    std::vector<Category> catalog;
+    MenuGenerator().streamCategories(dishes, DishesPerCategory, [&](Category&& category) {
+        catalog.push_back(std::move(category));
+    });
+    return catalog;
+}
+
+std::vector<Category> internedCopy(const std::vector<Category>& source) {
+    return source;
+}
+
+std::vector<OwnedCategory> ownedCopy(const std::vector<Category>& source) {
+    std::vector<OwnedCategory> catalog;
+    catalog.reserve(source.size());
+    for (const auto& category : source) {
+        OwnedCategory& owned = catalog.emplace_back(OwnedCategory{std::string(category.getName()), {}});
+        owned.dishes.reserve(category.getDishes().size());
+        for (const auto& dish : category.getDishes()) {
+            OwnedDish& ownedDish = owned.dishes.emplace_back(OwnedDish{std::string(dish.getName()), dish.getPrice(), dish.getWeight(), {}});
+            ownedDish.ingredients.reserve(dish.getIngredients().size());
+            for (const auto& ingredient : dish.getIngredients()) {
+                ownedDish.ingredients.push_back({std::string(ingredient.getName()), ingredient.getType()});
+            }
+        }
+    }
+    return catalog;
+}
+
+template <typename Copy>
+void runCatalog(BenchmarkState& state, Copy copy) {
+    const std::vector<Category> source = generateCatalog(static_cast<std::size_t>(state.range()));
+    {
+        const std::uint64_t allocationsBefore = AllocationCounter::count();
+        const std::uint64_t bytesBefore = AllocationCounter::liveBytes();
+        const auto catalog = copy(source);
+        const auto dishes = static_cast<double>(state.range());
+        state.setCounter("allocs/dish", static_cast<double>(AllocationCounter::count() - allocationsBefore) / dishes);
+        state.setCounter("bytes/dish", static_cast<double>(AllocationCounter::liveBytes() - bytesBefore) / dishes);
+        state.setCounter("table MB", static_cast<double>(SymbolTable::memoryUsage()) / 1e6);
+        doNotOptimize(catalog);
+    }
+    std::optional<decltype(copy(source))> catalog;
+    for (auto _ : state) {
+        state.pauseTiming();
+        catalog.reset();
+        state.resumeTiming();
+        catalog.emplace(copy(source));
+        doNotOptimize(*catalog);
+    }
+    state.setItemsProcessed(state.iterations() * state.range());
+}
+
+void BM_CatalogInternedNames(BenchmarkState& state) {
+    runCatalog(state, internedCopy);
+}
+BENCHMARK(BM_CatalogInternedNames)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+void BM_CatalogOwnedNames(BenchmarkState& state) {
+    runCatalog(state, ownedCopy);
+}
+BENCHMARK(BM_CatalogOwnedNames)->rangeMultiplier(10)->range(1'000, 1'000'000);
+
+// Baseline: one mutex around every lookup, like the SymbolTable before its shards
+class LockedTable {
+public:
+    Symbol intern(std::string_view text) {
+        const std::scoped_lock lock(mutex);
+        return index.try_emplace(std::string(text), static_cast<Symbol>(index.size())).first->second;
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, Symbol> index;
+};
+
+std::vector<std::string> dishNames() {
+    std::vector<std::string> names;
+    MenuGenerator().streamDishes(4096, [&](Dish&& dish) { names.emplace_back(dish.getName()); });
+    return names;
+}
+
+template <typename Intern>
+void runIntern(BenchmarkState& state, Intern intern) {
+    const std::vector<std::string> names = dishNames();
+    for (const auto& name : names) {
+        intern(name);
+    }
+    std::vector<std::jthread> others;
+    for (std::int64_t i = 0; i < state.range(); ++i) {
+        others.emplace_back([&names, intern, i](std::stop_token stop) mutable {
+            for (std::size_t next = static_cast<std::size_t>(i); !stop.stop_requested(); ++next) {
+                doNotOptimize(intern(names[next % names.size()]));
+            }
+        });
+    }
+    std::size_t next = 0;
+    for (auto _ : state) {
+        doNotOptimize(intern(names[next++ % names.size()]));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+
+void BM_InternExistingName(BenchmarkState& state) {
+    runIntern(state, [](std::string_view name) { return SymbolTable::intern(name); });
+}
+BENCHMARK(BM_InternExistingName)->rangeMultiplier(2)->range(1, 8);
+
+void BM_InternExistingNameLocked(BenchmarkState& state) {
+    LockedTable table;
+    runIntern(state, [&table](std::string_view name) { return table.intern(name); });
+}
+BENCHMARK(BM_InternExistingNameLocked)->rangeMultiplier(2)->range(1, 8);
+
+} // namespace
@@ -0,0 +1,90 @@
+#include "Benchmark.h"
+#include "AllocationCounter.h"
+#include "../h/Lunch.h"
+#include "../h/MenuGenerator.h"
+#include "../h/MenuVersionStore.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Cost of keeping every version of a menu of range() dishes while prices change.
+// The store copies only the changed dish, so "allocs/change" stays flat as the
+// catalog grows; the baseline keeps a full copy of the menu per version. The
+// point-in-time query looks a dish up at a random past time among 1000 versions.
+
+namespace {
+
+constexpr std::int64_t DishesPerCategory = 100;
+
+struct PriceChange {
+    std::string category;
+    std::string dish;
+};
+
+std::vector<PriceChange> pickDishes(const Menu& menu) {
+    std::vector<PriceChange> changes;
+    for (const auto& category : menu.getCategory()) {
+        for (const auto& dish : category.getDishes()) {
+            changes.push_back({std::string(category.getName()), std::string(dish.getName())});
+        }
+    }
+    return changes;
+}
+
+void BM_VersionStorePriceChange(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(state.range(), DishesPerCategory);
+    const std::vector<PriceChange> dishes = pickDishes(menu);
+    MenuVersionStore versions(menu);
+    std::size_t next = 0;
+    std::int64_t bani = 1000;
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        const PriceChange& change = dishes[next++ % dishes.size()];
+        menu.updateDishPrice(change.category, change.dish, Money::fromBani(++bani));
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("allocs/change", static_cast<double>(AllocationCounter::count() - before) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_VersionStorePriceChange)->rangeMultiplier(10)->range(1000, 100'000);
+
+void BM_FullCopyPriceChange(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(state.range(), DishesPerCategory);
+    const std::vector<PriceChange> dishes = pickDishes(menu);
+    std::vector<std::unique_ptr<Menu>> versions;
+    std::size_t next = 0;
+    std::int64_t bani = 1000;
+    const std::uint64_t before = AllocationCounter::count();
+    for (auto _ : state) {
+        const PriceChange& change = dishes[next++ % dishes.size()];
+        menu.updateDishPrice(change.category, change.dish, Money::fromBani(++bani));
+        versions.push_back(menu.clone());
+        if (versions.size() == 100) {
+            state.pauseTiming();
+            versions.clear();  // Bounds the memory of the baseline; its per-change cost is what is measured
+            state.resumeTiming();
+        }
+    }
+    state.setItemsProcessed(state.iterations());
+    state.setCounter("allocs/change", static_cast<double>(AllocationCounter::count() - before) / static_cast<double>(state.iterations()));
+}
+BENCHMARK(BM_FullCopyPriceChange)->rangeMultiplier(10)->range(1000, 100'000);
+
+void BM_VersionStoreDishAsOf(BenchmarkState& state) {
+    Lunch menu = MenuGenerator().nextMenu<Lunch>(state.range(), DishesPerCategory);
+    const PriceChange dish = pickDishes(menu).front();
+    MenuVersionStore versions(menu);
+    std::vector<MenuVersionStore::Timestamp> times;
+    for (std::int64_t bani = 1000; bani < 2000; ++bani) {
+        menu.updateDishPrice(dish.category, dish.dish, Money::fromBani(bani));
+        times.push_back(MenuVersionStore::Clock::now());
+    }
+    std::size_t next = 0;
+    for (auto _ : state) {
+        next = (next * 7 + 13) % times.size();
+        doNotOptimize(versions.dishAsOf(dish.category, dish.dish, times[next]));
+    }
+    state.setItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VersionStoreDishAsOf)->rangeMultiplier(10)->range(1000, 100'000);
+
+} // namespace
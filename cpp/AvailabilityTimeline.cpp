@@ -0,0 +1,29 @@
+#include "../h/AvailabilityTimeline.h"
+
+// Registers a menu; its isAvailableAt is evaluated once per minute of the day
+// @param menu: The menu to register
+// @return: The id of the menu inside the timeline
+AvailabilityTimeline::EntryId AvailabilityTimeline::addMenu(const Menu& menu) {
+    return sample(menu);
+}
+
+// Registers a category; its availability window is expanded into the bitmap
+// @param category: The category to register
+// @return: The id of the category inside the timeline
+AvailabilityTimeline::EntryId AvailabilityTimeline::addCategory(const Category& category) {
+    return sample(category);
+}
+
+// Lists the entries whose bit is set for the given minute
+// @param time: The time of day to check
+// @return: The ids of all entries available at that time
+std::vector<AvailabilityTimeline::EntryId> AvailabilityTimeline::availableAt(TimeOfDay time) const {
+    std::vector<EntryId> available;
+    const std::size_t minute = time.minutesSinceMidnight();
+    for (EntryId id = 0; id < slots.size(); ++id) {
+        if (slots[id].test(minute)) {
+            available.push_back(id);
+        }
+    }
+    return available;
+}
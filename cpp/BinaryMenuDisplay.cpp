@@ -0,0 +1,55 @@
+#include "../h/BinaryMenuDisplay.h"
+#include <array>
+#include <bit>
+
+namespace {
+
+void appendVarint(MenuRenderer& out, std::uint64_t value) {
+    std::array<char, 10> bytes{};
+    std::size_t size = 0;
+    while (value >= 0x80) {
+        bytes[size++] = static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes[size++] = static_cast<char>(value);
+    out.text({bytes.data(), size});
+}
+
+void appendString(MenuRenderer& out, std::string_view text) {
+    appendVarint(out, text.size());
+    out.text(text);
+}
+
+void appendFloat(MenuRenderer& out, float value) {
+    const auto bits = std::bit_cast<std::uint32_t>(value);
+    const std::array<char, 4> bytes{static_cast<char>(bits), static_cast<char>(bits >> 8),
+                                    static_cast<char>(bits >> 16), static_cast<char>(bits >> 24)};
+    out.text({bytes.data(), bytes.size()});
+}
+
+// Maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ... so amounts of either sign stay short
+std::uint64_t zigzag(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+} // namespace
+
+void BinaryMenuDisplay::encode(const Menu& menu, MenuRenderer& out) const {
+    out.text("MB").character(static_cast<char>(Version));
+    appendVarint(out, menu.getCategory().size());
+    for (const auto& category : menu.getCategory()) {
+        appendString(out, category.getName());
+        appendVarint(out, category.getDishes().size());
+        for (const auto& dish : category.getDishes()) {
+            appendString(out, dish.getName());
+            appendVarint(out, zigzag(dish.getPrice().toBani()));
+            appendFloat(out, dish.getWeight());
+            out.character(static_cast<char>(dish.getFoodMask()));
+            appendVarint(out, dish.getIngredients().size());
+            for (const auto& ingredient : dish.getIngredients()) {
+                appendString(out, ingredient.getName());
+                out.character(static_cast<char>(ingredient.getType()));
+            }
+        }
+    }
+}
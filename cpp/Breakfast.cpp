@@ -1,5 +1,6 @@
 
 #include"../h/Breakfast.h"
+#include "../h/MenuRenderer.h"
 
 /**
  * @brief Constructor for the Breakfast menu.
@@ -7,21 +8,24 @@
  * This constructor initializes the Breakfast menu with the given categories.
  * It calls the base class Menu constructor to set the categories.
  *
- * @param categories The list of categories for the breakfast menu.
+ * @param categories The list of categories for the breakfast menu (moved into the menu).
+ * @param allocator The memory resource of the menu's categories.
  */
-Breakfast::Breakfast(const std::vector<Category>& categories) : Menu(categories) {}
+Breakfast::Breakfast(std::pmr::vector<Category> categories, const allocator_type& allocator)
+    : Menu(std::move(categories), allocator) {}
 
 /**
  * @brief Checks if the breakfast menu is available at the given time.
  *
  * This function checks if the current time is within the valid range for breakfast (08:00 - 10:00).
  *
- * @param time The time to check in "HH:MM" format.
+ * @param time The time of day to check.
  * @return True if the menu is available, false otherwise.
  */
-bool Breakfast::isAvailableAt(const std::string& time) const {
+bool Breakfast::isAvailableAt(TimeOfDay time) const {
     // Implementation for the breakfast menu time range
-    return time >= "08:00" && time <= "10:00";
+    constexpr TimeWindow breakfastHours{TimeOfDay(8, 0), TimeOfDay(10, 0)};
+    return breakfastHours.contains(time);
 }
 
 /**
@@ -37,13 +41,26 @@ bool Breakfast::isAvailableAt(const std::string& time) const {
  * @brief Prints the categories of the breakfast menu.
  *
  * This function prints the "Breakfast Menu" title followed by the details of each category
- * in the breakfast menu by calling the print function from the Category class.
+ * in the breakfast menu, laid out like Category::print and written with a single insertion.
  */
 void Breakfast::print() const {
-    std::cout << "Breakfast Menu:\n";
-    std::cout << getDescription() << ":\n";
-    for (const auto& category : categories) {
-        category.print();  // Calling the print method from the `Category` class
-    }
+    Menu::print();  // The title from renderTitle(), then each category as printed by `Category::print`
+}
 
+/**
+ * @brief Renders the title of the breakfast menu, followed by its description.
+ *
+ * @param renderer The renderer to append the title to.
+ */
+void Breakfast::renderTitle(MenuRenderer& renderer) const {
+    renderer.text("Breakfast Menu:\n").text(getDescription()).text(":\n");
+}
+
+/**
+ * @brief Copies the breakfast menu on the heap.
+ *
+ * The copy allocates from the default heap, whatever the memory resource of this menu.
+ */
+std::unique_ptr<Menu> Breakfast::clone() const {
+    return std::make_unique<Breakfast>(*this);
 }
@@ -1,55 +1,185 @@
 #include "../h/Category.h"
+#include "../h/MenuRenderer.h"
+#include <stdexcept>
 
 // Constructor that initializes the category with a name and a list of dishes
 // @param name The name of the category (e.g., "Breakfast", "Lunch")
 // @param dishes A vector of Dish objects that belong to this category
-Category::Category(const std::string& name, const std::vector<Dish>& dishes)
-    : name(name), dishes(dishes) {}
+// @param allocator The memory resource of the name and the dishes
+Category::Category(std::string_view name, std::pmr::vector<Dish> dishes, const allocator_type& allocator)
+    : name(name, allocator), dishes(std::move(dishes), allocator) {
+    for (const auto& dish : this->dishes) {
+        foodMask |= dish.getFoodMask();
+    }
+}
+
+// Copies a category, with all its dishes, into the memory resource of the given allocator
+Category::Category(const Category& other, const allocator_type& allocator)
+    : name(other.name, allocator), dishes(other.dishes, allocator), availability(other.availability),
+      foodMask(other.foodMask) {}
+
+// Moves a category; the name and dishes are copied if the allocator uses another memory resource
+Category::Category(Category&& other, const allocator_type& allocator)
+    : name(std::move(other.name), allocator), dishes(std::move(other.dishes), allocator),
+      availability(other.availability), foodMask(other.foodMask) {}
 
 // Sorts the dishes in the category alphabetically by their name
 void Category::sortDishesAlphabetically() {
-    std::ranges::sort(dishes, [](const Dish& a, const Dish& b) {
-        // Comparison of dish names (alphabetical order)
-        return a.getName() < b.getName();
-    });
+    sortDishes(DishOrdering());  // Names compared through their 8-byte prefixes first
+}
+
+// Sorts the dishes by the keys of an ordering
+// @param ordering The keys to sort by
+void Category::sortDishes(const DishOrdering& ordering) {
+    std::vector<DishOrdering::Key> keys(dishes.size());
+    ordering.computeKeys(dishes, 0, keys);
+    ordering.sort(keys, dishes);
+    permuteDishes(keys);
+}
+
+// Applies the permutation cycle by cycle, so each dish is moved once and no dish is copied
+// Moves between slots of the same vector keep the allocator, so nothing is allocated from it;
+// a parallel sort may thus permute several categories of one arena at once
+// @param sorted The sorted keys; sorted[i].position is the current slot of the dish that goes to slot i
+void Category::permuteDishes(std::span<const DishOrdering::Key> sorted) {
+    if (sorted.size() != dishes.size()) {
+        throw std::invalid_argument("The sorted keys do not match the dishes of the category");
+    }
+    std::vector<bool> placed(dishes.size());
+    for (std::size_t start = 0; start < dishes.size(); ++start) {
+        if (placed[start] || sorted[start].position == start) {
+            continue;
+        }
+        Dish moving = std::move(dishes[start]);
+        std::size_t slot = start;
+        for (std::size_t from = sorted[slot].position; from != start; from = sorted[slot].position) {
+            dishes[slot] = std::move(dishes[from]);
+            placed[slot] = true;
+            slot = from;
+        }
+        dishes[slot] = std::move(moving);
+        placed[slot] = true;
+    }
 }
 
 // Checks if the category is available at a given time of the day
-// This could be overridden by derived classes to provide more specific logic
+// @param timeOfDay The time to check for availability
+// @return True if the time is inside the availability window (the whole day by default)
+bool Category::isAvailableAt(TimeOfDay timeOfDay) const {
+    return availability.contains(timeOfDay);
+}
+
+// Parses a time in "HH:MM" format and checks the availability window
 // @param timeOfDay The time in "HH:MM" format to check for availability
-// @return Always returns true in the current implementation
-bool Category::isAvailableAt([[maybe_unused]]const std::string& timeOfDay) const {
-    // Currently, it is a placeholder that always returns true.
-    // In a more complex system, this function would check if the category is available at the given time.
-    return true;
+// @return True if the category is available, false otherwise
+bool Category::isAvailableAt(const std::string& timeOfDay) const {
+    return isAvailableAt(TimeOfDay::parse(timeOfDay));
+}
+
+// Sets the window of the day during which the category is available
+// @param window The availability window
+void Category::setAvailability(TimeWindow window) {
+    availability = window;
+}
+
+// Returns the window of the day during which the category is available
+TimeWindow Category::getAvailability() const {
+    return availability;
 }
 
 // Prints the name of the category and details of each dish (name and price)
 void Category::print() const {
-    std::cout << "Category: " << name << "\n";  // Print category name
-    for (const auto& dish : dishes) {
-        // Print each dish's name and price
-        std::cout << dish.getName() << ": " << dish.getPrice() << " RON\n";
-    }
+    MenuRenderer& renderer = MenuRenderer::local();
+    renderer.categoryListing(*this);  // Category name, then one "name: price RON" line per dish
+    renderer.flushTo(std::cout);
 }
 
 
 // Returns the list of dishes in the category
-// @return A vector containing all the dishes in the category
-const std::vector<Dish>& Category::getDishes() const {
+// @return A view of all the dishes in the category
+std::span<const Dish> Category::getDishes() const {
     return dishes;  // Return the list of dishes
 }
 
+// Adds a dish and merges its food types into the category's mask
+// @param dish The dish to add
+void Category::addDish(Dish dish) {
+    foodMask |= dish.getFoodMask();
+    dishes.push_back(std::move(dish));
+}
+
+// Removes a dish; the food mask is rebuilt because other dishes may share its food types
+// @param dish The interned name of the dish
+// @return true if a dish was removed
+bool Category::removeDish(Symbol dish) {
+    const auto it = std::ranges::find(dishes, dish, &Dish::getSymbol);
+    if (it == dishes.end()) {
+        return false;
+    }
+    dishes.erase(it);
+    foodMask = 0;
+    for (const auto& remaining : dishes) {
+        foodMask |= remaining.getFoodMask();
+    }
+    return true;
+}
+
+// Looks up a dish by its interned name
+// @param dish The interned name of the dish
+// @return The dish, or nullptr if the category has none with that name
+const Dish* Category::findDish(Symbol dish) const {
+    const auto it = std::ranges::find(dishes, dish, &Dish::getSymbol);
+    return it == dishes.end() ? nullptr : &*it;
+}
+
+Dish* Category::findDish(Symbol dish) {
+    const auto it = std::ranges::find(dishes, dish, &Dish::getSymbol);
+    return it == dishes.end() ? nullptr : &*it;
+}
+
+// Reserves room for a number of dishes
+// @param count The expected number of dishes
+void Category::reserve(std::size_t count) {
+    dishes.reserve(count);
+}
+
+// Returns the union of the food masks of all dishes
+FoodMask Category::getFoodMask() const {
+    return foodMask;
+}
+
+// A category is vegetarian when no dish contributed the MEAT bit
+bool Category::isVegetarian() const {
+    return DietaryFilter::vegetarian().matches(foodMask);
+}
+
+// Collects the dishes matching a dietary constraint
+// The aggregated mask answers the "none" and "all" cases without scanning the dishes
+// @param filter The dietary constraint
+// @return Pointers to the matching dishes
+std::vector<const Dish*> Category::filter(DietaryFilter filter) const {
+    std::vector<const Dish*> matching;
+    if ((foodMask & filter.required) != filter.required) {
+        return matching;  // No dish contains every required food type
+    }
+    matching.reserve(dishes.size());
+    const bool allMatch = filter.required == 0 && (foodMask & filter.excluded) == 0;
+    for (const auto& dish : dishes) {
+        if (allMatch || dish.matches(filter)) {
+            matching.push_back(&dish);
+        }
+    }
+    return matching;
+}
+
 // Overloading the output stream operator to print a Category object
 // This allows Category objects to be printed directly using std::cout or similar
 // @param os The output stream to write to
 // @param category The Category object to print
 // @return The modified output stream
 std::ostream& operator<<(std::ostream& os, const Category& category) {
-    os << "Category: " << category.name << "\n";  // Print category name
-    for (const auto& dish : category.dishes) {
-        // Print each dish in the category by calling its overloaded operator<<
-        os << dish << "\n";
-    }
+    MenuRenderer& renderer = MenuRenderer::local();
+    renderer.category(category);  // Category name, then the details of each dish
+    renderer.flushTo(os);
     return os;  // Return the output stream after writing
 }
@@ -1,24 +1,30 @@
 #include "../h/Dinner.h"
+#include "../h/MenuRenderer.h"
 
 // Constructor for the Dinner class that initializes the base Menu class with categories
 // @param categories: A vector of Category objects that define the available categories in the dinner menu
-Dinner::Dinner(const std::vector<Category>& categories) : Menu(categories) {}
+// @param allocator: The memory resource of the menu's categories
+Dinner::Dinner(std::pmr::vector<Category> categories, const allocator_type& allocator)
+    : Menu(std::move(categories), allocator) {}
 
 // Function to check if the dinner menu is available at the specified time
-// @param time: A string representing the time (e.g., "18:00", "20:00")
+// @param time: The time of day to check (e.g., 18:00, 20:00)
 // @return true if the time is between 18:00 and 22:00, indicating availability for dinner
-bool Dinner::isAvailableAt(const std::string& time) const {
+bool Dinner::isAvailableAt(TimeOfDay time) const {
     // Dinner menu is available from 18:00 to 22:00
-    return time >= "18:00" && time <= "22:00";
+    constexpr TimeWindow dinnerHours{TimeOfDay(18, 0), TimeOfDay(22, 0)};
+    return dinnerHours.contains(time);
 }
 
 // Function to print the dinner menu and all its categories and dishes
 void Dinner::print() const {
-    std::cout << "Dinner Menu:\n"; // Print header for the dinner menu
-    // Iterate through each category and print its details
-    for (const auto& category : categories) {
-        category.print();  // Print each category's details using its print method
-    }
+    Menu::print();  // Header, then each category's details, written at once
+}
+
+// Function to render the header of the dinner menu
+// @param renderer: The renderer to append the header to
+void Dinner::renderTitle(MenuRenderer& renderer) const {
+    renderer.text("Dinner Menu:\n");
 }
 
 // Function to return the description of the dinner menu
@@ -26,3 +32,9 @@ void Dinner::print() const {
 std::string Dinner::getDescription() const {
     return "Dinner Menu";  // Return a simple description string for the dinner menu
 }
+
+// Function to copy the dinner menu on the heap
+// The copy allocates from the default heap, whatever the memory resource of this menu
+std::unique_ptr<Menu> Dinner::clone() const {
+    return std::make_unique<Dinner>(*this);
+}
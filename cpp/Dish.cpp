@@ -1,4 +1,19 @@
 #include "../h/Dish.h"
+#include "../h/MenuRenderer.h"
+#include <algorithm>
+
+namespace {
+
+// Combines the food types of a list of ingredients into one mask
+FoodMask computeFoodMask(const std::pmr::vector<Ingredient>& ingredients) {
+    FoodMask mask = 0;
+    for (const auto& ingredient : ingredients) {
+        mask |= toFoodMask(ingredient.getType());
+    }
+    return mask;
+}
+
+} // namespace
 
 // Constructor for the Dish class, initializing all member variables
 // @param name: The name of the dish
@@ -6,34 +21,84 @@
 // @param weight: The weight of the dish
 // @param ingredients: A vector of Ingredient objects that the dish consists of
 
-int Dish::instanceCount=0;
-Dish::Dish(std::string name, float price, float weight, const std::vector<Ingredient>& ingredients)
-    : name(std::move(name)), price(price), weight(weight), ingredients(ingredients) {
+std::atomic<int> Dish::instanceCount=0;
+Dish::Dish(std::string_view name, Money price, float weight, std::pmr::vector<Ingredient> ingredients,
+           const allocator_type& allocator)
+    : name(SymbolTable::intern(name)), price(price), weight(weight), ingredients(std::move(ingredients), allocator),
+      foodMask(computeFoodMask(this->ingredients)) {
   instanceCount++;
     }
 
+// Copies a dish into the memory resource of the given allocator
+Dish::Dish(const Dish& other, const allocator_type& allocator)
+    : name(other.name), price(other.price), weight(other.weight), ingredients(other.ingredients, allocator),
+      foodMask(other.foodMask) {}
+
+// Moves a dish; the ingredients are copied if the allocator uses another memory resource
+Dish::Dish(Dish&& other, const allocator_type& allocator)
+    : name(other.name), price(other.price), weight(other.weight), ingredients(std::move(other.ingredients), allocator),
+      foodMask(other.foodMask) {}
+
 // Returns the name of the dish
-// @return The name of the dish
-const std::string& Dish::getName() const {
+// @return A view of the interned name of the dish
+std::string_view Dish::getName() const {
+    return SymbolTable::view(name);
+}
+
+// Returns the interned name of the dish
+// @return The symbol of the dish's name
+Symbol Dish::getSymbol() const {
     return name;
 }
 
-// Returns the price of the dish
-// @return The price of the dish
-float Dish::getPrice() const {
-    return price;
+// Changes the price of the dish
+// @param newPrice The new price
+void Dish::setPrice(Money newPrice) {
+    price = newPrice;
+}
+
+// Returns the weight of the dish
+// @return The weight of the dish
+float Dish::getWeight() const {
+    return weight;
 }
 
-// Checks if the dish is vegetarian by inspecting its ingredients
+// Returns the ingredients of the dish
+// @return A vector containing the dish's ingredients
+const std::pmr::vector<Ingredient>& Dish::getIngredients() const {
+    return ingredients;
+}
+
+// Adds an ingredient and sets its food type bit
+// @param ingredient: The ingredient to add
+void Dish::addIngredient(const Ingredient& ingredient) {
+    ingredients.push_back(ingredient);
+    foodMask |= toFoodMask(ingredient.getType());
+}
+
+// Removes the ingredients with the given name; the mask is recomputed since other
+// ingredients may share the removed ingredient's food type
+// @param ingredientName: The name of the ingredient to remove
+// @return true if at least one ingredient was removed
+bool Dish::removeIngredient(std::string_view ingredientName) {
+    const auto removed = std::erase_if(ingredients, [&](const Ingredient& ingredient) {
+        return ingredient.getName() == ingredientName;
+    });
+    foodMask = computeFoodMask(ingredients);
+    return removed > 0;
+}
+
+// Checks a dietary constraint with two bitwise operations
+// @param filter: The constraint to check
+// @return true if the dish satisfies the constraint
+bool Dish::matches(DietaryFilter filter) const {
+    return filter.matches(foodMask);
+}
+
+// Checks if the dish is vegetarian using the precomputed food mask
 // @return true if the dish contains no meat, otherwise false
 bool Dish::isVegetarian() const {
-    // Iterates over each ingredient to check if any is of type MEAT
-    for (const auto& ingredient : ingredients) {
-        if (ingredient.getType() == FoodType::MEAT) {
-            return false;  // Dish is not vegetarian if it contains meat
-        }
-    }
-    return true;  // Dish is vegetarian if no meat ingredient is found
+    return matches(DietaryFilter::vegetarian());
 }
 int Dish::getInstanceCount() {return instanceCount;}
 
@@ -44,15 +109,15 @@ int Dish::getInstanceCount() {return instanceCount;}
 // @param dish: The dish to be printed
 // @return The output stream with the dish's details inserted
 std::ostream& operator<<(std::ostream& os, const Dish& dish) {
-    os << "Dish: " << dish.name << " - Price: " << dish.price << " RON\n";  // Print dish name and price
-    os << "Ingredients: \n";
-    for (const auto& ingredient : dish.ingredients) {
-        os << "  - " << ingredient << "\n";  // Print each ingredient in the dish
-    }
+    MenuRenderer& renderer = MenuRenderer::local();
+    renderer.dish(dish);  // Dish name and price, then each ingredient
+    renderer.flushTo(os);
     return os;
 }
 
 // Prints a simplified representation of the dish with just its name and price
 void Dish::print() const {
-    std::cout << name << ": " << price << " RON";
+    MenuRenderer& renderer = MenuRenderer::local();
+    renderer.dishLine(*this);
+    renderer.flushTo(std::cout);
 }
@@ -0,0 +1,417 @@
+#include "../h/DishCatalog.h"
+#include "../h/PriceTotals.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+// Reorders the elements of column[first, first + order.size()) following order
+template <typename T>
+void permute(std::vector<T>& column, DishId first, const std::vector<std::uint32_t>& order) {
+    std::vector<T> reordered;
+    reordered.reserve(order.size());
+    for (const std::uint32_t offset : order) {
+        reordered.push_back(column[first + offset]);
+    }
+    std::ranges::copy(reordered, column.begin() + first);
+}
+
+} // namespace
+
+DishCatalog::~DishCatalog() {
+    for (const auto& menu : menus) {
+        menu.menu->detach(this);
+    }
+}
+
+// Appends unused rows to every column
+DishId DishCatalog::appendRows(std::size_t count) {
+    const auto first = static_cast<DishId>(names.size());
+    const std::size_t size = names.size() + count;
+    names.resize(size);
+    prices.resize(size);
+    weights.resize(size);
+    ingredientBegin.resize(size);
+    ingredientCount.resize(size);
+    flags.resize(size);
+    used.resize(size);
+    unusedRows += count;
+    return first;
+}
+
+// Stores a dish in a row; its ingredients are appended to the shared pool
+void DishCatalog::writeDish(DishId id, const Dish& dish) {
+    names[id] = dish.getSymbol();
+    prices[id] = dish.getPrice();
+    weights[id] = dish.getWeight();
+    flags[id] = dish.getFoodMask();
+    ingredientBegin[id] = static_cast<std::uint32_t>(ingredientPool.size());
+    ingredientCount[id] = static_cast<std::uint32_t>(dish.getIngredients().size());
+    for (const auto& ingredient : dish.getIngredients()) {
+        ingredientPool.push_back(ingredient);
+    }
+    if (!used[id]) {
+        used[id] = true;
+        --unusedRows;
+    }
+}
+
+// Copies a row; both rows then share the ingredients until the caller clears the source
+void DishCatalog::copyRow(DishId from, DishId to) {
+    names[to] = names[from];
+    prices[to] = prices[from];
+    weights[to] = weights[from];
+    ingredientBegin[to] = ingredientBegin[from];
+    ingredientCount[to] = ingredientCount[from];
+    flags[to] = flags[from];
+    if (!used[to]) {
+        used[to] = true;
+        --unusedRows;
+    }
+}
+
+void DishCatalog::clearRows(DishId first, std::uint32_t count) {
+    for (DishId id = first; id < first + count; ++id) {
+        if (used[id]) {
+            used[id] = false;
+            ++unusedRows;
+        }
+    }
+}
+
+// Grows the rows reserved for a category, in place when its range ends the columns,
+// otherwise by moving its dishes to a new range at the end
+void DishCatalog::reserveRows(CategoryRow& category, std::uint32_t capacity) {
+    if (category.first + category.capacity == names.size()) {
+        appendRows(capacity - category.capacity);
+    } else {
+        const DishId first = appendRows(capacity);
+        for (std::uint32_t i = 0; i < category.count; ++i) {
+            copyRow(category.first + i, first + i);
+        }
+        clearRows(category.first, category.count);
+        category.first = first;
+    }
+    category.capacity = capacity;
+}
+
+// Copies one dish into the columns, outside any category
+DishId DishCatalog::addDish(const Dish& dish) {
+    const DishId id = appendRows(1);
+    writeDish(id, dish);
+    return id;
+}
+
+// Stores a category in a free row of the category table and fills its range
+std::uint32_t DishCatalog::storeCategory(const Category& category, std::uint32_t menu) {
+    const CategoryRow row{SymbolTable::intern(category.getName()), static_cast<DishId>(names.size()), 0, 0,
+                          category.getAvailability(), menu};
+    std::uint32_t index;
+    if (freeCategories.empty()) {
+        index = static_cast<std::uint32_t>(categories.size());
+        categories.push_back(row);
+    } else {
+        index = freeCategories.back();
+        freeCategories.pop_back();
+        categories[index] = row;
+    }
+    fillCategory(categories[index], category);
+    return index;
+}
+
+// Replaces the dishes of a category's range with the dishes of source, in their order
+void DishCatalog::fillCategory(CategoryRow& category, const Category& source) {
+    for (DishId id = category.first; id < category.first + category.count; ++id) {
+        unusedIngredients += ingredientCount[id];
+    }
+    clearRows(category.first, category.count);
+    category.count = 0;
+    const auto& dishes = source.getDishes();
+    if (dishes.size() > category.capacity) {
+        reserveRows(category, static_cast<std::uint32_t>(dishes.size()));
+    }
+    for (const auto& dish : dishes) {
+        writeDish(category.first + category.count++, dish);
+    }
+}
+
+// Frees the range and the table row of a removed category
+void DishCatalog::releaseCategory(std::uint32_t row) {
+    CategoryRow& category = categories[row];
+    for (DishId id = category.first; id < category.first + category.count; ++id) {
+        unusedIngredients += ingredientCount[id];
+    }
+    clearRows(category.first, category.count);
+    category = {category.name, 0, 0, 0, category.availability, NoMenu};
+    freeCategories.push_back(row);
+}
+
+// Fills the next reserved row of the category, doubling the reservation when it is full
+void DishCatalog::appendDish(CategoryRow& category, const Dish& dish) {
+    if (category.count == category.capacity) {
+        reserveRows(category, std::max<std::uint32_t>(4, category.capacity * 2));
+    }
+    writeDish(category.first + category.count++, dish);
+}
+
+// Removes the first dish with the name, like Category::removeDish, keeping the others in order
+void DishCatalog::removeDish(CategoryRow& category, Symbol dish) {
+    const DishId last = category.first + category.count;
+    const auto found = std::find(names.begin() + category.first, names.begin() + last, dish);
+    if (found == names.begin() + last) {
+        return;
+    }
+    const auto removed = static_cast<DishId>(found - names.begin());
+    unusedIngredients += ingredientCount[removed];
+    for (DishId id = removed + 1; id < last; ++id) {
+        copyRow(id, id - 1);
+    }
+    clearRows(last - 1, 1);
+    --category.count;
+}
+
+// Flattens a category into a contiguous range of dishes
+CategoryView DishCatalog::addCategory(const Category& category) {
+    return {*this, storeCategory(category, NoMenu)};
+}
+
+// Flattens all the categories of a menu, then follows its changes
+MenuView DishCatalog::addMenu(Menu& menu) {
+    if (const auto tracked = menuRows.find(menu.getId()); tracked != menuRows.end()) {
+        return {*this, tracked->second};
+    }
+    const auto index = static_cast<std::uint32_t>(menus.size());
+    menus.push_back({&menu, {}, {}});
+    for (const auto& category : menu.getCategory()) {
+        const std::uint32_t row = storeCategory(category, index);
+        menus.back().rowOf.emplace(categories[row].name, row);
+        menus.back().categories.push_back(row);
+    }
+    menuRows.emplace(menu.getId(), index);
+    menu.attach(this, Delivery::Sync);
+    return {*this, index};
+}
+
+// Lists the category rows in the menu's current order
+void DishCatalog::followOrder(MenuRow& menu) {
+    menu.categories.clear();
+    for (const auto& category : menu.menu->getCategory()) {
+        menu.categories.push_back(menu.rowOf.at(SymbolTable::intern(category.getName())));
+    }
+}
+
+void DishCatalog::update(const MenuEvent& event) {
+    const auto tracked = menuRows.find(event.menuId);
+    if (tracked == menuRows.end()) {
+        return;  // Only menus added with addMenu() are tracked
+    }
+    MenuRow& menu = menus[tracked->second];
+    const auto row = menu.rowOf.find(event.category);
+    const Category* source = event.kind == MenuEventKind::CategoriesSorted
+                                 ? nullptr  // The event names no category
+                                 : menu.menu->findCategory(SymbolTable::view(event.category));
+    switch (event.kind) {
+        case MenuEventKind::CategoryAdded:
+            if (source != nullptr) {
+                const std::uint32_t added = storeCategory(*source, tracked->second);
+                menu.rowOf.emplace(event.category, added);
+                menu.categories.push_back(added);
+            }
+            break;
+        case MenuEventKind::CategoryRemoved:
+            if (row != menu.rowOf.end()) {
+                releaseCategory(row->second);
+                menu.rowOf.erase(row);
+                followOrder(menu);  // The menu moved its last category into the freed slot
+            }
+            break;
+        case MenuEventKind::DishAdded:
+            if (row != menu.rowOf.end() && source != nullptr) {
+                CategoryRow& category = categories[row->second];
+                const auto& dishes = source->getDishes();
+                if (event.dishIndex == category.count && event.dishIndex < dishes.size() &&
+                    dishes[event.dishIndex].getSymbol() == event.dish) {
+                    appendDish(category, dishes[event.dishIndex]);
+                } else {
+                    fillCategory(category, *source);  // The range no longer matches the category; copy it again
+                }
+            }
+            break;
+        case MenuEventKind::DishRemoved:
+            if (row != menu.rowOf.end()) {
+                removeDish(categories[row->second], event.dish);
+            }
+            break;
+        case MenuEventKind::PriceChanged:
+            if (row != menu.rowOf.end()) {
+                const CategoryRow& category = categories[row->second];
+                const auto first = names.begin() + category.first;
+                const auto found = std::find(first, first + category.count, event.dish);
+                if (found != first + category.count) {
+                    prices[static_cast<DishId>(found - names.begin())] = event.newPrice;
+                }
+            }
+            break;
+        case MenuEventKind::CategoriesSorted:
+            for (const auto& [name, sorted] : menu.rowOf) {
+                fillCategory(categories[sorted], *menu.menu->findCategory(SymbolTable::view(name)));
+            }
+            followOrder(menu);
+            break;
+    }
+    compactIfSparse();
+}
+
+// Once unused rows or ingredients outnumber the used ones, packs the used rows and their
+// ingredients at the front of the columns, keeping their order; reservations are dropped
+void DishCatalog::compactIfSparse() {
+    const std::size_t usedRows = names.size() - unusedRows;
+    const std::size_t usedIngredients = ingredientPool.size() - unusedIngredients;
+    if (unusedRows <= std::max(MinUnusedToCompact, usedRows) &&
+        unusedIngredients <= std::max(MinUnusedToCompact, usedIngredients)) {
+        return;
+    }
+    std::vector<DishId> renumbered(names.size());
+    std::vector<Ingredient> pool;
+    pool.reserve(usedIngredients);
+    DishId next = 0;
+    for (DishId id = 0; id < names.size(); ++id) {
+        if (!used[id]) {
+            continue;
+        }
+        const auto ingredients = ingredientsOf(id);
+        renumbered[id] = next;
+        names[next] = names[id];
+        prices[next] = prices[id];
+        weights[next] = weights[id];
+        flags[next] = flags[id];
+        ingredientBegin[next] = static_cast<std::uint32_t>(pool.size());
+        ingredientCount[next] = static_cast<std::uint32_t>(ingredients.size());
+        pool.insert(pool.end(), ingredients.begin(), ingredients.end());
+        ++next;
+    }
+    names.resize(next);
+    prices.resize(next);
+    weights.resize(next);
+    ingredientBegin.resize(next);
+    ingredientCount.resize(next);
+    flags.resize(next);
+    used.assign(next, true);
+    ingredientPool = std::move(pool);
+    unusedRows = 0;
+    unusedIngredients = 0;
+    for (auto& category : categories) {
+        category.first = category.count == 0 ? next : renumbered[category.first];
+        category.capacity = category.count;
+    }
+}
+
+// Stable-sorts the category's rows by name, then applies the same permutation to every column
+void DishCatalog::sortCategory(const CategoryView& category) {
+    if (categories[category.index].menu != NoMenu) {
+        throw std::invalid_argument("A category of a tracked menu follows the menu's order; sort the menu instead");
+    }
+    const DishId first = category.firstDish();
+    std::vector<std::uint32_t> order(category.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::ranges::stable_sort(order, [&](std::uint32_t a, std::uint32_t b) {
+        return SymbolTable::view(names[first + a]) < SymbolTable::view(names[first + b]);
+    });
+
+    permute(names, first, order);
+    permute(prices, first, order);
+    permute(weights, first, order);
+    permute(ingredientBegin, first, order);
+    permute(ingredientCount, first, order);
+    permute(flags, first, order);
+}
+
+// Materializes a Dish object from the columns of one row
+Dish DishCatalog::dish(DishId id) const {
+    const auto ingredients = ingredientsOf(id);
+    return {SymbolTable::view(names[id]), prices[id], weights[id],
+            std::pmr::vector<Ingredient>(ingredients.begin(), ingredients.end())};
+}
+
+// Sums a contiguous slice of the price column
+Money DishCatalog::totalPrice(DishId first, std::uint32_t count) const {
+    return PriceTotals::sum(std::span<const Money>(prices).subspan(first, count));
+}
+
+// Gathers the prices of the given rows and sums them
+Money DishCatalog::totalPrice(std::span<const DishId> ids) const {
+    return PriceTotals::sumSelected(prices, ids);
+}
+
+std::string_view CategoryView::getName() const {
+    return SymbolTable::view(catalog->categories[index].name);
+}
+
+DishId CategoryView::firstDish() const {
+    return catalog->categories[index].first;
+}
+
+std::uint32_t CategoryView::size() const {
+    return catalog->categories[index].count;
+}
+
+bool CategoryView::isAvailableAt(TimeOfDay time) const {
+    return catalog->categories[index].availability.contains(time);
+}
+
+// Rebuilds the Dish objects of the category (view adapter for Category::getDishes)
+std::vector<Dish> CategoryView::getDishes() const {
+    std::vector<Dish> dishes;
+    dishes.reserve(size());
+    for (DishId id = firstDish(); id < firstDish() + size(); ++id) {
+        dishes.push_back(catalog->dish(id));
+    }
+    return dishes;
+}
+
+Money CategoryView::totalPrice() const {
+    return catalog->totalPrice(firstDish(), size());
+}
+
+// Scans only the flag column of the category
+std::vector<DishId> CategoryView::filter(DietaryFilter filter) const {
+    std::vector<DishId> matching;
+    const auto categoryFlags = catalog->flagColumn().subspan(firstDish(), size());
+    for (std::uint32_t i = 0; i < categoryFlags.size(); ++i) {
+        if (filter.matches(categoryFlags[i])) {
+            matching.push_back(firstDish() + i);
+        }
+    }
+    return matching;
+}
+
+std::vector<DishId> CategoryView::vegetarianDishes() const {
+    return filter(DietaryFilter::vegetarian());
+}
+
+// Prints the category in the same format as operator<< for Category
+std::ostream& operator<<(std::ostream& os, const CategoryView& category) {
+    os << "Category: " << category.getName() << "\n";
+    for (DishId id = category.firstDish(); id < category.firstDish() + category.size(); ++id) {
+        os << category.catalog->dish(id) << "\n";
+    }
+    return os;
+}
+
+std::uint32_t MenuView::size() const {
+    return static_cast<std::uint32_t>(catalog->menus[index].categories.size());
+}
+
+CategoryView MenuView::category(std::uint32_t i) const {
+    return {*catalog, catalog->menus[index].categories[i]};
+}
+
+// Prints the menu in the same format as operator<< for Menu
+std::ostream& operator<<(std::ostream& os, const MenuView& menu) {
+    os << "Menu:\n";
+    for (std::uint32_t i = 0; i < menu.size(); ++i) {
+        os << menu.category(i) << "\n";
+    }
+    return os;
+}
@@ -0,0 +1,83 @@
+#include "../h/DishOrdering.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+constexpr std::uint64_t SignBit = std::uint64_t{1} << 63;
+
+// The first 8 bytes of the name, big-endian and zero-padded: integers compare like the prefixes
+std::uint64_t namePrefix(std::string_view name) {
+    std::uint64_t prefix = 0;
+    for (std::size_t i = 0; i < sizeof(prefix); ++i) {
+        prefix <<= 8;
+        if (i < name.size()) {
+            prefix |= static_cast<unsigned char>(name[i]);
+        }
+    }
+    return prefix;
+}
+
+} // namespace
+
+DishOrdering::DishOrdering() : DishOrdering({{DishSortField::Name}}) {}
+
+DishOrdering::DishOrdering(std::initializer_list<DishSortKey> keys, Popularity popularity)
+    : popularity(std::move(popularity)) {
+    if (keys.size() == 0 || keys.size() > MaxKeys) {
+        throw std::invalid_argument("A dish ordering needs from 1 to 3 keys");
+    }
+    for (const DishSortKey key : keys) {
+        for (std::size_t earlier = 0; earlier < keyCount; ++earlier) {
+            if (this->keys[earlier].field == key.field) {
+                throw std::invalid_argument("A dish ordering cannot repeat a key");
+            }
+        }
+        if (key.field == DishSortField::Popularity && !this->popularity) {
+            throw std::invalid_argument("Ordering by popularity needs a popularity function");
+        }
+        if (key.field == DishSortField::Name) {
+            nameKey = keyCount;
+        }
+        this->keys[keyCount++] = key;
+    }
+}
+
+bool DishOrdering::dependsOnDishesOnly() const {
+    return std::ranges::none_of(sortKeys(), [](DishSortKey key) { return key.field == DishSortField::Popularity; });
+}
+
+void DishOrdering::computeKeys(std::span<const Dish> dishes, std::size_t first, std::span<Key> keys) const {
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        const Dish& dish = dishes[first + i];
+        Key& key = keys[i];
+        key.position = static_cast<std::uint32_t>(first + i);
+        for (std::size_t k = 0; k < keyCount; ++k) {
+            std::uint64_t value = 0;
+            switch (this->keys[k].field) {
+                case DishSortField::Name:
+                    value = namePrefix(dish.getName());
+                    break;
+                case DishSortField::Price:
+                    value = static_cast<std::uint64_t>(dish.getPrice().toBani()) ^ SignBit;  // Negative amounts first
+                    break;
+                case DishSortField::Popularity:
+                    value = popularity(dish);
+                    break;
+            }
+            key.fields[k] = this->keys[k].descending ? ~value : value;
+        }
+    }
+}
+
+int DishOrdering::compareNames(const Key& a, const Key& b, std::span<const Dish> dishes) const {
+    const int order = dishes[a.position].getName().compare(dishes[b.position].getName());
+    return keys[nameKey].descending ? (order < 0) - (order > 0) : order;
+}
+
+void DishOrdering::sort(std::span<Key> keys, std::span<const Dish> dishes) const {
+    // Positions break every tie, so an unstable sort gives the stable order
+    std::sort(keys.begin(), keys.end(), [&](const Key& a, const Key& b) { return less(a, b, dishes); });
+}
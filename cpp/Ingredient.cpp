@@ -1,12 +1,18 @@
 #include "../h/Ingredient.h"
 
-Ingredient::Ingredient(std::string name, FoodType type)
-    : name(std::move(name)), type(type) {}  // Initialize name and type using an initializer list
+Ingredient::Ingredient(std::string_view name, FoodType type)
+    : name(SymbolTable::intern(name)), type(type) {}  // Intern the name so equal names share storage
 
 // Getter for the name of the ingredient
-// @return: A constant reference to the ingredient's name
-const std::string& Ingredient::getName() const {
-    return name;  // Return the name of the ingredient
+// @return: A view of the ingredient's interned name
+std::string_view Ingredient::getName() const {
+    return SymbolTable::view(name);  // Resolve the symbol to its text
+}
+
+// Getter for the interned name of the ingredient
+// @return: The symbol of the ingredient's name
+Symbol Ingredient::getSymbol() const {
+    return name;
 }
 
 // Getter for the type of the ingredient
@@ -20,6 +26,6 @@ FoodType Ingredient::getType() const {
 // @param ingredient: The Ingredient object to print
 // @return: The output stream after printing the ingredient's name
 std::ostream& operator<<(std::ostream& os, const Ingredient& ingredient) {
-    os << ingredient.name;  // Print the name of the ingredient
+    os << ingredient.getName();  // Print the name of the ingredient
     return os;  // Return the stream so it can be chained
 }
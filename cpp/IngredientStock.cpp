@@ -0,0 +1,160 @@
+#include "../h/IngredientStock.h"
+#include <stdexcept>
+
+template <typename Slot>
+IngredientStock::SymbolSlots<Slot>::~SymbolSlots() {
+    for (auto& chunk : chunks) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+template <typename Slot>
+Slot* IngredientStock::SymbolSlots<Slot>::find(Symbol symbol) const {
+    const std::size_t chunk = symbol / ChunkSize;
+    if (chunk >= MaxChunks) {
+        return nullptr;
+    }
+    Slot* slots = chunks[chunk].load(std::memory_order_acquire);
+    return slots == nullptr ? nullptr : &slots[symbol % ChunkSize];
+}
+
+template <typename Slot>
+Slot& IngredientStock::SymbolSlots<Slot>::get(Symbol symbol) {
+    const std::size_t chunk = symbol / ChunkSize;
+    if (chunk >= MaxChunks) {
+        throw std::out_of_range("IngredientStock: too many distinct names");
+    }
+    Slot* slots = chunks[chunk].load(std::memory_order_acquire);
+    if (slots == nullptr) {
+        // Two threads may allocate the same chunk; the loser frees its copy and uses the winner's
+        auto* fresh = new Slot[ChunkSize];
+        if (chunks[chunk].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            slots = fresh;
+        } else {
+            delete[] fresh;
+        }
+    }
+    return slots[symbol % ChunkSize];
+}
+
+IngredientStock::IngredientStock() = default;
+
+IngredientStock::~IngredientStock() = default;
+
+void IngredientStock::setStock(const Ingredient& ingredient, std::int64_t units) {
+    IngredientSlot& slot = ingredients.get(ingredient.getSymbol());
+    slot.units.store(units, std::memory_order_release);
+    slot.tracked.store(true, std::memory_order_release);
+    reconcile(slot);
+}
+
+void IngredientStock::restock(const Ingredient& ingredient, std::int64_t units) {
+    IngredientSlot& slot = ingredients.get(ingredient.getSymbol());
+    const std::int64_t before = slot.units.fetch_add(units, std::memory_order_acq_rel);
+    if (!slot.tracked.exchange(true, std::memory_order_acq_rel) || before <= 0 || before + units <= 0) {
+        reconcile(slot);
+    }
+}
+
+std::optional<std::int64_t> IngredientStock::unitsOf(const Ingredient& ingredient) const {
+    const IngredientSlot* slot = ingredients.find(ingredient.getSymbol());
+    if (slot == nullptr || !slot->tracked.load(std::memory_order_acquire)) {
+        return std::nullopt;
+    }
+    return slot->units.load(std::memory_order_acquire);
+}
+
+std::int64_t IngredientStock::take(IngredientSlot& slot, unsigned units) {
+    std::int64_t current = slot.units.load(std::memory_order_relaxed);
+    do {
+        if (current < units) {
+            return -1;  // Never goes below zero, so a shortfall does not fail the reservations of others
+        }
+    } while (!slot.units.compare_exchange_weak(current, current - units, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+    return current - units;
+}
+
+void IngredientStock::give(IngredientSlot& slot, unsigned units) {
+    if (slot.units.fetch_add(units, std::memory_order_acq_rel) <= 0) {
+        reconcile(slot);
+    }
+}
+
+bool IngredientStock::reserve(const Dish& dish, unsigned portions) {
+    // The slots taken so far, to give them back on a shortfall; dishes rarely have more than a handful of ingredients
+    std::array<IngredientSlot*, 16> firstTaken{};
+    std::vector<IngredientSlot*> overflow;
+    std::size_t taken = 0;
+    bool complete = true;
+    for (const auto& ingredient : dish.getIngredients()) {
+        IngredientSlot* slot = ingredients.find(ingredient.getSymbol());
+        if (slot == nullptr || !slot->tracked.load(std::memory_order_acquire)) {
+            continue;
+        }
+        const std::int64_t left = take(*slot, portions);
+        if (left < 0) {
+            complete = false;
+            break;
+        }
+        if (left == 0) {
+            reconcile(*slot);  // This reservation used the last units
+        }
+        if (taken < firstTaken.size()) {
+            firstTaken[taken] = slot;
+        } else {
+            overflow.push_back(slot);
+        }
+        ++taken;
+    }
+    if (complete) {
+        return true;
+    }
+    for (std::size_t i = taken; i-- > 0;) {
+        give(i < firstTaken.size() ? *firstTaken[i] : *overflow[i - firstTaken.size()], portions);
+    }
+    return false;
+}
+
+void IngredientStock::release(const Dish& dish, unsigned portions) {
+    for (const auto& ingredient : dish.getIngredients()) {
+        IngredientSlot* slot = ingredients.find(ingredient.getSymbol());
+        if (slot != nullptr && slot->tracked.load(std::memory_order_acquire)) {
+            give(*slot, portions);
+        }
+    }
+}
+
+// Brings the dependents' depleted counts in line with the current units; called after any
+// change that may have crossed zero. The last call after the last change always wins.
+void IngredientStock::reconcile(IngredientSlot& slot) {
+    const std::scoped_lock lock(slot.dependentsMutex);
+    const bool depleted = slot.tracked.load(std::memory_order_acquire) && slot.units.load(std::memory_order_acquire) <= 0;
+    if (depleted == slot.depletedApplied) {
+        return;
+    }
+    slot.depletedApplied = depleted;
+    for (const Symbol dish : slot.dependents) {
+        dishes.get(dish).depletedIngredients.fetch_add(depleted ? 1 : -1, std::memory_order_acq_rel);
+    }
+}
+
+void IngredientStock::trackDish(const Dish& dish) {
+    DishSlot& dishSlot = dishes.get(dish.getSymbol());
+    if (dishSlot.tracked.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    for (const auto& ingredient : dish.getIngredients()) {
+        IngredientSlot& slot = ingredients.get(ingredient.getSymbol());
+        const std::scoped_lock lock(slot.dependentsMutex);
+        slot.dependents.push_back(dish.getSymbol());
+        if (slot.depletedApplied) {
+            dishSlot.depletedIngredients.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+}
+
+bool IngredientStock::isAvailable(const Dish& dish) const {
+    const DishSlot* slot = dishes.find(dish.getSymbol());
+    return slot == nullptr || slot->depletedIngredients.load(std::memory_order_acquire) <= 0;
+}
@@ -0,0 +1,75 @@
+#include "../h/JsonMenuDisplay.h"
+#include <cmath>
+
+namespace {
+
+// Appends a JSON string, copying the runs of characters that need no escaping at once
+void appendString(MenuRenderer& out, std::string_view text) {
+    constexpr std::string_view Hex = "0123456789abcdef";
+    out.character('"');
+    std::size_t run = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const auto byte = static_cast<unsigned char>(text[i]);
+        if (byte >= 0x20 && byte != '"' && byte != '\\') {
+            continue;
+        }
+        out.text(text.substr(run, i - run));
+        run = i + 1;
+        switch (byte) {
+            case '"':
+                out.text("\\\"");
+                break;
+            case '\\':
+                out.text("\\\\");
+                break;
+            case '\n':
+                out.text("\\n");
+                break;
+            case '\t':
+                out.text("\\t");
+                break;
+            default:
+                out.text("\\u00").character(Hex[byte >> 4]).character(Hex[byte & 0xF]);
+                break;
+        }
+    }
+    out.text(text.substr(run)).character('"');
+}
+
+} // namespace
+
+void JsonMenuDisplay::encode(const Menu& menu, MenuRenderer& out) const {
+    out.text("{\"categories\":[");
+    bool firstCategory = true;
+    for (const auto& category : menu.getCategory()) {
+        out.text(firstCategory ? "{\"name\":" : ",{\"name\":");
+        firstCategory = false;
+        appendString(out, category.getName());
+        out.text(",\"dishes\":[");
+        bool firstDish = true;
+        for (const auto& dish : category.getDishes()) {
+            out.text(firstDish ? "{\"name\":" : ",{\"name\":");
+            firstDish = false;
+            appendString(out, dish.getName());
+            out.text(",\"price\":").money(dish.getPrice());
+            if (std::isfinite(dish.getWeight())) {
+                out.text(",\"weight\":").real(dish.getWeight());
+            } else {
+                out.text(",\"weight\":null");  // JSON has no infinity or NaN
+            }
+            out.text(dish.isVegetarian() ? ",\"vegetarian\":true" : ",\"vegetarian\":false");
+            out.text(",\"ingredients\":[");
+            bool firstIngredient = true;
+            for (const auto& ingredient : dish.getIngredients()) {
+                if (!firstIngredient) {
+                    out.character(',');
+                }
+                firstIngredient = false;
+                appendString(out, ingredient.getName());
+            }
+            out.text("]}");
+        }
+        out.text("]}");
+    }
+    out.text("]}");
+}
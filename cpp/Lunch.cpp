@@ -1,11 +1,14 @@
 #include "../h/Lunch.h"
+#include "../h/MenuRenderer.h"
 
-Lunch::Lunch(const std::vector<Category>& categories) : Menu(categories) {}
+Lunch::Lunch(std::pmr::vector<Category> categories, const allocator_type& allocator)
+    : Menu(std::move(categories), allocator) {}
 
-bool Lunch::isAvailableAt(const std::string& time) const {
+bool Lunch::isAvailableAt(TimeOfDay time) const {
     // This function checks if the lunch menu is available at the specified time
     // The lunch menu is available between 12:00 and 16:00
-    return time >= "12:00" && time <= "16:00";
+    constexpr TimeWindow lunchHours{TimeOfDay(12, 0), TimeOfDay(16, 0)};
+    return lunchHours.contains(time);
 }
 
 std::string Lunch::getDescription() const {
@@ -14,10 +17,15 @@ std::string Lunch::getDescription() const {
 }
 
 void Lunch::print() const {
-    // This function prints out the details of the lunch menu
-    std::cout << "Lunch Menu:\n";
-    // Iterates through each category and calls the `print` method to display it
-    for (const auto& category : categories) {
-        category.print();
-    }
+    // This function prints out the title and the categories of the lunch menu, written at once
+    Menu::print();
+}
+
+void Lunch::renderTitle(MenuRenderer& renderer) const {
+    renderer.text("Lunch Menu:\n");
+}
+
+std::unique_ptr<Menu> Lunch::clone() const {
+    // The copy allocates from the default heap, whatever the memory resource of this menu
+    return std::make_unique<Lunch>(*this);
 }
@@ -1,23 +1,250 @@
 #include "../h/Menu.h"
+#include "../h/MenuRenderer.h"
 #include "../h/InvalidDishException.h"
 #include "../h/InvalidTimeException.h"
 #include "../h/EmptyMenuException.h"
+#include "../h/DuplicateCategoryException.h"
 #include"../h/Category.h"
 #include"../h/Dish.h"
+#include "../h/PriceTotals.h"
+#include "../h/SymbolTable.h"
+#include "../h/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
 #include<stdexcept>
+#include <utility>
 
+namespace {
 
-Menu::Menu(const std::vector<Category>& categories) : categories(categories) {}
+DuplicateCategoryException duplicateCategory(std::string_view name) {
+    std::string message = "Duplicate category: ";
+    message += name;
+    return DuplicateCategoryException(message);
+}
+
+} // namespace
+
+Menu::Menu(std::pmr::vector<Category> categories, const allocator_type& allocator)
+    : categoryIndex(allocator), categories(std::move(categories), allocator) {
+    categoryIndex.reserve(this->categories.size());
+    for (std::size_t slot = 0; slot < this->categories.size(); ++slot) {
+        const auto& category = this->categories[slot];
+        if (!categoryIndex.try_emplace(std::pmr::string(category.getName(), allocator), slot).second) {
+            throw duplicateCategory(category.getName());
+        }
+        countFoodTypes(category.getFoodMask(), +1);
+    }
+}
+
+std::uint64_t Menu::Identity::next() {
+    static std::atomic<std::uint64_t> lastId{0};
+    return lastId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+Symbol Menu::eventSymbol(std::string_view name) const {
+    return hasObservers() ? SymbolTable::intern(name) : MenuEvent::NoSymbol;
+}
+
+void Menu::publish(MenuEvent event) {
+    if (!hasObservers()) {
+        return;  // Nobody listens: the event is never built into anything
+    }
+    event.menuId = identity.value;
+    notify(event);
+}
+
+void Menu::countFoodTypes(FoodMask mask, int delta) {
+    foodMask = 0;
+    for (std::size_t type = 0; type < foodTypeCounts.size(); ++type) {
+        if (mask & (FoodMask{1} << type)) {
+            foodTypeCounts[type] += delta;
+        }
+        if (foodTypeCounts[type] > 0) {
+            foodMask |= FoodMask{1} << type;
+        }
+    }
+}
 
 void Menu::sortCategories() {
-    // Iterate through each category and sort its dishes alphabetically
-    for (auto& category : categories) {
-        category.sortDishesAlphabetically();
+    sortCategories(DishOrdering());  // Alphabetically, by name
+}
+
+void Menu::sortCategories(const DishOrdering& ordering) {
+    // Every category is sorted before any dish moves, so a throwing popularity function changes nothing
+    std::vector<std::vector<DishOrdering::Key>> keys(categories.size());
+    for (std::size_t slot = 0; slot < categories.size(); ++slot) {
+        const auto& dishes = categories[slot].getDishes();
+        keys[slot].resize(dishes.size());
+        ordering.computeKeys(dishes, 0, keys[slot]);
+        ordering.sort(keys[slot], dishes);
+    }
+    for (std::size_t slot = 0; slot < categories.size(); ++slot) {
+        categories[slot].permuteDishes(keys[slot]);
+    }
+    sortCategoriesByName(&ordering, keys);
+}
+
+void Menu::sortCategories(ThreadPool& pool, const DishOrdering& ordering) {
+    // A run of the keys of one category: [begin, end) is sorted by one task
+    struct Run {
+        std::size_t category;
+        std::size_t begin;
+        std::size_t end;
+    };
+    std::vector<std::vector<DishOrdering::Key>> keys(categories.size());
+    std::vector<Run> runs;
+    runs.reserve(categories.size());
+    for (std::size_t slot = 0; slot < categories.size(); ++slot) {
+        const std::size_t size = categories[slot].getDishes().size();
+        keys[slot].resize(size);
+        const std::size_t parts = size >= ParallelSortThreshold ? pool.size() : 1;
+        for (std::size_t part = 0; part < parts; ++part) {
+            runs.push_back({slot, size * part / parts, size * (part + 1) / parts});
+        }
+    }
+    pool.forEach(runs.size(), [&](std::size_t index) {
+        const Run& run = runs[index];
+        const auto& dishes = categories[run.category].getDishes();
+        const auto part = std::span(keys[run.category]).subspan(run.begin, run.end - run.begin);
+        ordering.computeKeys(dishes, run.begin, part);
+        ordering.sort(part, dishes);
+    });
+
+    // Merge the neighbouring runs of each large category pairwise, a round at a time;
+    // the positions break every tie, so merging gives the order of a single sort
+    struct Merge {
+        std::size_t category;
+        std::size_t begin;
+        std::size_t middle;
+        std::size_t end;
+    };
+    while (runs.size() > categories.size()) {
+        std::vector<Merge> merges;
+        std::vector<Run> merged;
+        for (std::size_t index = 0; index < runs.size(); ++index) {
+            const Run& run = runs[index];
+            if (index + 1 < runs.size() && runs[index + 1].category == run.category) {
+                const std::size_t end = runs[++index].end;
+                merges.push_back({run.category, run.begin, run.end, end});
+                merged.push_back({run.category, run.begin, end});
+            } else {
+                merged.push_back(run);
+            }
+        }
+        pool.forEach(merges.size(), [&](std::size_t index) {
+            const Merge& merge = merges[index];
+            const auto& dishes = categories[merge.category].getDishes();
+            const auto begin = keys[merge.category].begin();
+            std::inplace_merge(begin + static_cast<std::ptrdiff_t>(merge.begin),
+                               begin + static_cast<std::ptrdiff_t>(merge.middle),
+                               begin + static_cast<std::ptrdiff_t>(merge.end),
+                               [&](const DishOrdering::Key& a, const DishOrdering::Key& b) {
+                                   return ordering.less(a, b, dishes);
+                               });
+        });
+        runs = std::move(merged);
+    }
+
+    pool.forEach(categories.size(), [&](std::size_t slot) { categories[slot].permuteDishes(keys[slot]); });
+    sortCategoriesByName(&ordering, keys);
+}
+
+void Menu::reorderDishes(std::span<const std::vector<std::uint32_t>> positions) {
+    if (positions.size() != categories.size()) {
+        throw std::invalid_argument("The recorded positions do not match the categories of the menu");
+    }
+    // Every list is checked before any dish moves
+    std::vector<std::size_t> byName(categories.size());
+    std::iota(byName.begin(), byName.end(), std::size_t{0});
+    std::ranges::sort(byName, {}, [&](std::size_t slot) { return categories[slot].getName(); });
+    std::vector<std::vector<DishOrdering::Key>> keys(categories.size());
+    for (std::size_t rank = 0; rank < byName.size(); ++rank) {
+        const std::size_t size = categories[byName[rank]].getDishes().size();
+        const auto& recorded = positions[rank];
+        std::vector<bool> seen(size);
+        if (recorded.size() != size) {
+            throw std::invalid_argument("The recorded positions do not match the dishes of a category");
+        }
+        auto& categoryKeys = keys[byName[rank]];
+        categoryKeys.resize(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            if (recorded[i] >= size || seen[recorded[i]]) {
+                throw std::invalid_argument("The recorded positions are not a permutation of the dishes");
+            }
+            seen[recorded[i]] = true;
+            categoryKeys[i].position = recorded[i];
+        }
+    }
+    for (std::size_t slot = 0; slot < categories.size(); ++slot) {
+        categories[slot].permuteDishes(keys[slot]);
+    }
+    sortCategoriesByName(nullptr, keys);
+}
+
+void Menu::sortCategoriesByName(const DishOrdering* ordering, std::vector<std::vector<DishOrdering::Key>>& keys) {
+    // Names are unique, so the order is the same as a stable sort's; the keys follow their categories
+    std::vector<std::size_t> byName(categories.size());
+    std::iota(byName.begin(), byName.end(), std::size_t{0});
+    std::ranges::sort(byName, {}, [&](std::size_t slot) { return categories[slot].getName(); });
+    std::vector<std::vector<DishOrdering::Key>> sortedKeys(keys.size());
+    for (std::size_t slot = 0; slot < byName.size(); ++slot) {
+        sortedKeys[slot] = std::move(keys[byName[slot]]);
+    }
+    std::ranges::sort(categories, {}, &Category::getName);
+    for (std::size_t slot = 0; slot < categories.size(); ++slot) {
+        categoryIndex.find(categories[slot].getName())->second = slot;
+    }
+    // The keys are lent to the synchronous observers for the duration of the event only
+    const auto endSort = [&] {
+        sorting.ordering = nullptr;
+        sorting.keys = {};
+    };
+    sorting.ordering = ordering;
+    sorting.keys = sortedKeys;
+    try {
+        publish({.kind = MenuEventKind::CategoriesSorted});
+    } catch (...) {
+        endSort();
+        throw;
+    }
+    endSort();
+}
+
+const DishOrdering* Menu::sortingBy() const {
+    return sorting.ordering;
+}
+
+std::span<const DishOrdering::Key> Menu::sortedKeys(std::size_t slot) const {
+    return slot < sorting.keys.size() ? std::span<const DishOrdering::Key>(sorting.keys[slot]) : std::span<const DishOrdering::Key>();
+}
+
+std::span<const Category> Menu::getCategory() const {
+    return categories;
+}
+
+FoodMask Menu::getFoodMask() const {
+    return foodMask;
+}
+
+bool Menu::isVegetarian() const {
+    return DietaryFilter::vegetarian().matches(foodMask);
+}
+
+std::vector<const Dish*> Menu::filter(DietaryFilter filter) const {
+    std::vector<const Dish*> matching;
+    if ((foodMask & filter.required) != filter.required) {
+        return matching;  // No dish on the menu contains every required food type
+    }
+    for (const auto& category : categories) {
+        const auto categoryMatches = category.filter(filter);
+        matching.insert(matching.end(), categoryMatches.begin(), categoryMatches.end());
     }
+    return matching;
 }
 
-float Menu::calculateTotalPrice(const std::vector<Dish>& orderedDishes) {
-    float total = 0.0;
+Money Menu::calculateTotalPrice(std::span<const Dish> orderedDishes) {
+    Money total;
 
     // Sum up the prices of the ordered dishes
     for (const auto& dish : orderedDishes) {
@@ -26,29 +253,43 @@ float Menu::calculateTotalPrice(const std::vector<Dish>& orderedDishes) {
     return total;
 }
 
-std::ostream& operator<<(std::ostream& os, const Menu& menu) {
-    os << "Menu:\n";
-
-    // Iterate through the categories and print each one using the overloaded operator
-    for (const auto& category : menu.categories) {
-        os << category << "\n";
-    }
+Money Menu::calculateTotalPrice(std::span<const Money> linePrices) {
+    return PriceTotals::sum(linePrices);
+}
 
+std::ostream& operator<<(std::ostream& os, const Menu& menu) {
+    // The whole menu is formatted first, then written with a single insertion
+    MenuRenderer& renderer = MenuRenderer::local();
+    renderer.menu(menu);
+    renderer.flushTo(os);
     return os;
 }
 
 void Menu::print() const {
-    // Print all categories of the menu
-    for (const auto& category : categories) {
-        category.print();
-    }
+    // Print the title and all categories of the menu
+    MenuRenderer& renderer = MenuRenderer::local();
+    renderer.menuListing(*this);
+    renderer.flushTo(std::cout);
 }
- void Menu::checkAvailability(const std::string& time) {
-    if (time != "08:00" && time != "12:00" && time != "18:00") {
+
+void Menu::renderTitle(MenuRenderer&) const {
+    // A plain menu has no title
+}
+bool Menu::isAvailableAt(const std::string& time) const {
+    return isAvailableAt(TimeOfDay::parse(time));
+}
+
+void Menu::checkAvailability(TimeOfDay time) {
+    constexpr TimeOfDay openingTimes[] = {TimeOfDay(8, 0), TimeOfDay(12, 0), TimeOfDay(18, 0)};
+    if (std::ranges::find(openingTimes, time) == std::end(openingTimes)) {
         throw InvalidTimeException("Invalid time for menu availability.");
     }
 }
 
+ void Menu::checkAvailability(const std::string& time) {
+    checkAvailability(TimeOfDay::parse(time));
+}
+
  void Menu::checkMenuEmpty(const std::vector<std::string>& menuItems) {
     if (menuItems.empty()) {
         throw EmptyMenuException("The menu is empty.");
@@ -60,19 +301,133 @@ void Menu::print() const {
     }
 }
 
-void Menu::addCategory(const Category& category) {
-    categories.push_back(category);
-    notify("Category added: " + category.getName()); // Notify observers
+void Menu::addCategory(Category category) {
+    if (categoryIndex.contains(category.getName())) {
+        throw duplicateCategory(category.getName());
+    }
+    categories.push_back(std::move(category));
+    registerLastCategory();
 }
 
-void Menu::removeCategory(const std::string& categoryName) {
-    auto it = std::remove_if(categories.begin(), categories.end(), [&](const Category& category) {
-        return category.getName() == categoryName;
-    });
-    if (it != categories.end()) {
-        categories.erase(it, categories.end());
-        notify("Category removed: " + categoryName); // Notify observers
+Category& Menu::registerLastCategory() {
+    Category& category = categories.back();
+    std::pmr::string key(category.getName(), categoryIndex.get_allocator());
+    if (!categoryIndex.try_emplace(std::move(key), categories.size() - 1).second) {
+        const DuplicateCategoryException duplicate = duplicateCategory(category.getName());
+        categories.pop_back();
+        throw duplicate;
+    }
+    countFoodTypes(category.getFoodMask(), +1);
+    publish({.kind = MenuEventKind::CategoryAdded, .category = eventSymbol(category.getName())}); // Notify observers
+    return category;
+}
+
+void Menu::removeCategory(std::string_view categoryName) {
+    const auto it = categoryIndex.find(categoryName);
+    if (it == categoryIndex.end()) {
+        return;
     }
-    
+    // Intern the name first: categoryName may point into the category being removed
+    const Symbol removed = eventSymbol(categoryName);
 
+    // Swap-and-pop: the last category takes the freed slot
+    const std::size_t slot = it->second;
+    categoryIndex.erase(it);
+    countFoodTypes(categories[slot].getFoodMask(), -1);
+    if (slot + 1 != categories.size()) {
+        categories[slot] = std::move(categories.back());
+        categoryIndex.find(categories[slot].getName())->second = slot;
+    }
+    categories.pop_back();
+    publish({.kind = MenuEventKind::CategoryRemoved, .category = removed}); // Notify observers
+}
+
+bool Menu::addDish(std::string_view categoryName, Dish dish) {
+    const auto it = categoryIndex.find(categoryName);
+    if (it == categoryIndex.end()) {
+        return false;
+    }
+    Category& category = categories[it->second];
+    const FoodMask before = category.getFoodMask();
+    category.addDish(std::move(dish));
+    registerLastDish(categoryName, category, before);
+    return true;
+}
+
+void Menu::registerLastDish(std::string_view categoryName, const Category& category, FoodMask before) {
+    countFoodTypes(before, -1);
+    countFoodTypes(category.getFoodMask(), +1);
+    const Dish& dish = category.getDishes().back();
+    publish({.kind = MenuEventKind::DishAdded, .category = eventSymbol(categoryName), .dish = dish.getSymbol(),
+             .dishIndex = static_cast<std::uint32_t>(category.getDishes().size() - 1), .newPrice = dish.getPrice()});
+}
+
+bool Menu::removeDish(std::string_view categoryName, std::string_view dishName) {
+    const auto it = categoryIndex.find(categoryName);
+    const auto symbol = SymbolTable::find(dishName);  // A name never interned cannot belong to any dish
+    if (it == categoryIndex.end() || !symbol) {
+        return false;
+    }
+    Category& category = categories[it->second];
+    const Dish* dish = category.findDish(*symbol);
+    if (dish == nullptr) {
+        return false;
+    }
+    const MenuEvent event{.kind = MenuEventKind::DishRemoved, .category = eventSymbol(categoryName), .dish = *symbol,
+                          .dishIndex = static_cast<std::uint32_t>(dish - category.getDishes().data()),
+                          .oldPrice = dish->getPrice()};
+    const FoodMask before = category.getFoodMask();
+    category.removeDish(*symbol);
+    countFoodTypes(before, -1);
+    countFoodTypes(category.getFoodMask(), +1);
+    publish(event);
+    return true;
+}
+
+bool Menu::updateDishPrice(std::string_view categoryName, std::string_view dishName, Money newPrice) {
+    const auto it = categoryIndex.find(categoryName);
+    const auto symbol = SymbolTable::find(dishName);
+    if (it == categoryIndex.end() || !symbol) {
+        return false;
+    }
+    Category& category = categories[it->second];
+    Dish* dish = category.findDish(*symbol);
+    if (dish == nullptr) {
+        return false;
+    }
+    const Money oldPrice = dish->getPrice();
+    dish->setPrice(newPrice);
+    publish({.kind = MenuEventKind::PriceChanged, .category = eventSymbol(categoryName), .dish = *symbol,
+             .dishIndex = static_cast<std::uint32_t>(dish - category.getDishes().data()), .oldPrice = oldPrice,
+             .newPrice = newPrice});
+    return true;
+}
+
+const Category* Menu::findCategory(std::string_view categoryName) const {
+    const auto it = categoryIndex.find(categoryName);
+    return it == categoryIndex.end() ? nullptr : &categories[it->second];
+}
+
+const Dish* Menu::findDish(std::string_view categoryName, std::string_view dishName) const {
+    const Category* category = findCategory(categoryName);
+    const auto symbol = SymbolTable::find(dishName);  // A name never interned cannot belong to any dish
+    if (category == nullptr || !symbol) {
+        return nullptr;
+    }
+    return category->findDish(*symbol);
+}
+
+const Dish* Menu::findDish(std::string_view dishName) const {
+    const auto symbol = SymbolTable::find(dishName);
+    if (!symbol) {
+        return nullptr;
+    }
+    for (const auto& category : categories) {
+        const auto& dishes = category.getDishes();
+        const auto it = std::ranges::find(dishes, *symbol, &Dish::getSymbol);
+        if (it != dishes.end()) {
+            return &*it;
+        }
+    }
+    return nullptr;
 }
@@ -0,0 +1,37 @@
+#include "../h/MenuArena.h"
+#include <ranges>
+
+MenuArena::MenuArena(std::size_t initialBytes) : buffer(initialBytes, &upstream) {}
+
+MenuArena::~MenuArena() {
+    destroyMenus();
+}
+
+void MenuArena::reset() {
+    destroyMenus();
+    buffer.release();
+}
+
+// Runs the destructors in reverse creation order; their deallocations are no-ops
+// for the monotonic buffer, the memory itself is freed with the blocks
+void MenuArena::destroyMenus() {
+    for (Menu* menu : std::views::reverse(menus)) {
+        std::destroy_at(menu);
+    }
+    menus.clear();
+}
+
+void* MenuArena::CountingResource::do_allocate(std::size_t size, std::size_t alignment) {
+    void* memory = std::pmr::new_delete_resource()->allocate(size, alignment);
+    bytes += size;
+    return memory;
+}
+
+void MenuArena::CountingResource::do_deallocate(void* memory, std::size_t size, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+    bytes -= size;
+}
+
+bool MenuArena::CountingResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
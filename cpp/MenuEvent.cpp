@@ -0,0 +1,54 @@
+#include "../h/MenuEvent.h"
+
+namespace {
+
+// Appends " dish (category)" for the dish events
+void appendDish(std::string& out, const MenuEvent& event) {
+    out += SymbolTable::view(event.dish);
+    if (event.category != MenuEvent::NoSymbol) {
+        out += " (";
+        out += SymbolTable::view(event.category);
+        out += ')';
+    }
+}
+
+} // namespace
+
+void MenuEvent::formatTo(std::string& out) const {
+    switch (kind) {
+        case MenuEventKind::CategoryAdded:
+            out += "Category added: ";
+            out += SymbolTable::view(category);
+            break;
+        case MenuEventKind::CategoryRemoved:
+            out += "Category removed: ";
+            out += SymbolTable::view(category);
+            break;
+        case MenuEventKind::CategoriesSorted:
+            out += "Categories sorted";
+            break;
+        case MenuEventKind::DishAdded:
+            out += "Dish added: ";
+            appendDish(out, *this);
+            break;
+        case MenuEventKind::DishRemoved:
+            out += "Dish removed: ";
+            appendDish(out, *this);
+            break;
+        case MenuEventKind::PriceChanged:
+            out += "Price changed: ";
+            appendDish(out, *this);
+            out += ' ';
+            out += oldPrice.toString();
+            out += " -> ";
+            out += newPrice.toString();
+            out += " RON";
+            break;
+    }
+}
+
+std::string MenuEvent::toString() const {
+    std::string text;
+    formatTo(text);
+    return text;
+}
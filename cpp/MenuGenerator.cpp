@@ -0,0 +1,134 @@
+#include "../h/MenuGenerator.h"
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// SplitMix64 finalizer; also used to derive names from their pool index
+std::uint64_t mix(std::uint64_t value) {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+// Builds a pronounceable word of the given length from a hash
+std::string word(std::uint64_t hash, std::size_t length) {
+    static constexpr char consonants[] = "bcdfghjklmnprstvz";
+    static constexpr char vowels[] = "aeiou";
+    std::string text(length, ' ');
+    for (std::size_t i = 0; i < length; ++i) {
+        hash = mix(hash + i);
+        text[i] = (i % 2 == 0) ? consonants[hash % (sizeof(consonants) - 1)] : vowels[hash % (sizeof(vowels) - 1)];
+    }
+    text[0] = static_cast<char>(text[0] - 'a' + 'A');
+    return text;
+}
+
+} // namespace
+
+// Builds the ingredient pantry with the configured FoodType mix
+MenuGenerator::MenuGenerator(const GeneratorConfig& config) : config(config), state(config.seed) {
+    pantry.reserve(config.distinctIngredients);
+    for (std::uint32_t i = 0; i < std::max(config.distinctIngredients, 1u); ++i) {
+        const FoodType type = sampleFoodType();
+        pantry.emplace_back(word(mix(config.seed ^ (0x1000000ULL + i)), 4 + i % 6), type);
+    }
+}
+
+// Advances the SplitMix64 sequence
+std::uint64_t MenuGenerator::next() {
+    state += 0x9e3779b97f4a7c15ULL;
+    return mix(state);
+}
+
+// Samples an integer uniformly in [range.min, range.max]
+std::uint32_t MenuGenerator::uniform(UniformRange range) {
+    if (range.max <= range.min) {
+        return range.min;
+    }
+    return range.min + static_cast<std::uint32_t>(next() % (std::uint64_t{range.max} - range.min + 1));
+}
+
+// Samples a food type following the configured weights
+FoodType MenuGenerator::sampleFoodType() {
+    const std::uint64_t total = std::accumulate(config.foodTypeWeights.begin(), config.foodTypeWeights.end(), std::uint64_t{0});
+    if (total == 0) {
+        return FoodType::VEGETABLE;
+    }
+    std::uint64_t pick = next() % total;
+    for (std::size_t type = 0; type < config.foodTypeWeights.size(); ++type) {
+        if (pick < config.foodTypeWeights[type]) {
+            return static_cast<FoodType>(type);
+        }
+        pick -= config.foodTypeWeights[type];
+    }
+    return FoodType::VEGETABLE;
+}
+
+// Derives the name with the given pool index; the same index always gives the same name
+std::string MenuGenerator::dishName(std::uint32_t index) const {
+    const std::uint64_t hash = mix(config.seed ^ index);
+    const std::uint32_t span = config.nameLength.max > config.nameLength.min ? config.nameLength.max - config.nameLength.min + 1 : 1;
+    const std::size_t length = std::max<std::size_t>(config.nameLength.min + hash % span, 1);
+
+    // Two or three words separated by spaces, like real dish names
+    std::string name = word(hash, length);
+    for (std::size_t i = 5; i + 2 < length; i += 6) {
+        name[i] = ' ';
+        name[i + 1] = static_cast<char>(name[i + 1] - 'a' + 'A');
+    }
+    return name;
+}
+
+Ingredient MenuGenerator::nextIngredient() {
+    return pantry[next() % pantry.size()];
+}
+
+Dish MenuGenerator::nextDish() {
+    const std::uint32_t ingredientCount = uniform(config.ingredientsPerDish);
+    std::pmr::vector<Ingredient> ingredients;
+    ingredients.reserve(ingredientCount);
+    for (std::uint32_t i = 0; i < ingredientCount; ++i) {
+        ingredients.push_back(nextIngredient());
+    }
+
+    const std::int64_t minBani = config.minPrice.toBani();
+    const std::int64_t maxBani = std::max(config.maxPrice.toBani(), minBani);
+    const Money price = Money::fromBani(minBani + static_cast<std::int64_t>(next() % static_cast<std::uint64_t>(maxBani - minBani + 1)));
+    const auto weight = static_cast<float>(uniform({50, 800}));
+    const auto nameIndex = static_cast<std::uint32_t>(next() % std::max(config.distinctDishNames, 1u));
+    return {dishName(nameIndex), price, weight, std::move(ingredients)};
+}
+
+Category MenuGenerator::nextCategory() {
+    return nextCategory(uniform(config.dishesPerCategory));
+}
+
+Category MenuGenerator::nextCategory(std::size_t dishes) {
+    std::pmr::vector<Dish> generated;
+    generated.reserve(dishes);
+    for (std::size_t i = 0; i < dishes; ++i) {
+        generated.push_back(nextDish());
+    }
+    return {"Category " + std::to_string(categoriesGenerated++), std::move(generated)};
+}
+
+void MenuGenerator::streamDishes(std::size_t count, const std::function<void(Dish&&)>& sink) {
+    for (std::size_t i = 0; i < count; ++i) {
+        sink(nextDish());
+    }
+}
+
+std::size_t MenuGenerator::streamCategories(std::size_t totalDishes, std::size_t dishesPerCategory,
+                                            const std::function<void(Category&&)>& sink) {
+    std::size_t produced = 0;
+    std::size_t categories = 0;
+    while (produced < totalDishes) {
+        const std::size_t size = dishesPerCategory > 0 ? dishesPerCategory : std::max<std::size_t>(uniform(config.dishesPerCategory), 1);
+        const std::size_t dishes = std::min(size, totalDishes - produced);
+        sink(nextCategory(dishes));
+        produced += dishes;
+        ++categories;
+    }
+    return categories;
+}
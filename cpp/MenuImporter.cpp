@@ -0,0 +1,499 @@
+#include "../h/MenuImporter.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// Dish parsed from one row, with the category it belongs to
+struct ParsedRow {
+    std::string category;
+    Dish dish;
+};
+
+// Everything a worker produced from one chunk
+struct ChunkResult {
+    std::vector<ParsedRow> rows;
+    std::vector<std::pair<std::size_t, std::string>> errors; // Line inside the chunk (0-based) and reason
+    std::size_t lines = 0;
+};
+
+std::string_view trim(std::string_view text) {
+    const auto first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(first, text.find_last_not_of(" \t") - first + 1);
+}
+
+double parseNumber(std::string_view text, const char* field) {
+    text = trim(text);
+    double value = 0;
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (text.empty() || error != std::errc() || end != text.data() + text.size() || !std::isfinite(value)) {
+        throw InvalidDishException(std::string(field) + " is not a number: \"" + std::string(text) + "\"");
+    }
+    return value;
+}
+
+FoodType parseFoodType(std::string_view text) {
+    static constexpr std::array<std::string_view, 7> names = {"VEGETABLE", "DAIRY", "MEAT", "SPICE", "SAUCE", "DESSERT", "CEREAL"};
+    text = trim(text);
+    for (std::size_t type = 0; type < names.size(); ++type) {
+        if (std::equal(text.begin(), text.end(), names[type].begin(), names[type].end(),
+                       [](char a, char b) { return std::toupper(static_cast<unsigned char>(a)) == b; })) {
+            return static_cast<FoodType>(type);
+        }
+    }
+    throw InvalidDishException("unknown food type \"" + std::string(text) + "\"");
+}
+
+// Builds the dish once every field was read, rejecting values no menu can hold
+ParsedRow makeRow(std::string category, std::string_view name, double price, double weight,
+                  std::pmr::vector<Ingredient> ingredients) {
+    if (trim(category).empty()) {
+        throw InvalidDishException("category name is empty");
+    }
+    if (trim(name).empty()) {
+        throw InvalidDishException("dish name is empty");
+    }
+    if (price < 0) {
+        throw InvalidDishException("price is negative");
+    }
+    if (weight < 0) {
+        throw InvalidDishException("weight is negative");
+    }
+    return {std::move(category), Dish(trim(name), price, static_cast<float>(weight), std::move(ingredients))};
+}
+
+// Splits a CSV record into fields; quoted fields containing "" are unescaped into storage
+void splitCsv(std::string_view line, std::vector<std::string_view>& fields, std::deque<std::string>& storage) {
+    fields.clear();
+    storage.clear();
+    std::size_t pos = 0;
+    while (true) {
+        if (pos < line.size() && line[pos] == '"') {
+            std::string* unescaped = nullptr;
+            std::size_t start = ++pos;
+            while (true) {
+                const std::size_t quote = line.find('"', pos);
+                if (quote == std::string_view::npos) {
+                    throw InvalidDishException("unterminated quoted field");
+                }
+                if (quote + 1 < line.size() && line[quote + 1] == '"') {
+                    if (unescaped == nullptr) {
+                        unescaped = &storage.emplace_back();
+                    }
+                    unescaped->append(line.substr(start, quote + 1 - start));
+                    start = pos = quote + 2;
+                    continue;
+                }
+                if (unescaped != nullptr) {
+                    unescaped->append(line.substr(start, quote - start));
+                    fields.emplace_back(*unescaped);
+                } else {
+                    fields.push_back(line.substr(start, quote - start));
+                }
+                pos = quote + 1;
+                break;
+            }
+            if (pos < line.size() && line[pos] != ',') {
+                throw InvalidDishException("unexpected text after a quoted field");
+            }
+        } else {
+            const std::size_t comma = std::min(line.find(',', pos), line.size());
+            fields.push_back(line.substr(pos, comma - pos));
+            pos = comma;
+        }
+        if (pos >= line.size()) {
+            return;
+        }
+        ++pos; // Skip the comma
+    }
+}
+
+// category,dish,price,weight,name:TYPE;name:TYPE
+ParsedRow parseCsvRow(std::string_view line, std::vector<std::string_view>& fields, std::deque<std::string>& storage) {
+    splitCsv(line, fields, storage);
+    if (fields.size() != 5) {
+        throw InvalidDishException("expected 5 fields, found " + std::to_string(fields.size()));
+    }
+    std::pmr::vector<Ingredient> ingredients;
+    std::string_view list = fields[4];
+    while (!trim(list).empty()) {
+        const std::size_t end = std::min(list.find(';'), list.size());
+        const std::string_view item = list.substr(0, end);
+        const std::size_t colon = item.rfind(':');
+        if (colon == std::string_view::npos || trim(item.substr(0, colon)).empty()) {
+            throw InvalidDishException("ingredient \"" + std::string(trim(item)) + "\" is not name:TYPE");
+        }
+        ingredients.emplace_back(trim(item.substr(0, colon)), parseFoodType(item.substr(colon + 1)));
+        list.remove_prefix(std::min(end + 1, list.size()));
+    }
+    return makeRow(std::string(trim(fields[0])), fields[1], parseNumber(fields[2], "price"),
+                   parseNumber(fields[3], "weight"), std::move(ingredients));
+}
+
+// Just enough JSON for one flat dish object per line
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text(text) {}
+
+    ParsedRow parseRow() {
+        std::string category;
+        std::string name;
+        double price = -1;
+        double weight = 0;
+        std::pmr::vector<Ingredient> ingredients;
+        bool hasPrice = false;
+
+        parseObject([&](const std::string& key) {
+            if (key == "category") {
+                category = parseString();
+            } else if (key == "dish" || key == "name") {
+                name = parseString();
+            } else if (key == "price") {
+                price = parseNumber();
+                hasPrice = true;
+            } else if (key == "weight") {
+                weight = parseNumber();
+            } else if (key == "ingredients") {
+                parseArray([&] {
+                    std::string ingredient;
+                    std::string type;
+                    parseObject([&](const std::string& field) {
+                        if (field == "name") {
+                            ingredient = parseString();
+                        } else if (field == "type") {
+                            type = parseString();
+                        } else {
+                            skipValue();
+                        }
+                    });
+                    if (trim(ingredient).empty()) {
+                        throw InvalidDishException("ingredient without a name");
+                    }
+                    ingredients.emplace_back(ingredient, parseFoodType(type));
+                });
+            } else {
+                skipValue();
+            }
+        });
+        skipSpace();
+        if (pos != text.size()) {
+            throw InvalidDishException("unexpected text after the JSON object");
+        }
+        if (!hasPrice) {
+            throw InvalidDishException("price is missing");
+        }
+        return makeRow(std::move(category), name, price, weight, std::move(ingredients));
+    }
+
+private:
+    std::string_view text;
+    std::size_t pos = 0;
+
+    [[noreturn]] void fail(const char* what) const {
+        throw InvalidDishException(std::string("invalid JSON: ") + what + " at column " + std::to_string(pos + 1));
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) {
+            ++pos;
+        }
+    }
+
+    void expect(char c) {
+        skipSpace();
+        if (pos >= text.size() || text[pos] != c) {
+            fail((std::string("expected '") + c + "'").c_str());
+        }
+        ++pos;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos < text.size() && text[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    template <typename OnKey>
+    void parseObject(OnKey onKey) {
+        expect('{');
+        if (consume('}')) {
+            return;
+        }
+        do {
+            const std::string key = parseString();
+            expect(':');
+            onKey(key);
+        } while (consume(','));
+        expect('}');
+    }
+
+    template <typename OnItem>
+    void parseArray(OnItem onItem) {
+        expect('[');
+        if (consume(']')) {
+            return;
+        }
+        do {
+            onItem();
+        } while (consume(','));
+        expect(']');
+    }
+
+    unsigned parseHex4() {
+        if (pos + 4 > text.size()) {
+            fail("truncated \\u escape");
+        }
+        unsigned value = 0;
+        const auto [end, error] = std::from_chars(text.data() + pos, text.data() + pos + 4, value, 16);
+        if (error != std::errc() || end != text.data() + pos + 4) {
+            fail("invalid \\u escape");
+        }
+        pos += 4;
+        return value;
+    }
+
+    static void appendUtf8(std::string& out, unsigned codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string out;
+        while (true) {
+            const std::size_t special = text.find_first_of("\"\\", pos);
+            if (special == std::string_view::npos) {
+                fail("unterminated string");
+            }
+            out.append(text.substr(pos, special - pos));
+            pos = special + 1;
+            if (text[special] == '"') {
+                return out;
+            }
+            if (pos >= text.size()) {
+                fail("unterminated string");
+            }
+            const char escape = text[pos++];
+            switch (escape) {
+                case '"': case '\\': case '/': out += escape; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    unsigned codePoint = parseHex4();
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && text.substr(pos, 2) == "\\u") {
+                        pos += 2;
+                        const unsigned low = parseHex4();
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, codePoint);
+                    break;
+                }
+                default:
+                    fail("invalid escape");
+            }
+        }
+    }
+
+    double parseNumber() {
+        skipSpace();
+        double value = 0;
+        const auto [end, error] = std::from_chars(text.data() + pos, text.data() + text.size(), value);
+        if (error != std::errc() || !std::isfinite(value)) {
+            fail("expected a number");
+        }
+        pos = static_cast<std::size_t>(end - text.data());
+        return value;
+    }
+
+    void skipValue() {
+        skipSpace();
+        if (pos >= text.size()) {
+            fail("expected a value");
+        }
+        switch (text[pos]) {
+            case '"': parseString(); break;
+            case '{': parseObject([this](const std::string&) { skipValue(); }); break;
+            case '[': parseArray([this] { skipValue(); }); break;
+            default:
+                for (const std::string_view literal : {"true", "false", "null"}) {
+                    if (text.substr(pos, literal.size()) == literal) {
+                        pos += literal.size();
+                        return;
+                    }
+                }
+                parseNumber();
+        }
+    }
+};
+
+// Parses every line of a chunk; a bad row is recorded and parsing goes on with the next one
+ChunkResult parseChunk(std::string_view chunk, ImportFormat format, bool skipHeader) {
+    ChunkResult result;
+    std::vector<std::string_view> fields;
+    std::deque<std::string> storage;
+    for (std::size_t pos = 0; pos < chunk.size(); ++result.lines) {
+        const std::size_t end = std::min(chunk.find('\n', pos), chunk.size());
+        std::string_view line = chunk.substr(pos, end - pos);
+        pos = end + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if ((skipHeader && result.lines == 0) || trim(line).empty()) {
+            continue;
+        }
+        try {
+            if (format == ImportFormat::Csv) {
+                result.rows.push_back(parseCsvRow(line, fields, storage));
+            } else {
+                line = trim(line);
+                if (line == "[" || line == "]") {
+                    continue;
+                }
+                if (line.back() == ',') {
+                    line.remove_suffix(1);
+                }
+                result.rows.push_back(JsonReader(line).parseRow());
+            }
+        } catch (const MenuException& exception) {
+            result.errors.emplace_back(result.lines, exception.what());
+        }
+    }
+    return result;
+}
+
+// Reads the next chunk of about chunkSize bytes, cut after its last newline;
+// the partial line left over is kept in carry for the next call
+bool readChunk(std::istream& input, std::size_t chunkSize, std::string& carry, std::string& chunk, std::size_t& bytes) {
+    chunk.swap(carry);
+    carry.clear();
+    while (true) {
+        const std::size_t old = chunk.size();
+        chunk.resize(old + chunkSize);
+        input.read(chunk.data() + old, static_cast<std::streamsize>(chunkSize));
+        const auto got = static_cast<std::size_t>(input.gcount());
+        chunk.resize(old + got);
+        bytes += got;
+        if (got == 0) {
+            return !chunk.empty(); // End of input: the last line may lack a newline
+        }
+        const std::size_t newline = chunk.rfind('\n');
+        if (newline != std::string::npos) {
+            carry.assign(chunk, newline + 1);
+            chunk.resize(newline + 1);
+            return true;
+        }
+        // A single line longer than chunkSize: keep reading until it ends
+    }
+}
+
+} // namespace
+
+MenuImporter::MenuImporter(const ImportOptions& options) : options(options) {}
+
+ImportReport MenuImporter::importDishes(std::istream& input, const DishSink& sink) const {
+    const auto start = std::chrono::steady_clock::now();
+    const unsigned threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunkSize = std::max<std::size_t>(options.chunkSize, 1);
+
+    ImportReport report;
+    std::vector<std::string> chunks(threads);
+    std::string carry;
+    bool firstChunk = true;
+    while (true) {
+        std::size_t count = 0;
+        while (count < threads && readChunk(input, chunkSize, carry, chunks[count], report.bytes)) {
+            ++count;
+        }
+        if (count == 0) {
+            break;
+        }
+
+        // Parse chunks 1..count-1 on worker threads and chunk 0 on this one
+        std::vector<std::future<ChunkResult>> workers;
+        for (std::size_t i = 1; i < count; ++i) {
+            workers.push_back(std::async(std::launch::async, parseChunk, std::string_view(chunks[i]), options.format, false));
+        }
+        std::vector<ChunkResult> results;
+        results.reserve(count);
+        results.push_back(parseChunk(chunks[0], options.format, firstChunk && options.csvHeader && options.format == ImportFormat::Csv));
+        for (auto& worker : workers) {
+            results.push_back(worker.get());
+        }
+        firstChunk = false;
+
+        // Deliver in file order so the output does not depend on the thread count
+        for (auto& result : results) {
+            for (const auto& [line, reason] : result.errors) {
+                ++report.rejected;
+                if (report.errors.size() < options.maxErrors) {
+                    report.errors.emplace_back("line " + std::to_string(report.lines + line + 1) + ": " + reason);
+                }
+            }
+            for (auto& row : result.rows) {
+                sink(row.category, std::move(row.dish));
+            }
+            report.dishes += result.rows.size();
+            report.lines += result.lines;
+        }
+    }
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return report;
+}
+
+ImportReport MenuImporter::importDishes(const std::string& path, const DishSink& sink) const {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) {
+        throw MenuException("Cannot open menu import file " + path);
+    }
+    return importDishes(input, sink);
+}
+
+std::pmr::vector<Category> MenuImporter::importCategories(const std::string& path, ImportReport& report) const {
+    std::unordered_map<std::string, std::size_t> index;
+    std::vector<std::pair<std::string, std::pmr::vector<Dish>>> grouped;
+    report = importDishes(path, [&](std::string_view category, Dish&& dish) {
+        auto [it, inserted] = index.try_emplace(std::string(category), grouped.size());
+        if (inserted) {
+            grouped.emplace_back(it->first, std::pmr::vector<Dish>());
+        }
+        grouped[it->second].second.push_back(std::move(dish));
+    });
+
+    std::pmr::vector<Category> categories;
+    categories.reserve(grouped.size());
+    for (auto& [name, dishes] : grouped) {
+        categories.emplace_back(name, std::move(dishes));
+    }
+    return categories;
+}
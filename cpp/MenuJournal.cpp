@@ -0,0 +1,716 @@
+#include "../h/MenuJournal.h"
+#include "../h/JournalException.h"
+#include "../h/MenuSnapshot.h"
+#include "../h/SymbolTable.h"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr std::array<char, 8> Magic = {'M', 'E', 'N', 'U', 'J', 'R', 'N', 'L'};
+constexpr std::uint32_t Version = 1;
+
+// Start of every journal file; the generation ties it to the snapshot it continues
+struct JournalHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t generation;
+};
+
+// Every record is [payload size u32][checksum u32][payload], the payload starting with the event kind
+constexpr std::size_t RecordHeaderSize = 2 * sizeof(std::uint32_t);
+
+// First byte of a CategoriesSorted payload. A sort is recorded by its keys when sorting the
+// same dishes again gives the same order, else by the slot each dish came from
+constexpr std::uint8_t SortedByKeys = 0;
+constexpr std::uint8_t SortedByPositions = 1;
+
+std::uint32_t checksum(std::span<const std::byte> bytes) {
+    std::uint32_t hash = 2166136261u;  // FNV-1a
+    for (const std::byte byte : bytes) {
+        hash = (hash ^ static_cast<std::uint32_t>(byte)) * 16777619u;
+    }
+    return hash;
+}
+
+std::string snapshotName(std::uint64_t generation) {
+    std::string name = "snapshot-";
+    name += std::to_string(generation);
+    name += ".menusnap";
+    return name;
+}
+
+std::string journalName(std::uint64_t generation) {
+    std::string name = "journal-";
+    name += std::to_string(generation);
+    name += ".log";
+    return name;
+}
+
+// Extracts N from "snapshot-N.menusnap" or "journal-N.log"
+std::optional<std::uint64_t> generationOf(const std::string& fileName, std::string_view prefix, std::string_view suffix) {
+    if (fileName.size() <= prefix.size() + suffix.size() || !fileName.starts_with(prefix) || !fileName.ends_with(suffix)) {
+        return std::nullopt;
+    }
+    const char* first = fileName.data() + prefix.size();
+    const char* last = fileName.data() + fileName.size() - suffix.size();
+    std::uint64_t generation = 0;
+    const auto [end, error] = std::from_chars(first, last, generation);
+    if (error != std::errc() || end != last) {
+        return std::nullopt;
+    }
+    return generation;
+}
+
+// Generations that have a complete snapshot, in increasing order
+std::vector<std::uint64_t> snapshotGenerations(const fs::path& directory) {
+    std::vector<std::uint64_t> generations;
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        if (const auto generation = generationOf(entry.path().filename().string(), "snapshot-", ".menusnap")) {
+            generations.push_back(*generation);
+        }
+    }
+    std::ranges::sort(generations);
+    return generations;
+}
+
+void syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        throw JournalException("Cannot write the menu journal");
+    }
+#ifdef _WIN32
+    const int result = _commit(_fileno(file));
+#else
+    const int result = fsync(fileno(file));
+#endif
+    if (result != 0) {
+        throw JournalException("Cannot sync the menu journal");
+    }
+}
+
+// Makes a file written through another handle (e.g., a snapshot) durable
+void syncPath(const fs::path& path) {
+#ifndef _WIN32
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw JournalException("Cannot open " + path.string() + " to sync it");
+    }
+    const int result = fsync(descriptor);
+    close(descriptor);
+    if (result != 0) {
+        throw JournalException("Cannot sync " + path.string());
+    }
+#else
+    std::FILE* file = _wfopen(path.c_str(), L"r+b");
+    if (file == nullptr) {
+        throw JournalException("Cannot open " + path.string() + " to sync it");
+    }
+    const int result = _commit(_fileno(file));
+    std::fclose(file);
+    if (result != 0) {
+        throw JournalException("Cannot sync " + path.string());
+    }
+#endif
+}
+
+// Writes the snapshot of a generation and makes it durable under its final name
+void publishSnapshot(const Menu& menu, const fs::path& directory, std::uint64_t generation) {
+    const fs::path snapshot = directory / snapshotName(generation);
+    fs::path temporary = snapshot;
+    temporary += ".tmp";
+    MenuSnapshot::write(menu, temporary.string());
+    syncPath(temporary);
+    std::error_code error;
+    fs::rename(temporary, snapshot, error);
+    if (error) {
+        throw JournalException("Cannot publish the menu snapshot " + snapshot.string());
+    }
+#ifndef _WIN32
+    syncPath(directory);  // Makes the rename itself durable
+#endif
+}
+
+// Creates the journal of a generation and writes its header
+std::FILE* openJournal(const fs::path& directory, std::uint64_t generation) {
+    const fs::path path = directory / journalName(generation);
+    std::FILE* file = std::fopen(path.string().c_str(), "wb");
+    if (file == nullptr) {
+        throw JournalException("Cannot create the menu journal " + path.string());
+    }
+    const JournalHeader header{Magic, Version, 0, generation};
+    if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+        std::fclose(file);
+        throw JournalException("Cannot write the menu journal " + path.string());
+    }
+    return file;
+}
+
+// Removes the snapshots and journals of the generations before the given one
+void removeGenerationsBefore(const fs::path& directory, std::uint64_t current) {
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(directory, error)) {
+        const std::string name = entry.path().filename().string();
+        const auto generation = generationOf(name, "snapshot-", ".menusnap").or_else([&] {
+            return generationOf(name, "journal-", ".log");
+        });
+        if (generation && *generation < current) {
+            fs::remove(entry.path(), error);
+        }
+    }
+}
+
+std::string prepareDirectory(std::string directory) {
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (!fs::is_directory(directory, error)) {
+        throw JournalException("Cannot create the journal directory " + directory);
+    }
+    return directory;
+}
+
+class RecordWriter {
+public:
+    explicit RecordWriter(std::vector<std::byte>& out) : out(out) {}
+
+    template <typename T>
+    void put(T value) {
+        const auto* bytes = reinterpret_cast<const std::byte*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    void putString(std::string_view text) {
+        put(static_cast<std::uint32_t>(text.size()));
+        const auto* bytes = reinterpret_cast<const std::byte*>(text.data());
+        out.insert(out.end(), bytes, bytes + text.size());
+    }
+
+    void putDish(const Dish& dish) {
+        putString(dish.getName());
+        put(dish.getPrice().toBani());
+        put(dish.getWeight());
+        const auto& ingredients = dish.getIngredients();
+        put(static_cast<std::uint32_t>(ingredients.size()));
+        for (const auto& ingredient : ingredients) {
+            putString(ingredient.getName());
+            put(static_cast<std::uint8_t>(ingredient.getType()));
+        }
+    }
+
+    void putCategory(const Category& category) {
+        const TimeWindow window = category.getAvailability();
+        putString(category.getName());
+        put(window.start.minutesSinceMidnight());
+        put(window.end.minutesSinceMidnight());
+        put(static_cast<std::uint32_t>(category.getDishes().size()));
+        for (const auto& dish : category.getDishes()) {
+            putDish(dish);
+        }
+    }
+
+private:
+    std::vector<std::byte>& out;
+};
+
+// Thrown by RecordReader when a record ends early; replay stops there
+struct TruncatedRecord {};
+
+class RecordReader {
+public:
+    explicit RecordReader(std::span<const std::byte> bytes) : bytes(bytes) {}
+
+    template <typename T>
+    T get() {
+        need(sizeof(T));
+        T value;
+        std::memcpy(&value, bytes.data() + position, sizeof(T));
+        position += sizeof(T);
+        return value;
+    }
+
+    std::string_view getString() {
+        const auto size = get<std::uint32_t>();
+        need(size);
+        const std::string_view text(reinterpret_cast<const char*>(bytes.data() + position), size);
+        position += size;
+        return text;
+    }
+
+    Dish getDish() {
+        const std::string_view name = getString();
+        const Money price = Money::fromBani(get<std::int64_t>());
+        const auto weight = get<float>();
+        const auto count = get<std::uint32_t>();
+        std::pmr::vector<Ingredient> ingredients;
+        ingredients.reserve(std::min<std::size_t>(count, bytes.size() - position));
+        for (std::uint32_t i = 0; i < count; ++i) {
+            const std::string_view ingredient = getString();
+            const auto type = get<std::uint8_t>();
+            if (type > static_cast<std::uint8_t>(FoodType::CEREAL)) {
+                throw TruncatedRecord{};
+            }
+            ingredients.emplace_back(ingredient, static_cast<FoodType>(type));
+        }
+        return {name, price, weight, std::move(ingredients)};
+    }
+
+    Category getCategory() {
+        const std::string_view name = getString();
+        const auto start = get<std::uint16_t>();
+        const auto end = get<std::uint16_t>();
+        const auto count = get<std::uint32_t>();
+        std::pmr::vector<Dish> dishes;
+        for (std::uint32_t i = 0; i < count; ++i) {
+            dishes.push_back(getDish());
+        }
+        Category category(name, std::move(dishes));
+        category.setAvailability({TimeOfDay::fromMinutes(start), TimeOfDay::fromMinutes(end)});
+        return category;
+    }
+
+    // The slots of one category in a SortedByPositions record
+    std::vector<std::uint32_t> getPositions() {
+        const auto count = get<std::uint32_t>();
+        need(std::size_t{count} * sizeof(std::uint32_t));
+        std::vector<std::uint32_t> positions(count);
+        std::memcpy(positions.data(), bytes.data() + position, positions.size() * sizeof(std::uint32_t));
+        position += positions.size() * sizeof(std::uint32_t);
+        return positions;
+    }
+
+    // The ordering of a SortedByKeys record; keys that do not make a valid ordering end the replay
+    DishOrdering getOrdering() {
+        const auto count = get<std::uint8_t>();
+        std::array<DishSortKey, DishOrdering::MaxKeys> keys{};
+        if (count == 0 || count > keys.size()) {
+            throw TruncatedRecord{};
+        }
+        for (std::uint8_t i = 0; i < count; ++i) {
+            const auto field = get<std::uint8_t>();
+            if (field >= static_cast<std::uint8_t>(DishSortField::Popularity)) {
+                throw TruncatedRecord{};  // A popularity is never replayed from keys
+            }
+            keys[i] = {static_cast<DishSortField>(field), get<std::uint8_t>() != 0};
+        }
+        try {
+            switch (count) {
+                case 1:
+                    return DishOrdering({keys[0]});
+                case 2:
+                    return DishOrdering({keys[0], keys[1]});
+                default:
+                    return DishOrdering({keys[0], keys[1], keys[2]});
+            }
+        } catch (const std::invalid_argument&) {
+            throw TruncatedRecord{};
+        }
+    }
+
+private:
+    void need(std::size_t size) const {
+        if (bytes.size() - position < size) {
+            throw TruncatedRecord{};
+        }
+    }
+
+    std::span<const std::byte> bytes;
+    std::size_t position = 0;
+};
+
+// Applies one record payload to the menu being rebuilt
+void replay(Menu& menu, std::span<const std::byte> payload) {
+    RecordReader reader(payload);
+    switch (static_cast<MenuEventKind>(reader.get<std::uint8_t>())) {
+        case MenuEventKind::CategoryAdded:
+            menu.addCategory(reader.getCategory());
+            break;
+        case MenuEventKind::CategoryRemoved:
+            menu.removeCategory(reader.getString());
+            break;
+        case MenuEventKind::CategoriesSorted: {
+            const auto form = reader.get<std::uint8_t>();
+            if (form == SortedByKeys) {
+                menu.sortCategories(reader.getOrdering());
+                break;
+            }
+            if (form != SortedByPositions) {
+                throw TruncatedRecord{};
+            }
+            const auto count = reader.get<std::uint32_t>();
+            if (count != menu.getCategory().size()) {
+                throw TruncatedRecord{};
+            }
+            std::vector<std::vector<std::uint32_t>> positions(count);
+            for (auto& category : positions) {
+                category = reader.getPositions();
+            }
+            menu.reorderDishes(positions);
+            break;
+        }
+        case MenuEventKind::DishAdded: {
+            const std::string_view category = reader.getString();
+            menu.addDish(category, reader.getDish());
+            break;
+        }
+        case MenuEventKind::DishRemoved: {
+            const std::string_view category = reader.getString();
+            menu.removeDish(category, reader.getString());
+            break;
+        }
+        case MenuEventKind::PriceChanged: {
+            const std::string_view category = reader.getString();
+            const std::string_view dish = reader.getString();
+            menu.updateDishPrice(category, dish, Money::fromBani(reader.get<std::int64_t>()));
+            break;
+        }
+        default:
+            throw TruncatedRecord{};
+    }
+}
+
+} // namespace
+
+MenuJournal::MenuJournal(Menu& menu, std::string directory, const JournalOptions& options)
+    : menu(menu), directory(prepareDirectory(std::move(directory))), options(options), writer([this] { runWriter(); }) {
+    try {
+        // The first generation starts from the current state and replaces any older one
+        const auto generations = snapshotGenerations(this->directory);
+        startGeneration((generations.empty() ? 0 : generations.back()) + 1);
+        commit();
+        removeGenerationsBefore(this->directory, generation());
+    } catch (...) {
+        {
+            const std::scoped_lock lock(mutex);
+            stopping = true;
+        }
+        wakeWriter.notify_one();
+        writer.join();
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+        throw;
+    }
+    menu.attach(this, Delivery::Sync);
+}
+
+MenuJournal::~MenuJournal() {
+    menu.detach(this);
+    {
+        const std::scoped_lock lock(mutex);
+        stopping = true;
+    }
+    wakeWriter.notify_one();
+    writer.join();
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+}
+
+void MenuJournal::update(const MenuEvent& event) {
+    if (event.menuId != menu.getId()) {
+        return;
+    }
+    record.assign(RecordHeaderSize, std::byte{0});
+    encode(event);
+    const auto payloadSize = static_cast<std::uint32_t>(record.size() - RecordHeaderSize);
+    const std::uint32_t sum = checksum(std::span<const std::byte>(record).subspan(RecordHeaderSize));
+    std::memcpy(record.data(), &payloadSize, sizeof(payloadSize));
+    std::memcpy(record.data() + sizeof(payloadSize), &sum, sizeof(sum));
+
+    // Only flagged here: the writer thread compacts once it has written the records before this one
+    const bool compactDue = options.compactAfterBytes != 0 && generationBytes + record.size() >= options.compactAfterBytes;
+    bool wake;
+    {
+        const std::scoped_lock lock(mutex);
+        if (writerError) {
+            return;  // The journal has a gap from the failed write on: a later record would replay wrongly
+        }
+        wake = compactDue || pending.empty() || pending.size() + record.size() >= options.groupCommitBytes;
+        pending.insert(pending.end(), record.begin(), record.end());
+        compactRequested = compactRequested || compactDue;
+    }
+    ++recordCount;
+    generationBytes = compactDue ? sizeof(JournalHeader) : generationBytes + record.size();
+    if (wake) {
+        wakeWriter.notify_one();  // Starts the group commit delay, or cuts it short when the group is full
+    }
+}
+
+// Captures what replay needs: added categories and dishes are read back from the menu in full
+void MenuJournal::encode(const MenuEvent& event) {
+    RecordWriter out(record);
+    out.put(static_cast<std::uint8_t>(event.kind));
+    const std::string_view categoryName =
+        event.category == MenuEvent::NoSymbol ? std::string_view() : SymbolTable::view(event.category);
+    switch (event.kind) {
+        case MenuEventKind::CategoryAdded:
+            out.putCategory(*menu.findCategory(categoryName));
+            break;
+        case MenuEventKind::CategoryRemoved:
+            out.putString(categoryName);
+            break;
+        case MenuEventKind::CategoriesSorted:
+            if (const DishOrdering* ordering = menu.sortingBy(); ordering != nullptr && ordering->dependsOnDishesOnly()) {
+                // Replay sorts the same dishes in the same order again: the keys are enough
+                out.put(SortedByKeys);
+                out.put(static_cast<std::uint8_t>(ordering->sortKeys().size()));
+                for (const DishSortKey key : ordering->sortKeys()) {
+                    out.put(static_cast<std::uint8_t>(key.field));
+                    out.put(static_cast<std::uint8_t>(key.descending));
+                }
+            } else {
+                // The order came from outside the dishes (e.g., popularity): 4 bytes per dish say where each one went
+                out.put(SortedByPositions);
+                out.put(static_cast<std::uint32_t>(menu.getCategory().size()));
+                for (std::size_t slot = 0; slot < menu.getCategory().size(); ++slot) {
+                    const auto keys = menu.sortedKeys(slot);
+                    out.put(static_cast<std::uint32_t>(keys.size()));
+                    for (const auto& key : keys) {
+                        out.put(key.position);
+                    }
+                }
+            }
+            break;
+        case MenuEventKind::DishAdded:
+            out.putString(categoryName);
+            out.putDish(menu.findCategory(categoryName)->getDishes().back());  // addDish appends
+            break;
+        case MenuEventKind::DishRemoved:
+            out.putString(categoryName);
+            out.putString(SymbolTable::view(event.dish));
+            break;
+        case MenuEventKind::PriceChanged:
+            out.putString(categoryName);
+            out.putString(SymbolTable::view(event.dish));
+            out.put(event.newPrice.toBani());
+            break;
+    }
+}
+
+void MenuJournal::commit() {
+    std::unique_lock lock(mutex);
+    const std::uint64_t ticket = ++commitsRequested;
+    wakeWriter.notify_one();
+    written.wait(lock, [&] { return commitsDone >= ticket; });
+    rethrowWriterError();
+}
+
+void MenuJournal::compact() {
+    {
+        const std::scoped_lock lock(mutex);
+        compactRequested = true;
+    }
+    generationBytes = sizeof(JournalHeader);
+    commit();  // Served once the writer has compacted
+}
+
+// Writes the snapshot of the first generation and asks the writer to open its journal
+void MenuJournal::startGeneration(std::uint64_t generation) {
+    publishSnapshot(menu, directory, generation);
+    {
+        const std::scoped_lock lock(mutex);
+        openRequest = generation;
+        currentGeneration = generation;
+    }
+    wakeWriter.notify_one();
+    generationBytes = sizeof(JournalHeader);
+}
+
+// Starts the next generation on the writer thread, without reading the live menu: the
+// state is rebuilt from the current snapshot and the records written to its journal
+void MenuJournal::rotate() {
+    if (std::fflush(file) != 0) {
+        throw JournalException("Cannot write the menu journal");
+    }
+    const std::uint64_t current = generation();
+    const JournalRecovery state = recover(directory);
+    if (state.menu == nullptr || state.generation != current || state.discardedBytes != 0) {
+        throw JournalException("Cannot compact the menu journal: generation " + std::to_string(current) +
+                               " does not replay cleanly");
+    }
+    publishSnapshot(*state.menu, directory, current + 1);
+    std::FILE* next = openJournal(directory, current + 1);
+    try {
+        syncFile(next);
+    } catch (...) {
+        std::fclose(next);
+        throw;
+    }
+    std::fclose(file);
+    file = next;
+    {
+        const std::scoped_lock lock(mutex);
+        currentGeneration = current + 1;
+    }
+    removeGenerationsBefore(directory, current + 1);
+}
+
+void MenuJournal::runWriter() {
+    std::vector<std::byte> writing;
+    std::uint64_t unsyncedWrites = 0;
+    std::unique_lock lock(mutex);
+    while (true) {
+        const auto ready = [&] {
+            return stopping || openRequest != 0 || compactRequested || commitsRequested != commitsDone ||
+                   pending.size() >= options.groupCommitBytes;
+        };
+        if (pending.empty()) {
+            wakeWriter.wait(lock, [&] { return ready() || !pending.empty(); });
+        }
+        if (!pending.empty()) {
+            wakeWriter.wait_for(lock, options.groupCommitDelay, ready);  // Let more changes join the group
+        }
+        if (pending.empty() && openRequest == 0 && !compactRequested && commitsRequested == commitsDone) {
+            if (stopping) {
+                break;
+            }
+            continue;
+        }
+
+        writing.swap(pending);
+        const std::uint64_t open = std::exchange(openRequest, 0);
+        const bool compacting = std::exchange(compactRequested, false);
+        const std::uint64_t ticket = commitsRequested;
+        const bool mustSync = ticket != commitsDone || stopping;
+        const bool failed = writerError != nullptr;
+        lock.unlock();
+
+        std::uint64_t wrote = 0;
+        std::uint64_t synced = 0;
+        // A failure is final: nothing more is written, and commits are answered with the error
+        if (!failed) {
+            try {
+                if (open != 0) {
+                    if (file != nullptr) {
+                        std::fclose(file);
+                        file = nullptr;
+                    }
+                    file = openJournal(directory, open);
+                    ++unsyncedWrites;
+                }
+                if (!writing.empty()) {
+                    if (file == nullptr || std::fwrite(writing.data(), 1, writing.size(), file) != writing.size()) {
+                        throw JournalException("Cannot write the menu journal");
+                    }
+                    ++wrote;
+                    ++unsyncedWrites;
+                }
+                if (unsyncedWrites > 0 && (mustSync || (options.syncEveryWrites != 0 && unsyncedWrites >= options.syncEveryWrites))) {
+                    syncFile(file);
+                    ++synced;
+                    unsyncedWrites = 0;
+                }
+                if (compacting && file != nullptr) {
+                    rotate();  // The records written above are the last of the old generation
+                    unsyncedWrites = 0;
+                }
+            } catch (...) {
+                const std::scoped_lock errorLock(mutex);
+                writerError = std::current_exception();
+            }
+        }
+        writing.clear();
+
+        lock.lock();
+        writeCount += wrote;
+        syncCount += synced;
+        commitsDone = ticket;
+        written.notify_all();
+    }
+}
+
+void MenuJournal::rethrowWriterError() {
+    if (writerError) {
+        std::rethrow_exception(writerError);
+    }
+}
+
+std::uint64_t MenuJournal::generation() const {
+    const std::scoped_lock lock(mutex);
+    return currentGeneration;
+}
+
+std::uint64_t MenuJournal::writes() const {
+    const std::scoped_lock lock(mutex);
+    return writeCount;
+}
+
+std::uint64_t MenuJournal::syncs() const {
+    const std::scoped_lock lock(mutex);
+    return syncCount;
+}
+
+JournalRecovery MenuJournal::recover(const std::string& directory) {
+    JournalRecovery recovery;
+    const auto generations = snapshotGenerations(directory);
+    if (generations.empty()) {
+        return recovery;
+    }
+    recovery.generation = generations.back();
+    recovery.menu = MenuSnapshot::open((fs::path(directory) / snapshotName(recovery.generation)).string()).toMenu();
+
+    // A missing journal means the process stopped right after writing the snapshot: nothing to replay
+    std::ifstream in(fs::path(directory) / journalName(recovery.generation), std::ios::binary);
+    if (!in) {
+        return recovery;
+    }
+    const std::vector<char> text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const std::span<const std::byte> bytes(reinterpret_cast<const std::byte*>(text.data()), text.size());
+
+    JournalHeader header{};
+    if (bytes.size() < sizeof(header)) {
+        recovery.discardedBytes = bytes.size();
+        return recovery;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != Magic || header.version != Version || header.generation != recovery.generation) {
+        recovery.discardedBytes = bytes.size();
+        return recovery;
+    }
+
+    std::size_t position = sizeof(header);
+    while (bytes.size() - position >= RecordHeaderSize) {
+        std::uint32_t size;
+        std::uint32_t sum;
+        std::memcpy(&size, bytes.data() + position, sizeof(size));
+        std::memcpy(&sum, bytes.data() + position + sizeof(size), sizeof(sum));
+        if (bytes.size() - position - RecordHeaderSize < size) {
+            break;  // Torn write at the end of the file
+        }
+        const auto payload = bytes.subspan(position + RecordHeaderSize, size);
+        if (checksum(payload) != sum) {
+            break;
+        }
+        try {
+            replay(*recovery.menu, payload);
+        } catch (const TruncatedRecord&) {
+            break;
+        } catch (const MenuException&) {
+            break;  // The record does not fit the snapshot it follows
+        } catch (const std::invalid_argument&) {
+            break;  // Recorded positions that do not fit the categories
+        }
+        position += RecordHeaderSize + size;
+        ++recovery.records;
+    }
+    recovery.discardedBytes = bytes.size() - position;
+    return recovery;
+}
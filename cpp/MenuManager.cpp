@@ -1,52 +1,80 @@
 #include "../h/MenuManager.h"
 
-// Initialize the static instance to nullptr
 /**
- * @brief Static instance of MenuManager, initialized to nullptr.
+ * @brief The version each thread read last.
  *
- * Used to ensure only one instance of MenuManager exists (Singleton pattern).
+ * Only the owning thread touches its cache, so reads share nothing but the version counter.
  */
-MenuManager* MenuManager::instance = nullptr;
+thread_local MenuManager::ReaderCache MenuManager::readerCache;
 
 /**
- * @brief Constructor for MenuManager.
+ * @brief Returns the unique instance, created on the first call.
  *
- * Initializes the `menu` pointer to the provided Menu object.
- *
- * @param m Pointer to a Menu object. Defaults to nullptr.
+ * A function-local static is initialized exactly once, even when several threads
+ * call getInstance() at the same time.
  */
-MenuManager::MenuManager(Menu* m) : menu(m) {}
+MenuManager& MenuManager::getInstance() {
+    static MenuManager instance;
+    return instance;
+}
 
+/**
+ * @brief Publishes a new menu, or withdraws the current one when `m` is nullptr.
+ */
+void MenuManager::setMenu(std::unique_ptr<Menu> m) {
+    std::lock_guard lock(writers);
+    publish(std::move(m));
+}
 
 /**
- * @brief Displays the menu using the `print()` method of the Menu object.
+ * @brief Loads the published menu with the shared reference count.
+ */
+MenuManager::Snapshot MenuManager::snapshot() const {
+    return published.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Displays the published menu using its `print()` method.
  *
- * This method calls the `print()` method of the `menu` object, which is defined
- * in the Menu base class or its derived classes. If no menu is set, nothing happens.
+ * If no menu is published, nothing happens.
  */
 void MenuManager::displayMenu() const {
-    if (menu) {
+    if (const Snapshot menu = snapshot()) {
         menu->print();
     }
 }
 
 /**
- * @brief Sorts the menu categories using the `sortCategories()` method.
+ * @brief Publishes a copy of the menu whose categories are sorted.
  *
- * This method calls the `sortCategories()` method of the `menu` object, which sorts
- * the categories of the menu. If no menu is set, nothing happens.
+ * If no menu is published, nothing happens.
  */
-void MenuManager::sortCategories() const {
-    if (menu) {
-        menu->sortCategories();
+void MenuManager::sortCategories() {
+    std::lock_guard lock(writers);
+    const Snapshot current = published.load(std::memory_order_acquire);
+    if (!current) {
+        return;
     }
+    std::unique_ptr<Menu> sorted = current->clone();
+    sorted->sortCategories();
+    publish(std::move(sorted));
 }
 
 /**
- * @brief Destructor for MenuManager.
+ * @brief Loads the latest version into a thread's cache.
  *
- * Deletes the managed `menu` object to free resources. If no menu is set, no action is taken.
+ * The version is read before the menu: if a writer publishes in between, the cache
+ * holds a newer menu under an older version and simply refreshes again next time.
+ */
+void MenuManager::refresh(ReaderCache& cache) const {
+    cache.version = publishedVersion.load(std::memory_order_acquire);
+    cache.menu = published.load(std::memory_order_acquire);
+}
+
+/**
+ * @brief Replaces the published menu, then announces the new version; the caller holds `writers`.
  */
-MenuManager::~MenuManager() {
-    delete menu;
+void MenuManager::publish(std::unique_ptr<Menu> m) {
+    published.store(Snapshot(std::move(m)), std::memory_order_release);
+    publishedVersion.fetch_add(1, std::memory_order_release);
 }
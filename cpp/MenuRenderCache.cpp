@@ -0,0 +1,79 @@
+#include "../h/MenuRenderCache.h"
+#include <iostream>
+
+MenuRenderCache::MenuRenderCache(Menu& menu) : menu(menu) {
+    menu.attach(this, Delivery::Sync);
+}
+
+MenuRenderCache::~MenuRenderCache() {
+    menu.detach(this);
+}
+
+void MenuRenderCache::invalidate(std::string_view category) {
+    if (const auto cached = segments.find(category); cached != segments.end()) {
+        cached->second.valid.fill(false);
+    }
+}
+
+void MenuRenderCache::update(const MenuEvent& event) {
+    if (event.menuId != menu.getId()) {
+        return;  // A copy of the menu kept this observer
+    }
+    switch (event.kind) {
+        case MenuEventKind::CategoryAdded:
+            break;  // Rendered on first use
+        case MenuEventKind::CategoryRemoved:
+            if (const auto cached = segments.find(SymbolTable::view(event.category)); cached != segments.end()) {
+                segments.erase(cached);
+            }
+            break;
+        case MenuEventKind::DishAdded:
+        case MenuEventKind::DishRemoved:
+        case MenuEventKind::PriceChanged:
+            invalidate(SymbolTable::view(event.category));
+            break;
+        case MenuEventKind::CategoriesSorted:
+            for (auto& [name, cached] : segments) {
+                cached.valid.fill(false);  // The dishes of every category were sorted too
+            }
+            break;
+    }
+}
+
+void MenuRenderCache::render(RenderFormat format, MenuRenderer& renderer) {
+    const auto slot = static_cast<std::size_t>(format);
+    if (format == RenderFormat::Listing) {
+        menu.renderTitle(renderer);
+    } else {
+        renderer.text("Menu:\n");
+    }
+    for (const auto& category : menu.getCategory()) {
+        auto cached = segments.find(category.getName());
+        if (cached == segments.end()) {
+            cached = segments.emplace(std::string(category.getName()), Segments{}).first;
+        }
+        Segments& segment = cached->second;
+        if (segment.valid[slot]) {
+            ++hitCount;
+            renderer.text(segment.text[slot]);
+            continue;
+        }
+        // Rendered in place, then the new text is copied into the cache
+        ++missCount;
+        const std::size_t start = renderer.view().size();
+        if (format == RenderFormat::Listing) {
+            renderer.categoryListing(category);
+        } else {
+            renderer.category(category);
+            renderer.character('\n');
+        }
+        segment.text[slot].assign(renderer.view().substr(start));
+        segment.valid[slot] = true;
+    }
+}
+
+void MenuRenderCache::display() {
+    MenuRenderer& renderer = MenuRenderer::local();
+    render(RenderFormat::Listing, renderer);
+    renderer.flushTo(std::cout);
+}
@@ -0,0 +1,146 @@
+#include "../h/MenuRenderer.h"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <charconv>
+#include <ostream>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+void FdSink::write(std::string_view text) {
+    while (!text.empty()) {
+#ifdef _WIN32
+        const int chunk = static_cast<int>(std::min<std::size_t>(text.size(), 1U << 30));
+        const auto written = _write(descriptor, text.data(), static_cast<unsigned>(chunk));
+#else
+        const auto written = ::write(descriptor, text.data(), text.size());
+#endif
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::system_error(errno, std::generic_category(), "Cannot write the rendered menu");
+        }
+        text.remove_prefix(static_cast<std::size_t>(written));
+    }
+}
+
+void StreamSink::write(std::string_view text) {
+    os.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+void MemorySink::write(std::string_view text) {
+    const std::size_t fits = std::min(text.size(), memory.size() - used);
+    std::copy_n(text.data(), fits, memory.data() + used);
+    used += fits;
+    dropped = dropped || fits < text.size();
+}
+
+MenuRenderer::MenuRenderer(std::size_t capacity) {
+    buffer.reserve(capacity);
+}
+
+MenuRenderer& MenuRenderer::local() {
+    thread_local MenuRenderer renderer;
+    return renderer;
+}
+
+MenuRenderer& MenuRenderer::text(std::string_view value) {
+    buffer += value;
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::character(char value) {
+    buffer += value;
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::number(std::int64_t value) {
+    std::array<char, 20> digits{};
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+    buffer.append(digits.data(), end);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::real(float value) {
+    std::array<char, 32> digits{};
+    const auto end = std::to_chars(digits.data(), digits.data() + digits.size(), value).ptr;
+    buffer.append(digits.data(), end);
+    return *this;
+}
+
+MenuRenderer& MenuRenderer::money(Money value) {
+    std::array<char, Money::MaxChars> digits{};
+    buffer.append(digits.data(), value.toChars(digits.data()));
+    return *this;
+}
+
+void MenuRenderer::menu(const Menu& menu) {
+    text("Menu:\n");
+    for (const auto& category : menu.getCategory()) {
+        this->category(category);
+        character('\n');
+    }
+}
+
+void MenuRenderer::menuListing(const Menu& menu) {
+    menu.renderTitle(*this);
+    for (const auto& category : menu.getCategory()) {
+        categoryListing(category);
+    }
+}
+
+void MenuRenderer::category(const Category& category) {
+    text("Category: ").text(category.getName()).character('\n');
+    for (const auto& dish : category.getDishes()) {
+        this->dish(dish);
+        character('\n');
+    }
+}
+
+void MenuRenderer::categoryListing(const Category& category) {
+    text("Category: ").text(category.getName()).character('\n');
+    for (const auto& dish : category.getDishes()) {
+        dishLine(dish);
+        character('\n');
+    }
+}
+
+void MenuRenderer::dish(const Dish& dish) {
+    text("Dish: ").text(dish.getName()).text(" - Price: ").money(dish.getPrice()).text(" RON\nIngredients: \n");
+    for (const auto& ingredient : dish.getIngredients()) {
+        text("  - ").text(ingredient.getName()).character('\n');
+    }
+}
+
+void MenuRenderer::dishLine(const Dish& dish) {
+    text(dish.getName()).text(": ").money(dish.getPrice()).text(" RON");
+}
+
+void MenuRenderer::clear() {
+    buffer.clear();
+    if (buffer.capacity() > MaxRetainedCapacity) {
+        buffer.shrink_to_fit();
+        buffer.reserve(DefaultCapacity);
+    }
+}
+
+void MenuRenderer::flushTo(RenderSink& sink) {
+    try {
+        sink.write(buffer);
+    } catch (...) {
+        clear();
+        throw;
+    }
+    clear();
+}
+
+void MenuRenderer::flushTo(std::ostream& os) {
+    StreamSink sink(os);
+    flushTo(sink);
+}
@@ -0,0 +1,334 @@
+#include "../h/MenuSearchIndex.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+
+constexpr float MinFuzzyDice = 0.4f;        // Below this, a word shares too few trigrams with the query word
+constexpr float IngredientWeight = 0.5f;    // An ingredient match ranks below the same match on a dish name
+
+bool isWordChar(char c) {
+    const auto byte = static_cast<unsigned char>(c);
+    return byte >= 0x80 || std::isalnum(byte);  // Bytes of UTF-8 letters count as letters
+}
+
+// The trigrams of a folded text, padded so the first letters form trigrams too, sorted and unique
+std::vector<std::uint32_t> trigramsOf(std::string_view text) {
+    std::string padded = "  ";
+    padded += text;
+    padded += ' ';
+    std::vector<std::uint32_t> result;
+    result.reserve(padded.size());
+    for (std::size_t i = 0; i + 3 <= padded.size(); ++i) {
+        result.push_back(static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i])) << 16
+                         | static_cast<std::uint32_t>(static_cast<unsigned char>(padded[i + 1])) << 8
+                         | static_cast<unsigned char>(padded[i + 2]));
+    }
+    std::ranges::sort(result);
+    const auto [first, last] = std::ranges::unique(result);
+    result.erase(first, last);
+    return result;
+}
+
+template <typename T>
+void eraseOne(std::vector<T>& values, const T& value) {
+    const auto it = std::ranges::find(values, value);
+    if (it != values.end()) {
+        *it = values.back();
+        values.pop_back();
+    }
+}
+
+} // namespace
+
+std::string MenuSearchIndex::fold(std::string_view text) {
+    std::string folded;
+    folded.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        const auto byte = static_cast<unsigned char>(text[i]);
+        if (byte < 0x80) {
+            folded += static_cast<char>(std::tolower(byte));
+            continue;
+        }
+        const auto next = i + 1 < text.size() ? static_cast<unsigned char>(text[i + 1]) : 0u;
+        char plain = 0;
+        switch (byte << 8 | next) {
+            case 0xC483: case 0xC482:               // ă Ă
+            case 0xC3A2: case 0xC382:               // â Â
+                plain = 'a';
+                break;
+            case 0xC3AE: case 0xC38E:               // î Î
+                plain = 'i';
+                break;
+            case 0xC899: case 0xC898:               // ș Ș
+            case 0xC59F: case 0xC59E:               // ş Ş
+                plain = 's';
+                break;
+            case 0xC89B: case 0xC89A:               // ț Ț
+            case 0xC5A3: case 0xC5A2:               // ţ Ţ
+                plain = 't';
+                break;
+            default:
+                break;
+        }
+        if (plain != 0) {
+            folded += plain;
+            ++i;
+        } else {
+            folded += text[i];  // Other characters are kept byte for byte
+        }
+    }
+    return folded;
+}
+
+MenuSearchIndex::MenuSearchIndex(Menu& menu) : menu(menu) {
+    for (const auto& category : menu.getCategory()) {
+        addCategory(category);
+    }
+    std::ranges::sort(wordStarts, {}, [this](const WordStart& start) { return wordStartText(start); });
+    bulkLoading = false;
+    menu.attach(this, Delivery::Sync);
+}
+
+MenuSearchIndex::~MenuSearchIndex() {
+    menu.detach(this);
+}
+
+std::string_view MenuSearchIndex::wordStartText(const WordStart& start) const {
+    return std::string_view(terms[start.term].text).substr(start.offset);
+}
+
+std::uint32_t MenuSearchIndex::termFor(Symbol name) {
+    if (const auto cached = symbolTerms.find(name); cached != symbolTerms.end()) {
+        return cached->second;
+    }
+    std::string folded = fold(SymbolTable::view(name));
+    const auto [slot, inserted] = termIndex.try_emplace(folded, static_cast<std::uint32_t>(terms.size()));
+    const std::uint32_t term = slot->second;
+    symbolTerms.emplace(name, term);
+    if (!inserted) {
+        return term;  // Another spelling of a known name, e.g., without diacritics
+    }
+    terms.push_back({.text = std::move(folded), .dishes = {}, .ingredientOf = {}});
+    addWords(term);
+    return term;
+}
+
+// Indexes the word starts of a new term for prefixes, and its words for typos
+void MenuSearchIndex::addWords(std::uint32_t term) {
+    const std::string& text = terms[term].text;
+    for (std::size_t offset = 0; offset < text.size() && offset <= UINT16_MAX; ++offset) {
+        if (!isWordChar(text[offset]) || (offset > 0 && isWordChar(text[offset - 1]))) {
+            continue;
+        }
+        const WordStart start{term, static_cast<std::uint16_t>(offset)};
+        if (bulkLoading) {
+            wordStarts.push_back(start);
+        } else {
+            const auto position = std::ranges::upper_bound(wordStarts, wordStartText(start), {},
+                                                           [this](const WordStart& other) { return wordStartText(other); });
+            wordStarts.insert(position, start);
+        }
+
+        std::size_t length = 0;
+        while (offset + length < text.size() && isWordChar(text[offset + length])) {
+            ++length;
+        }
+        const auto [slot, inserted] = wordIndex.try_emplace(text.substr(offset, length), static_cast<std::uint32_t>(words.size()));
+        if (inserted) {
+            const std::vector<std::uint32_t> wordTrigrams = trigramsOf(slot->first);
+            words.push_back({.trigramCount = static_cast<std::uint16_t>(wordTrigrams.size()), .terms = {}});
+            for (const std::uint32_t trigram : wordTrigrams) {
+                trigrams[trigram].push_back(slot->second);
+            }
+        }
+        auto& wordTerms = words[slot->second].terms;
+        if (wordTerms.empty() || wordTerms.back() != term) {
+            wordTerms.push_back(term);  // A word repeated inside a name is listed once
+        }
+    }
+}
+
+void MenuSearchIndex::addDish(Symbol category, const Dish& dish) {
+    IndexedDish indexed{.dish = dish.getSymbol(), .nameTerm = termFor(dish.getSymbol()), .ingredientTerms = {}};
+    terms[indexed.nameTerm].dishes.push_back({category, dish.getSymbol()});
+    indexed.ingredientTerms.reserve(dish.getIngredients().size());
+    for (const auto& ingredient : dish.getIngredients()) {
+        const std::uint32_t term = termFor(ingredient.getSymbol());
+        terms[term].ingredientOf.push_back({category, dish.getSymbol()});
+        indexed.ingredientTerms.push_back(term);
+    }
+    categories[category].push_back(std::move(indexed));
+}
+
+void MenuSearchIndex::removeDish(Symbol category, Symbol dish) {
+    auto& indexed = categories[category];
+    const auto it = std::ranges::find(indexed, dish, &IndexedDish::dish);
+    if (it == indexed.end()) {
+        return;
+    }
+    const Posting posting{category, dish};
+    eraseOne(terms[it->nameTerm].dishes, posting);
+    for (const std::uint32_t term : it->ingredientTerms) {
+        eraseOne(terms[term].ingredientOf, posting);
+    }
+    indexed.erase(it);
+}
+
+void MenuSearchIndex::addCategory(const Category& category) {
+    const Symbol name = SymbolTable::intern(category.getName());
+    for (const auto& dish : category.getDishes()) {
+        addDish(name, dish);
+    }
+}
+
+void MenuSearchIndex::removeCategory(Symbol category) {
+    const auto indexed = categories.find(category);
+    if (indexed == categories.end()) {
+        return;
+    }
+    while (!indexed->second.empty()) {
+        removeDish(category, indexed->second.back().dish);
+    }
+    categories.erase(indexed);
+}
+
+void MenuSearchIndex::update(const MenuEvent& event) {
+    if (event.menuId != menu.getId()) {
+        return;  // A copy of the menu kept this observer
+    }
+    switch (event.kind) {
+        case MenuEventKind::CategoryAdded:
+            addCategory(*menu.findCategory(SymbolTable::view(event.category)));
+            break;
+        case MenuEventKind::CategoryRemoved:
+            removeCategory(event.category);
+            break;
+        case MenuEventKind::DishAdded:
+            addDish(event.category, menu.findCategory(SymbolTable::view(event.category))->getDishes().back());  // addDish appends
+            break;
+        case MenuEventKind::DishRemoved:
+            removeDish(event.category, event.dish);
+            break;
+        case MenuEventKind::CategoriesSorted:
+        case MenuEventKind::PriceChanged:
+            break;  // Names and ingredients are unchanged
+    }
+}
+
+void MenuSearchIndex::findCandidates(std::string_view folded, std::vector<Candidate>& candidates) const {
+    // Prefixes: the word starts beginning with the query are contiguous in the sorted array
+    auto start = std::ranges::lower_bound(wordStarts, folded, {}, [this](const WordStart& other) { return wordStartText(other); });
+    for (; start != wordStarts.end() && wordStartText(*start).starts_with(folded); ++start) {
+        const std::size_t length = terms[start->term].text.size();
+        const float coverage = static_cast<float>(folded.size()) / static_cast<float>(length);
+        if (start->offset != 0) {
+            candidates.push_back({start->term, SearchMatch::WordPrefix, 0.5f + 0.15f * coverage});
+        } else if (length == folded.size()) {
+            candidates.push_back({start->term, SearchMatch::Exact, 1.0f});
+        } else {
+            candidates.push_back({start->term, SearchMatch::Prefix, 0.75f + 0.15f * coverage});
+        }
+    }
+
+    // Typos: each query word is matched with the indexed words sharing most of its trigrams;
+    // a term scores the average of the best match of every query word, below every prefix match
+    std::vector<std::string_view> queryWords;
+    for (std::size_t offset = 0; offset < folded.size();) {
+        const std::size_t end = std::min(folded.find(' ', offset), folded.size());
+        if (end > offset) {
+            queryWords.push_back(folded.substr(offset, end - offset));
+        }
+        offset = end + 1;
+    }
+    bestDice.resize(terms.size());
+    fuzzyScore.resize(terms.size());
+    sharedTrigrams.resize(words.size());
+    for (const std::string_view queryWord : queryWords) {
+        if (queryWord.size() < 3) {
+            continue;  // Too short to have trigrams of its own
+        }
+        const std::vector<std::uint32_t> queryTrigrams = trigramsOf(queryWord);
+        for (const std::uint32_t trigram : queryTrigrams) {
+            const auto postings = trigrams.find(trigram);
+            if (postings == trigrams.end()) {
+                continue;
+            }
+            for (const std::uint32_t word : postings->second) {
+                if (sharedTrigrams[word]++ == 0) {
+                    touchedWords.push_back(word);
+                }
+            }
+        }
+        for (const std::uint32_t word : touchedWords) {
+            const float dice = 2.0f * static_cast<float>(sharedTrigrams[word])
+                               / static_cast<float>(queryTrigrams.size() + words[word].trigramCount);
+            sharedTrigrams[word] = 0;
+            if (dice < MinFuzzyDice) {
+                continue;
+            }
+            for (const std::uint32_t term : words[word].terms) {
+                if (fuzzyScore[term] == 0.0f && bestDice[term] == 0.0f) {
+                    touchedTerms.push_back(term);
+                }
+                bestDice[term] = std::max(bestDice[term], dice);
+            }
+        }
+        touchedWords.clear();
+        for (const std::uint32_t term : touchedTerms) {
+            fuzzyScore[term] += bestDice[term];
+            bestDice[term] = 0.0f;
+        }
+    }
+    for (const std::uint32_t term : touchedTerms) {
+        candidates.push_back({term, SearchMatch::Fuzzy, 0.45f * fuzzyScore[term] / static_cast<float>(queryWords.size())});
+        fuzzyScore[term] = 0.0f;
+    }
+    touchedTerms.clear();
+}
+
+std::vector<SearchHit> MenuSearchIndex::search(std::string_view query, std::size_t limit) const {
+    std::string folded = fold(query);
+    const auto first = folded.find_first_not_of(' ');
+    if (first == std::string::npos || limit == 0) {
+        return {};
+    }
+    folded = folded.substr(first, folded.find_last_not_of(' ') - first + 1);
+
+    std::vector<Candidate> candidates;
+    findCandidates(folded, candidates);
+    // One candidate per term, its best match; then the best terms first, shorter names first on a tie
+    std::ranges::sort(candidates, [](const Candidate& a, const Candidate& b) {
+        return a.term != b.term ? a.term < b.term : a.score > b.score;
+    });
+    const auto [duplicates, end] = std::ranges::unique(candidates, {}, &Candidate::term);
+    candidates.erase(duplicates, end);
+    std::ranges::sort(candidates, [this](const Candidate& a, const Candidate& b) {
+        return a.score != b.score ? a.score > b.score : terms[a.term].text.size() < terms[b.term].text.size();
+    });
+
+    std::vector<SearchHit> hits;
+    const auto addHits = [&](const std::vector<Posting>& postings, SearchMatch match, float score) {
+        for (const auto& posting : postings) {
+            if (hits.size() == limit) {
+                return;
+            }
+            const Category* category = menu.findCategory(SymbolTable::view(posting.category));
+            const Dish* dish = category == nullptr ? nullptr : category->findDish(posting.dish);
+            if (dish != nullptr && std::ranges::find(hits, dish, &SearchHit::dish) == hits.end()) {
+                hits.push_back({category, dish, match, score});
+            }
+        }
+    };
+    for (const auto& candidate : candidates) {
+        addHits(terms[candidate.term].dishes, candidate.match, candidate.score);
+    }
+    for (const auto& candidate : candidates) {
+        addHits(terms[candidate.term].ingredientOf, SearchMatch::Ingredient, IngredientWeight * candidate.score);
+    }
+    return hits;
+}
+
+std::size_t MenuSearchIndex::termCount() const {
+    return terms.size();
+}
@@ -0,0 +1,462 @@
+#include "../h/MenuSnapshot.h"
+#include "../h/Breakfast.h"
+#include "../h/Dinner.h"
+#include "../h/Lunch.h"
+#include "../h/PriceTotals.h"
+#include "../h/SnapshotException.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::array<char, 8> Magic = {'M', 'E', 'N', 'U', 'S', 'N', 'A', 'P'};
+constexpr std::size_t AvailabilityWords = (TimeOfDay::MinutesPerDay + 63) / 64;
+
+// Sections of the file, in the order they are written
+enum Section : std::uint32_t {
+    Categories,
+    DishNames,
+    DishPrices,
+    DishWeights,
+    IngredientBegin,
+    DishFlags,
+    IngredientNames,
+    IngredientTypes,
+    StringOffsets,
+    StringData,
+    Availability,
+    SectionCount,
+};
+
+struct SectionEntry {
+    std::uint64_t offset;
+    std::uint64_t size;
+};
+
+// Fixed-size header at the start of every snapshot
+struct FileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t kind;
+    std::uint32_t categoryCount;
+    std::uint32_t dishCount;
+    std::uint32_t ingredientCount;
+    std::uint32_t stringCount;
+    std::array<SectionEntry, SectionCount> sections;
+};
+
+// Rounds an offset up so that every section starts 8-byte aligned
+constexpr std::uint64_t align(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t{7};
+}
+
+void requireLittleEndian() {
+    if constexpr (std::endian::native != std::endian::little) {
+        throw SnapshotException("Menu snapshots are only supported on little-endian platforms");
+    }
+}
+
+// Deduplicated string table; the views used as keys must outlive the builder
+class StringTableBuilder {
+public:
+    std::uint32_t add(std::string_view text) {
+        const auto [it, inserted] = index.try_emplace(text, static_cast<std::uint32_t>(offsets.size() - 1));
+        if (inserted) {
+            characters.append(text);
+            if (characters.size() > std::numeric_limits<std::uint32_t>::max()) {
+                throw SnapshotException("Menu snapshot string table exceeds 4 GiB");
+            }
+            offsets.push_back(static_cast<std::uint32_t>(characters.size()));
+        }
+        return it->second;
+    }
+
+    std::vector<std::uint32_t> offsets{0};
+    std::string characters;
+
+private:
+    std::unordered_map<std::string_view, std::uint32_t> index;
+};
+
+// Narrows a count to the 32-bit fields of the format
+std::uint32_t checkedCount(std::size_t count, const char* what) {
+    if (count > std::numeric_limits<std::uint32_t>::max() - 1) {
+        throw SnapshotException(std::string("Too many ") + what + " for a menu snapshot");
+    }
+    return static_cast<std::uint32_t>(count);
+}
+
+} // namespace
+
+// Flattens the menu into columns and writes header and sections in one pass
+void MenuSnapshot::write(const Menu& menu, const std::string& path) {
+    requireLittleEndian();
+
+    FileHeader header{};
+    header.magic = Magic;
+    header.version = Version;
+    if (dynamic_cast<const Breakfast*>(&menu) != nullptr) {
+        header.kind = static_cast<std::uint32_t>(MenuKind::Breakfast);
+    } else if (dynamic_cast<const Lunch*>(&menu) != nullptr) {
+        header.kind = static_cast<std::uint32_t>(MenuKind::Lunch);
+    } else if (dynamic_cast<const Dinner*>(&menu) != nullptr) {
+        header.kind = static_cast<std::uint32_t>(MenuKind::Dinner);
+    } else {
+        throw SnapshotException("Only Breakfast, Lunch and Dinner menus can be written to a snapshot");
+    }
+
+    const auto& menuCategories = menu.getCategory();
+    StringTableBuilder strings;
+    std::vector<CategoryRecord> categoryRecords;
+    std::vector<std::uint32_t> names;
+    std::vector<Money> prices;
+    std::vector<float> weights;
+    std::vector<std::uint32_t> ingredientBegin;
+    std::vector<FoodMask> flags;
+    std::vector<std::uint32_t> ingredientNames;
+    std::vector<std::uint8_t> ingredientTypes;
+
+    categoryRecords.reserve(menuCategories.size());
+    for (const auto& category : menuCategories) {
+        const auto& dishes = category.getDishes();
+        const TimeWindow window = category.getAvailability();
+        categoryRecords.push_back({strings.add(category.getName()), checkedCount(names.size(), "dishes"),
+                                   checkedCount(dishes.size(), "dishes"), window.start.minutesSinceMidnight(),
+                                   window.end.minutesSinceMidnight(), category.getFoodMask(), {}});
+        for (const auto& dish : dishes) {
+            names.push_back(strings.add(dish.getName()));
+            prices.push_back(dish.getPrice());
+            weights.push_back(dish.getWeight());
+            ingredientBegin.push_back(checkedCount(ingredientNames.size(), "ingredients"));
+            flags.push_back(dish.getFoodMask());
+            for (const auto& ingredient : dish.getIngredients()) {
+                ingredientNames.push_back(strings.add(ingredient.getName()));
+                ingredientTypes.push_back(static_cast<std::uint8_t>(ingredient.getType()));
+            }
+        }
+    }
+    ingredientBegin.push_back(checkedCount(ingredientNames.size(), "ingredients"));
+
+    std::array<std::uint64_t, AvailabilityWords> availability{};
+    for (std::uint16_t minute = 0; minute < TimeOfDay::MinutesPerDay; ++minute) {
+        if (menu.isAvailableAt(TimeOfDay::fromMinutes(minute))) {
+            availability[minute / 64] |= std::uint64_t{1} << (minute % 64);
+        }
+    }
+
+    header.categoryCount = checkedCount(categoryRecords.size(), "categories");
+    header.dishCount = checkedCount(names.size(), "dishes");
+    header.ingredientCount = checkedCount(ingredientNames.size(), "ingredients");
+    header.stringCount = checkedCount(strings.offsets.size() - 1, "strings");
+
+    // Section payloads in file order
+    const std::array<std::pair<const void*, std::uint64_t>, SectionCount> payloads = {{
+        {categoryRecords.data(), categoryRecords.size() * sizeof(CategoryRecord)},
+        {names.data(), names.size() * sizeof(std::uint32_t)},
+        {prices.data(), prices.size() * sizeof(Money)},
+        {weights.data(), weights.size() * sizeof(float)},
+        {ingredientBegin.data(), ingredientBegin.size() * sizeof(std::uint32_t)},
+        {flags.data(), flags.size() * sizeof(FoodMask)},
+        {ingredientNames.data(), ingredientNames.size() * sizeof(std::uint32_t)},
+        {ingredientTypes.data(), ingredientTypes.size()},
+        {strings.offsets.data(), strings.offsets.size() * sizeof(std::uint32_t)},
+        {strings.characters.data(), strings.characters.size()},
+        {availability.data(), availability.size() * sizeof(std::uint64_t)},
+    }};
+    std::uint64_t offset = align(sizeof(FileHeader));
+    for (std::size_t section = 0; section < SectionCount; ++section) {
+        header.sections[section] = {offset, payloads[section].second};
+        offset = align(offset + payloads[section].second);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw SnapshotException("Cannot create menu snapshot " + path);
+    }
+    static constexpr char zeros[8] = {};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    std::uint64_t written = sizeof(header);
+    for (std::size_t section = 0; section < SectionCount; ++section) {
+        out.write(zeros, static_cast<std::streamsize>(header.sections[section].offset - written));
+        out.write(static_cast<const char*>(payloads[section].first), static_cast<std::streamsize>(payloads[section].second));
+        written = header.sections[section].offset + payloads[section].second;
+    }
+    out.write(zeros, static_cast<std::streamsize>(offset - written));
+    if (!out.flush()) {
+        throw SnapshotException("Cannot write menu snapshot " + path);
+    }
+}
+
+// Maps the file read-only (or reads it where mmap is unavailable), then validates it
+MenuSnapshot MenuSnapshot::open(const std::string& path) {
+    requireLittleEndian();
+    MenuSnapshot snapshot;
+#ifdef _WIN32
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw SnapshotException("Cannot open menu snapshot " + path);
+    }
+    snapshot.size = static_cast<std::size_t>(in.tellg());
+    snapshot.buffer.resize((snapshot.size + 7) / 8);
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(snapshot.buffer.data()), static_cast<std::streamsize>(snapshot.size))) {
+        throw SnapshotException("Cannot read menu snapshot " + path);
+    }
+    snapshot.data = reinterpret_cast<const std::byte*>(snapshot.buffer.data());
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw SnapshotException("Cannot open menu snapshot " + path);
+    }
+    struct stat status {};
+    if (::fstat(fd, &status) != 0 || status.st_size < static_cast<off_t>(sizeof(FileHeader))) {
+        ::close(fd);
+        throw SnapshotException("Menu snapshot " + path + " is truncated");
+    }
+    snapshot.size = static_cast<std::size_t>(status.st_size);
+    void* address = ::mmap(nullptr, snapshot.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw SnapshotException("Cannot map menu snapshot " + path);
+    }
+    snapshot.data = static_cast<const std::byte*>(address);
+    snapshot.mapped = true;
+#endif
+    snapshot.load();
+    return snapshot;
+}
+
+// Checks the header and every section, then points the column spans into the file.
+// The checks are linear in the file size but only compare integers, so a 1M-dish
+// snapshot loads in a few milliseconds; afterwards no accessor needs bounds checks.
+void MenuSnapshot::load() {
+    if (size < sizeof(FileHeader)) {
+        throw SnapshotException("Menu snapshot is truncated");
+    }
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != Magic) {
+        throw SnapshotException("File is not a menu snapshot");
+    }
+    if (header.version != Version) {
+        throw SnapshotException("Unsupported menu snapshot version " + std::to_string(header.version));
+    }
+    if (header.kind > static_cast<std::uint32_t>(MenuKind::Dinner)) {
+        throw SnapshotException("Unknown menu type in snapshot");
+    }
+    menuKind = static_cast<MenuKind>(header.kind);
+
+    const auto section = [&]<typename T>(Section id, std::uint64_t count, const T*) {
+        const SectionEntry entry = header.sections[id];
+        if (entry.offset % alignof(T) != 0 || entry.offset > size || entry.size > size - entry.offset ||
+            entry.size != count * sizeof(T)) {
+            throw SnapshotException("Menu snapshot section " + std::to_string(id) + " is corrupt");
+        }
+        return std::span<const T>(reinterpret_cast<const T*>(data + entry.offset), count);
+    };
+    const std::uint64_t dishes = header.dishCount;
+    const std::uint64_t ingredients = header.ingredientCount;
+    const std::uint64_t strings = header.stringCount;
+    categories = section(Categories, header.categoryCount, static_cast<const CategoryRecord*>(nullptr));
+    dishNames = section(DishNames, dishes, static_cast<const std::uint32_t*>(nullptr));
+    dishPrices = section(DishPrices, dishes, static_cast<const Money*>(nullptr));
+    dishWeights = section(DishWeights, dishes, static_cast<const float*>(nullptr));
+    ingredientBegin = section(IngredientBegin, dishes + 1, static_cast<const std::uint32_t*>(nullptr));
+    dishFlags = section(DishFlags, dishes, static_cast<const FoodMask*>(nullptr));
+    ingredientNames = section(IngredientNames, ingredients, static_cast<const std::uint32_t*>(nullptr));
+    ingredientTypes = section(IngredientTypes, ingredients, static_cast<const std::uint8_t*>(nullptr));
+    stringOffsets = section(StringOffsets, strings + 1, static_cast<const std::uint32_t*>(nullptr));
+    stringData = section(StringData, header.sections[StringData].size, static_cast<const char*>(nullptr));
+    availability = section(Availability, AvailabilityWords, static_cast<const std::uint64_t*>(nullptr));
+
+    const auto corrupt = [] { return SnapshotException("Menu snapshot is inconsistent"); };
+    if (stringOffsets.front() != 0 || stringOffsets.back() != stringData.size() ||
+        !std::is_sorted(stringOffsets.begin(), stringOffsets.end())) {
+        throw corrupt();
+    }
+    if (ingredientBegin.front() != 0 || ingredientBegin.back() != ingredients ||
+        !std::is_sorted(ingredientBegin.begin(), ingredientBegin.end())) {
+        throw corrupt();
+    }
+    const auto validName = [strings](std::uint32_t name) { return name < strings; };
+    if (!std::all_of(dishNames.begin(), dishNames.end(), validName) ||
+        !std::all_of(ingredientNames.begin(), ingredientNames.end(), validName) ||
+        !std::all_of(ingredientTypes.begin(), ingredientTypes.end(), [](std::uint8_t type) { return type <= static_cast<std::uint8_t>(FoodType::CEREAL); })) {
+        throw corrupt();
+    }
+    for (const auto& record : categories) {
+        if (!validName(record.name) || std::uint64_t{record.firstDish} + record.dishCount > dishes ||
+            record.windowStart >= TimeOfDay::MinutesPerDay || record.windowEnd >= TimeOfDay::MinutesPerDay) {
+            throw corrupt();
+        }
+    }
+}
+
+void MenuSnapshot::release() {
+#ifndef _WIN32
+    if (mapped) {
+        ::munmap(const_cast<std::byte*>(data), size);
+    }
+#endif
+    data = nullptr;
+    size = 0;
+    mapped = false;
+    buffer.clear();
+}
+
+// The spans point into the mapping or into buffer's heap block, both of which move along
+MenuSnapshot::MenuSnapshot(MenuSnapshot&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), size(std::exchange(other.size, 0)),
+      mapped(std::exchange(other.mapped, false)), buffer(std::move(other.buffer)), menuKind(other.menuKind),
+      categories(other.categories), dishNames(other.dishNames), dishPrices(other.dishPrices),
+      dishWeights(other.dishWeights), ingredientBegin(other.ingredientBegin), dishFlags(other.dishFlags),
+      ingredientNames(other.ingredientNames), ingredientTypes(other.ingredientTypes),
+      stringOffsets(other.stringOffsets), stringData(other.stringData), availability(other.availability) {}
+
+MenuSnapshot& MenuSnapshot::operator=(MenuSnapshot&& other) noexcept {
+    if (this != &other) {
+        release();
+        data = std::exchange(other.data, nullptr);
+        size = std::exchange(other.size, 0);
+        mapped = std::exchange(other.mapped, false);
+        buffer = std::move(other.buffer);
+        menuKind = other.menuKind;
+        categories = other.categories;
+        dishNames = other.dishNames;
+        dishPrices = other.dishPrices;
+        dishWeights = other.dishWeights;
+        ingredientBegin = other.ingredientBegin;
+        dishFlags = other.dishFlags;
+        ingredientNames = other.ingredientNames;
+        ingredientTypes = other.ingredientTypes;
+        stringOffsets = other.stringOffsets;
+        stringData = other.stringData;
+        availability = other.availability;
+    }
+    return *this;
+}
+
+MenuSnapshot::~MenuSnapshot() {
+    release();
+}
+
+std::string_view MenuSnapshot::string(std::uint32_t index) const {
+    return {stringData.data() + stringOffsets[index], stringOffsets[index + 1] - stringOffsets[index]};
+}
+
+bool MenuSnapshot::isAvailableAt(TimeOfDay time) const {
+    const std::uint16_t minute = time.minutesSinceMidnight();
+    return (availability[minute / 64] >> (minute % 64)) & 1;
+}
+
+std::unique_ptr<Menu> MenuSnapshot::toMenu() const {
+    std::pmr::vector<Category> rebuilt;
+    rebuilt.reserve(categoryCount());
+    for (std::uint32_t i = 0; i < categoryCount(); ++i) {
+        rebuilt.push_back(category(i).toCategory());
+    }
+    switch (menuKind) {
+        case MenuKind::Breakfast:
+            return std::make_unique<Breakfast>(std::move(rebuilt));
+        case MenuKind::Dinner:
+            return std::make_unique<Dinner>(std::move(rebuilt));
+        case MenuKind::Lunch:
+        default:
+            return std::make_unique<Lunch>(std::move(rebuilt));
+    }
+}
+
+std::string_view SnapshotDishView::getName() const {
+    return snapshot->string(snapshot->dishNames[id]);
+}
+
+Money SnapshotDishView::getPrice() const {
+    return snapshot->dishPrices[id];
+}
+
+float SnapshotDishView::getWeight() const {
+    return snapshot->dishWeights[id];
+}
+
+FoodMask SnapshotDishView::getFoodMask() const {
+    return snapshot->dishFlags[id];
+}
+
+bool SnapshotDishView::isVegetarian() const {
+    return DietaryFilter::vegetarian().matches(getFoodMask());
+}
+
+std::uint32_t SnapshotDishView::ingredientCount() const {
+    return snapshot->ingredientBegin[id + 1] - snapshot->ingredientBegin[id];
+}
+
+std::string_view SnapshotDishView::ingredientName(std::uint32_t i) const {
+    return snapshot->string(snapshot->ingredientNames[snapshot->ingredientBegin[id] + i]);
+}
+
+FoodType SnapshotDishView::ingredientType(std::uint32_t i) const {
+    return static_cast<FoodType>(snapshot->ingredientTypes[snapshot->ingredientBegin[id] + i]);
+}
+
+Dish SnapshotDishView::toDish() const {
+    std::pmr::vector<Ingredient> ingredients;
+    ingredients.reserve(ingredientCount());
+    for (std::uint32_t i = 0; i < ingredientCount(); ++i) {
+        ingredients.emplace_back(ingredientName(i), ingredientType(i));
+    }
+    return {getName(), getPrice(), getWeight(), std::move(ingredients)};
+}
+
+std::string_view SnapshotCategoryView::getName() const {
+    return snapshot->string(snapshot->categories[index].name);
+}
+
+std::uint32_t SnapshotCategoryView::size() const {
+    return snapshot->categories[index].dishCount;
+}
+
+SnapshotDishView SnapshotCategoryView::dish(std::uint32_t i) const {
+    return {*snapshot, snapshot->categories[index].firstDish + i};
+}
+
+TimeWindow SnapshotCategoryView::getAvailability() const {
+    const auto& record = snapshot->categories[index];
+    return {TimeOfDay::fromMinutes(record.windowStart), TimeOfDay::fromMinutes(record.windowEnd)};
+}
+
+bool SnapshotCategoryView::isAvailableAt(TimeOfDay time) const {
+    return getAvailability().contains(time);
+}
+
+FoodMask SnapshotCategoryView::getFoodMask() const {
+    return snapshot->categories[index].foodMask;
+}
+
+Money SnapshotCategoryView::totalPrice() const {
+    const auto& record = snapshot->categories[index];
+    return PriceTotals::sum(snapshot->dishPrices.subspan(record.firstDish, record.dishCount));
+}
+
+Category SnapshotCategoryView::toCategory() const {
+    std::pmr::vector<Dish> dishes;
+    dishes.reserve(size());
+    for (std::uint32_t i = 0; i < size(); ++i) {
+        dishes.push_back(dish(i).toDish());
+    }
+    Category category(getName(), std::move(dishes));
+    category.setAvailability(getAvailability());
+    return category;
+}
@@ -0,0 +1,249 @@
+#include "../h/MenuVersionStore.h"
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace {
+
+// The entry of a time-sorted history that was current at `time`, or nullptr if the history starts later
+template <typename Version>
+const Version* versionAt(const std::vector<Version>& history, MenuVersionStore::Timestamp time) {
+    const auto next = std::ranges::upper_bound(history, time, {}, &Version::from);
+    return next == history.begin() ? nullptr : &*std::prev(next);
+}
+
+} // namespace
+
+MenuVersionStore::MenuVersionStore(Menu& menu) : menu(menu), created(Clock::now()), last(created) {
+    for (const auto& category : menu.getCategory()) {
+        recordCategory(category, created);
+    }
+    menu.attach(this, Delivery::Sync);
+}
+
+MenuVersionStore::~MenuVersionStore() {
+    menu.detach(this);
+}
+
+MenuVersionStore::Timestamp MenuVersionStore::stamp() {
+    last = std::max(Clock::now(), last);
+    return last;
+}
+
+MenuVersionStore::CategoryHistory& MenuVersionStore::categoryHistory(Symbol name) {
+    const auto [slot, inserted] = categoryIndex.try_emplace(name, categories.size());
+    if (inserted) {
+        categories.push_back({.name = name, .presence = {}, .dishes = {}, .orders = {}, .current = {}, .byName = {}});
+    }
+    return categories[slot->second];
+}
+
+// Starts the history of a dish appended to the category
+void MenuVersionStore::addDish(CategoryHistory& category, const Dish& dish, Timestamp time) {
+    const auto id = static_cast<std::uint32_t>(category.dishes.size());
+    category.dishes.push_back({.name = dish.getSymbol(), .versions = {{time, std::make_shared<const Dish>(dish)}}});
+    category.byName[dish.getSymbol()].push_back(id);
+    category.current.push_back(id);
+    ++dishCount;
+}
+
+// The dishes the store follows are removed, and the category's dishes start new histories
+void MenuVersionStore::restartDishes(CategoryHistory& history, const Category& category, Timestamp time) {
+    for (const std::uint32_t id : history.current) {
+        history.dishes[id].versions.push_back({time, nullptr});
+    }
+    history.current.clear();
+    for (const auto& dish : category.getDishes()) {
+        addDish(history, dish, time);
+    }
+}
+
+// A category added (again): the dishes it had are removed, and its dishes start new histories
+void MenuVersionStore::recordCategory(const Category& category, Timestamp time) {
+    CategoryHistory& history = categoryHistory(SymbolTable::intern(category.getName()));
+    history.presence.push_back({time, true});
+    restartDishes(history, category, time);
+}
+
+// After a sort, moves each history to the slot its dish went to and records the new order
+// @param sorted The menu's sorted keys of the category: the dish now at slot i came from slot sorted[i].position
+void MenuVersionStore::recordOrder(CategoryHistory& history, const Category& category,
+                                   std::span<const DishOrdering::Key> sorted, Timestamp time) {
+    const bool fits = sorted.size() == history.current.size() && sorted.size() == category.getDishes().size() &&
+                      std::ranges::all_of(sorted, [&](const DishOrdering::Key& key) { return key.position < sorted.size(); });
+    if (!fits) {
+        // Not the dishes the store follows: their histories end here rather than go on in the wrong dish
+        restartDishes(history, category, time);
+        return;
+    }
+    std::vector<std::uint32_t> order(sorted.size());
+    for (std::size_t slot = 0; slot < sorted.size(); ++slot) {
+        order[slot] = history.current[sorted[slot].position];
+    }
+    history.current = order;
+    history.orders.push_back({.from = time, .dishes = std::move(order),
+                              .firstLater = static_cast<std::uint32_t>(history.dishes.size())});
+}
+
+// Tells whether the store follows the dish at a slot of the category under the event's name
+bool MenuVersionStore::follows(const CategoryHistory& history, const Category& category, const MenuEvent& event) {
+    return event.dishIndex < history.current.size() && event.dishIndex < category.getDishes().size() &&
+           history.dishes[history.current[event.dishIndex]].name == event.dish;
+}
+
+void MenuVersionStore::update(const MenuEvent& event) {
+    if (event.menuId != menu.getId()) {
+        return;  // A copy of the menu kept this observer
+    }
+    const std::unique_lock lock(mutex);
+    const Timestamp time = stamp();
+    if (event.kind == MenuEventKind::CategoriesSorted) {
+        const auto categories = menu.getCategory();
+        for (std::size_t slot = 0; slot < categories.size(); ++slot) {
+            recordOrder(categoryHistory(SymbolTable::intern(categories[slot].getName())), categories[slot],
+                        menu.sortedKeys(slot), time);
+        }
+        ++changeCount;
+        return;
+    }
+    if (event.kind == MenuEventKind::CategoryRemoved) {
+        // Only a category the store knows can be removed; an unknown one gets no history
+        if (const auto slot = categoryIndex.find(event.category); slot != categoryIndex.end()) {
+            categories[slot->second].presence.push_back({time, false});
+            ++changeCount;
+        }
+        return;
+    }
+    const Category* category = menu.findCategory(SymbolTable::view(event.category));
+    if (category == nullptr) {
+        return;  // Never happens with synchronous delivery: the menu is exactly as the event left it
+    }
+    CategoryHistory& history = categoryHistory(event.category);
+    switch (event.kind) {
+        case MenuEventKind::CategoryAdded:
+            recordCategory(*category, time);
+            break;
+        case MenuEventKind::CategoryRemoved:
+            break;
+        case MenuEventKind::DishAdded:
+            if (event.dishIndex == history.current.size() && event.dishIndex < category->getDishes().size()) {
+                addDish(history, category->getDishes()[event.dishIndex], time);
+            } else {
+                restartDishes(history, *category, time);
+            }
+            break;
+        case MenuEventKind::PriceChanged:
+            if (!follows(history, *category, event)) {
+                restartDishes(history, *category, time);
+                break;
+            }
+            // Only the changed dish is copied; every other dish stays shared with the older versions
+            history.dishes[history.current[event.dishIndex]].versions.push_back(
+                {time, std::make_shared<const Dish>(category->getDishes()[event.dishIndex])});
+            ++dishCount;
+            break;
+        case MenuEventKind::DishRemoved:
+            if (event.dishIndex >= history.current.size() ||
+                history.dishes[history.current[event.dishIndex]].name != event.dish) {
+                restartDishes(history, *category, time);
+                break;
+            }
+            history.dishes[history.current[event.dishIndex]].versions.push_back({time, nullptr});
+            history.current.erase(history.current.begin() + event.dishIndex);
+            break;
+        case MenuEventKind::CategoriesSorted:
+            break;
+    }
+    ++changeCount;
+}
+
+// Visits the dish histories of a category in the menu's order at a point in time, removed ones included
+template <typename Visit>
+void MenuVersionStore::forEachInOrder(const CategoryHistory& category, Timestamp time, Visit visit) {
+    const DishOrder* order = versionAt(category.orders, time);
+    std::uint32_t later = 0;
+    if (order != nullptr) {
+        for (const std::uint32_t id : order->dishes) {
+            visit(category.dishes[id]);
+        }
+        later = order->firstLater;
+    }
+    for (std::uint32_t id = later; id < category.dishes.size(); ++id) {
+        visit(category.dishes[id]);
+    }
+}
+
+std::vector<CategoryVersion> MenuVersionStore::asOf(Timestamp time) const {
+    const std::shared_lock lock(mutex);
+    std::vector<CategoryVersion> result;
+    for (const auto& category : categories) {
+        const Presence* presence = versionAt(category.presence, time);
+        if (presence == nullptr || !presence->present) {
+            continue;
+        }
+        CategoryVersion& version = result.emplace_back();
+        version.name = SymbolTable::view(category.name);
+        forEachInOrder(category, time, [&](const DishHistory& dish) {
+            const DishVersion* dishVersion = versionAt(dish.versions, time);
+            if (dishVersion != nullptr && dishVersion->dish) {
+                version.dishes.push_back(dishVersion->dish);
+            }
+        });
+    }
+    return result;
+}
+
+std::shared_ptr<const Dish> MenuVersionStore::dishAsOf(std::string_view categoryName, std::string_view dishName,
+                                                       Timestamp time) const {
+    const std::optional<Symbol> dish = SymbolTable::find(dishName);
+    const std::shared_lock lock(mutex);
+    const CategoryHistory* category = findCategory(categoryName);
+    if (category == nullptr || !dish) {
+        return nullptr;
+    }
+    const Presence* presence = versionAt(category->presence, time);
+    const auto named = category->byName.find(*dish);
+    if (presence == nullptr || !presence->present || named == category->byName.end()) {
+        return nullptr;
+    }
+    // Usually one dish has the name; if several had it then, the first in that time's order is the one
+    std::shared_ptr<const Dish> found;
+    std::size_t matches = 0;
+    for (const std::uint32_t id : named->second) {
+        const DishVersion* version = versionAt(category->dishes[id].versions, time);
+        if (version != nullptr && version->dish) {
+            found = version->dish;
+            ++matches;
+        }
+    }
+    if (matches > 1) {
+        found = nullptr;
+        forEachInOrder(*category, time, [&](const DishHistory& history) {
+            const DishVersion* version = versionAt(history.versions, time);
+            if (!found && history.name == *dish && version != nullptr && version->dish) {
+                found = version->dish;
+            }
+        });
+    }
+    return found;
+}
+
+const MenuVersionStore::CategoryHistory* MenuVersionStore::findCategory(std::string_view name) const {
+    const std::optional<Symbol> symbol = SymbolTable::find(name);
+    if (!symbol) {
+        return nullptr;
+    }
+    const auto slot = categoryIndex.find(*symbol);
+    return slot == categoryIndex.end() ? nullptr : &categories[slot->second];
+}
+
+std::uint64_t MenuVersionStore::changes() const {
+    const std::shared_lock lock(mutex);
+    return changeCount;
+}
+
+std::size_t MenuVersionStore::storedDishes() const {
+    const std::shared_lock lock(mutex);
+    return dishCount;
+}
@@ -0,0 +1,37 @@
+#include "../h/Money.h"
+#include <array>
+#include <charconv>
+
+// Writes the amount as RON, omitting the bani when they are zero
+// @param first: The output, with room for MaxChars characters
+// @return: One past the last character written (e.g., after "20", "12.50", "-3.05")
+char* Money::toChars(char* first) const {
+    const bool negative = bani < 0;
+    const std::uint64_t magnitude = negative ? 0 - static_cast<std::uint64_t>(bani) : static_cast<std::uint64_t>(bani);
+    if (negative) {
+        *first++ = '-';
+    }
+    first = std::to_chars(first, first + MaxChars, magnitude / 100).ptr;
+    if (const auto fraction = magnitude % 100; fraction != 0) {
+        *first++ = '.';
+        *first++ = static_cast<char>('0' + fraction / 10);
+        *first++ = static_cast<char>('0' + fraction % 10);
+    }
+    return first;
+}
+
+// Formats the amount as RON, omitting the bani when they are zero
+// @return: The formatted amount (e.g., "20", "12.50", "-3.05")
+std::string Money::toString() const {
+    std::array<char, MaxChars> text{};
+    return std::string(text.data(), toChars(text.data()));
+}
+
+// Output stream operator overload for Money
+// @param os: The output stream to print to
+// @param money: The amount to print
+// @return: The output stream after printing the amount
+std::ostream& operator<<(std::ostream& os, const Money& money) {
+    os << money.toString();
+    return os;
+}
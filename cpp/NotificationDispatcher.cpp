@@ -0,0 +1,130 @@
+#include "../h/NotificationDispatcher.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+NotificationDispatcher::NotificationDispatcher(const DispatchOptions& options)
+    : options(options), queue(options.capacity), worker([this] { run(); }) {}
+
+NotificationDispatcher::~NotificationDispatcher() {
+    stopping.store(true);
+    wake();
+    worker.join();
+}
+
+bool NotificationDispatcher::post(Observer& observer, const MenuEvent& event) {
+    Notification notification{&observer, event};
+    const bool onWorker = std::this_thread::get_id() == worker.get_id();
+    // Once a post from the dispatcher thread is held back, later ones queue up behind it
+    bool queued = !(onWorker && !overflow.empty()) && queue.tryPush(notification);
+    while (!queued) {
+        if (options.backpressure == BackpressurePolicy::DropNewest) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (onWorker) {
+            // An observer changed a subject from the dispatcher thread: waiting would never end,
+            // so the notification is held until the queue ahead of it has been delivered
+            overflow.push_back(notification);
+            posted.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+        wake();
+        std::this_thread::yield();
+        queued = queue.tryPush(notification);
+    }
+    posted.fetch_add(1, std::memory_order_release);
+    // Pairs with the fence in run(): either the dispatcher sees the notification or we see it sleeping
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_relaxed)) {
+        wake();
+    }
+    return true;
+}
+
+void NotificationDispatcher::flush() {
+    const std::uint64_t target = posted.load(std::memory_order_acquire);
+    std::uint64_t done = processed.load(std::memory_order_acquire);
+    while (done < target) {
+        processed.wait(done, std::memory_order_acquire);
+        done = processed.load(std::memory_order_acquire);
+    }
+}
+
+void NotificationDispatcher::wake() {
+    sleeping.store(false);
+    sleeping.notify_one();
+}
+
+void NotificationDispatcher::run() {
+    std::vector<Notification> batch(std::max<std::size_t>(options.maxBatch, 1));
+    // The batch regrouped per observer, in posting order; rebuilt for every batch, so it
+    // only holds observers of the batch. The event vectors are reused through spares
+    std::vector<std::pair<Observer*, std::vector<MenuEvent>>> groups;
+    std::vector<std::vector<MenuEvent>> spares;
+    std::vector<Notification> late;  // The held-back posts delivered with this batch
+
+    while (true) {
+        std::size_t taken = 0;
+        while (taken < batch.size() && queue.tryPop(batch[taken])) {
+            ++taken;
+        }
+        // Posts held back by post() go after everything queued before them: only once the
+        // queue has run dry. Posts made while they are delivered are held for the next batch
+        late.clear();
+        if (taken < batch.size()) {
+            late.swap(overflow);
+        }
+        if (taken == 0 && late.empty()) {
+            if (stopping.load()) {
+                return;  // Everything posted before the destructor ran has been delivered
+            }
+            sleeping.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (queue.empty() && !stopping.load()) {
+                sleeping.wait(true);
+            }
+            sleeping.store(false, std::memory_order_relaxed);
+            continue;
+        }
+
+        for (auto& group : groups) {
+            group.second.clear();
+            spares.push_back(std::move(group.second));
+        }
+        groups.clear();
+        std::uint64_t coalesced = 0;
+        const auto regroup = [&](const Notification& notification) {
+            auto group = std::ranges::find(groups, notification.observer, &std::pair<Observer*, std::vector<MenuEvent>>::first);
+            if (group == groups.end()) {
+                std::vector<MenuEvent> events;
+                if (!spares.empty()) {
+                    events = std::move(spares.back());
+                    spares.pop_back();
+                }
+                group = groups.insert(groups.end(), {notification.observer, std::move(events)});
+            }
+            auto& events = group->second;
+            if (options.coalesce == CoalescePolicy::DropRepeats && !events.empty() && events.back() == notification.event) {
+                ++coalesced;
+                return;
+            }
+            events.push_back(notification.event);
+        };
+        std::ranges::for_each(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(taken), regroup);
+        std::ranges::for_each(late, regroup);
+
+        for (auto& [observer, events] : groups) {
+            try {
+                observer->updateBatch(events);
+            } catch (...) {
+                failureCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            deliveredCount.fetch_add(events.size(), std::memory_order_relaxed);
+        }
+        coalescedCount.fetch_add(coalesced, std::memory_order_relaxed);
+        batchCount.fetch_add(1, std::memory_order_relaxed);
+        processed.fetch_add(taken + late.size(), std::memory_order_release);
+        processed.notify_all();
+    }
+}
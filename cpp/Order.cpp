@@ -0,0 +1,36 @@
+#include "../h/Order.h"
+
+const char* toString(KitchenStation station) {
+    switch (station) {
+        case KitchenStation::Grill: return "Grill";
+        case KitchenStation::Oven: return "Oven";
+        case KitchenStation::Pastry: return "Pastry";
+        case KitchenStation::Cold: return "Cold";
+    }
+    return "Unknown";
+}
+
+const char* toString(OrderStatus status) {
+    switch (status) {
+        case OrderStatus::Received: return "Received";
+        case OrderStatus::Validated: return "Validated";
+        case OrderStatus::Priced: return "Priced";
+        case OrderStatus::Routed: return "Routed";
+        case OrderStatus::Completed: return "Completed";
+        case OrderStatus::Rejected: return "Rejected";
+    }
+    return "Unknown";
+}
+
+std::ostream& operator<<(std::ostream& os, const Order& order) {
+    os << "Order #" << order.id << " (" << toString(order.status) << ")";
+    if (order.status == OrderStatus::Rejected) {
+        return os << ": " << order.rejection << "\n";
+    }
+    os << "\n";
+    for (const auto& line : order.lines) {
+        os << "  " << line.quantity << " x " << line.dishName << " @ " << line.unitPrice << " RON -> "
+           << toString(line.station) << "\n";
+    }
+    return os << "  Total: " << order.total << " RON\n";
+}
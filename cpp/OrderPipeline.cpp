@@ -0,0 +1,239 @@
+#include "../h/OrderPipeline.h"
+#include <algorithm>
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace {
+
+// Meat goes to the grill before anything else: a pizza with ham is cooked by the grill cook
+KitchenStation stationFor(const Dish& dish) {
+    const FoodMask mask = dish.getFoodMask();
+    if (mask & toFoodMask(FoodType::MEAT)) {
+        return KitchenStation::Grill;
+    }
+    if (mask & toFoodMask(FoodType::DESSERT)) {
+        return KitchenStation::Pastry;
+    }
+    if (mask & toFoodMask(FoodType::CEREAL)) {
+        return KitchenStation::Oven;
+    }
+    return KitchenStation::Cold;
+}
+
+std::chrono::nanoseconds percentile(const std::vector<std::chrono::nanoseconds>& sorted, double fraction) {
+    const auto rank = static_cast<std::size_t>(fraction * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[rank];
+}
+
+} // namespace
+
+OrderPipeline::OrderPipeline(MenuManager& menus, ThreadPool& pool, PipelineOptions options)
+    : menus(menus), pool(pool), options(std::move(options)) {}
+
+OrderPipeline::~OrderPipeline() {
+    drain();
+}
+
+void OrderPipeline::submit(Order order) {
+    auto job = std::make_shared<InFlight>();
+    job->order = std::move(order);
+    job->order.status = OrderStatus::Received;
+    job->order.received = Order::Clock::now();
+    {
+        const std::scoped_lock lock(inFlightMutex);
+        ++inFlight;
+    }
+    pool.submit([this, job = std::move(job)] { runStage(job, &OrderPipeline::validate); });
+}
+
+void OrderPipeline::drain() {
+    std::unique_lock lock(inFlightMutex);
+    allFinished.wait(lock, [this] { return inFlight == 0; });
+}
+
+void OrderPipeline::validate(Job job) {
+    job->menu = menus.snapshot();  // The order keeps this version until it is finished
+    if (!job->menu) {
+        reject(std::move(job), "No menu is published");
+        return;
+    }
+    Order& order = job->order;
+    if (order.lines.empty()) {
+        reject(std::move(job), "The order is empty");
+        return;
+    }
+    job->dishes.reserve(order.lines.size());
+    for (const auto& line : order.lines) {
+        const Dish* dish = job->menu->findDish(line.categoryName, line.dishName);
+        if (dish == nullptr || line.quantity == 0) {
+            std::string reason = dish == nullptr ? "Unknown dish: " : "Invalid quantity for ";
+            reason += line.dishName;
+            reject(std::move(job), std::move(reason));
+            return;
+        }
+        job->dishes.push_back(dish);
+    }
+    if (options.stock != nullptr) {
+        for (std::size_t i = 0; i < order.lines.size(); ++i) {
+            if (!options.stock->reserve(*job->dishes[i], order.lines[i].quantity)) {
+                std::string reason = "Out of stock: ";
+                reason += order.lines[i].dishName;
+                while (i-- > 0) {
+                    options.stock->release(*job->dishes[i], order.lines[i].quantity);  // All lines or none
+                }
+                reject(std::move(job), std::move(reason));
+                return;
+            }
+        }
+        job->reserved = true;
+    }
+    order.status = OrderStatus::Validated;
+    pool.submit([this, job = std::move(job)] { runStage(job, &OrderPipeline::price); });
+}
+
+void OrderPipeline::price(Job job) {
+    Order& order = job->order;
+    std::vector<Money> linePrices;
+    linePrices.reserve(order.lines.size());
+    for (std::size_t i = 0; i < order.lines.size(); ++i) {
+        OrderLine& line = order.lines[i];
+        line.unitPrice = job->dishes[i]->getPrice();
+        linePrices.push_back(line.unitPrice * line.quantity);
+    }
+    order.total = Menu::calculateTotalPrice(std::span<const Money>(linePrices));
+    order.status = OrderStatus::Priced;
+    pool.submit([this, job = std::move(job)] { runStage(job, &OrderPipeline::route); });
+}
+
+void OrderPipeline::route(Job job) {
+    Order& order = job->order;
+    unsigned stations = 0;
+    for (std::size_t i = 0; i < order.lines.size(); ++i) {
+        order.lines[i].station = stationFor(*job->dishes[i]);
+        auto& lines = job->stationLines[static_cast<std::size_t>(order.lines[i].station)];
+        stations += lines.empty() ? 1 : 0;
+        lines.push_back(i);
+    }
+    order.status = OrderStatus::Routed;
+    job->stationsLeft.store(stations, std::memory_order_relaxed);
+    unsigned submitted = 0;
+    for (std::size_t station = 0; station < KitchenStationCount; ++station) {
+        if (job->stationLines[station].empty()) {
+            continue;
+        }
+        try {
+            pool.submit([this, job, station] { prepare(job, static_cast<KitchenStation>(station)); });
+        } catch (...) {
+            // The stations already submitted may be running: the last one to finish rejects the order
+            fail(job, "The kitchen stations could not be scheduled");
+            stationsDone(job, stations - submitted);
+            return;
+        }
+        ++submitted;
+    }
+}
+
+void OrderPipeline::prepare(const Job& job, KitchenStation station) {
+    if (options.prepare) {
+        try {
+            for (const std::size_t line : job->stationLines[static_cast<std::size_t>(station)]) {
+                options.prepare(station, job->order.lines[line]);
+            }
+        } catch (const std::exception& error) {
+            fail(job, error.what());
+        } catch (...) {
+            fail(job, "A kitchen station failed");
+        }
+    }
+    stationsDone(job, 1);
+}
+
+// Runs one stage of an order; a stage that throws rejects the order instead of leaving it in flight
+void OrderPipeline::runStage(const Job& job, void (OrderPipeline::*stage)(Job)) {
+    try {
+        (this->*stage)(job);
+    } catch (const std::exception& error) {
+        reject(job, error.what());
+    } catch (...) {
+        reject(job, "The order could not be processed");
+    }
+}
+
+// Records why a station of an order failed; the first reason is kept
+void OrderPipeline::fail(const Job& job, std::string reason) {
+    if (!job->failed.exchange(true, std::memory_order_relaxed)) {
+        job->failure = std::move(reason);  // Read by the last station, after its acq_rel stationsLeft update
+    }
+}
+
+// Counts stations of an order as done. The last one to finish completes the order, or rejects
+// it if a station failed; acq_rel makes the other stations' work visible to it
+void OrderPipeline::stationsDone(const Job& job, unsigned count) {
+    if (job->stationsLeft.fetch_sub(count, std::memory_order_acq_rel) != count) {
+        return;
+    }
+    if (job->failed.load(std::memory_order_relaxed)) {
+        reject(job, std::move(job->failure));
+        return;
+    }
+    job->order.status = OrderStatus::Completed;
+    finish(job);
+}
+
+void OrderPipeline::reject(Job job, std::string reason) {
+    if (job->reserved) {
+        // The order will not be cooked: its ingredients go back to the stock
+        for (std::size_t i = 0; i < job->dishes.size(); ++i) {
+            options.stock->release(*job->dishes[i], job->order.lines[i].quantity);
+        }
+        job->reserved = false;
+    }
+    job->order.status = OrderStatus::Rejected;
+    job->order.rejection = std::move(reason);
+    finish(std::move(job));
+}
+
+void OrderPipeline::finish(Job job) {
+    if (job->finished.exchange(true, std::memory_order_relaxed)) {
+        return;  // Each order is counted once
+    }
+    Order& order = job->order;
+    order.completed = Order::Clock::now();
+    job->menu.reset();  // The menu version may be reclaimed once no order uses it
+    job->dishes.clear();
+    // Nothing may escape before the order leaves the in-flight count, and nothing may run after:
+    // the hook's exception is only counted, as an unwinding task would touch a destroyed pipeline
+    try {
+        if (order.status == OrderStatus::Completed) {
+            completedCount.fetch_add(1, std::memory_order_relaxed);
+            const std::scoped_lock lock(latencyMutex);
+            latencies.push_back(order.completed - order.received);
+        } else {
+            rejectedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (options.onFinished) {
+            options.onFinished(order);
+        }
+    } catch (...) {
+        hookFailureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    // Notified under the lock: once drain() returns, this task no longer touches the pipeline
+    const std::scoped_lock lock(inFlightMutex);
+    if (--inFlight == 0) {
+        allFinished.notify_all();
+    }
+}
+
+LatencySummary OrderPipeline::latency() const {
+    std::vector<std::chrono::nanoseconds> sorted;
+    {
+        const std::scoped_lock lock(latencyMutex);
+        sorted = latencies;
+    }
+    if (sorted.empty()) {
+        return {};
+    }
+    std::ranges::sort(sorted);
+    return {.count = sorted.size(), .p50 = percentile(sorted, 0.50), .p99 = percentile(sorted, 0.99), .max = sorted.back()};
+}
@@ -0,0 +1,123 @@
+#include "../h/PriceTotals.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PRICE_TOTALS_HAS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+#ifdef PRICE_TOTALS_HAS_AVX2
+
+// Four independent accumulators of four lanes each hide the latency of the additions
+__attribute__((target("avx2")))
+Money sumAvx2(std::span<const Money> prices) {
+    const auto* data = reinterpret_cast<const __m256i*>(prices.data());
+    const std::size_t vectors = prices.size() / 4;
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+    __m256i acc2 = _mm256_setzero_si256();
+    __m256i acc3 = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 4 <= vectors; i += 4) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(data + i));
+        acc1 = _mm256_add_epi64(acc1, _mm256_loadu_si256(data + i + 1));
+        acc2 = _mm256_add_epi64(acc2, _mm256_loadu_si256(data + i + 2));
+        acc3 = _mm256_add_epi64(acc3, _mm256_loadu_si256(data + i + 3));
+    }
+    for (; i < vectors; ++i) {
+        acc0 = _mm256_add_epi64(acc0, _mm256_loadu_si256(data + i));
+    }
+
+    const __m256i acc = _mm256_add_epi64(_mm256_add_epi64(acc0, acc1), _mm256_add_epi64(acc2, acc3));
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    std::int64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (std::size_t j = vectors * 4; j < prices.size(); ++j) {
+        total += prices[j].toBani();
+    }
+    return Money::fromBani(total);
+}
+
+// Gathers four prices per step using 32-bit row ids
+__attribute__((target("avx2")))
+Money sumSelectedAvx2(std::span<const Money> prices, std::span<const std::uint32_t> ids) {
+    const auto* base = reinterpret_cast<const long long*>(prices.data());
+    const std::size_t vectors = ids.size() / 4;
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+
+    std::size_t i = 0;
+    for (; i + 2 <= vectors; i += 2) {
+        const __m128i index0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids.data() + i * 4));
+        const __m128i index1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids.data() + i * 4 + 4));
+        acc0 = _mm256_add_epi64(acc0, _mm256_i32gather_epi64(base, index0, 8));
+        acc1 = _mm256_add_epi64(acc1, _mm256_i32gather_epi64(base, index1, 8));
+    }
+    for (; i < vectors; ++i) {
+        const __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids.data() + i * 4));
+        acc0 = _mm256_add_epi64(acc0, _mm256_i32gather_epi64(base, index, 8));
+    }
+
+    alignas(32) std::int64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(acc0, acc1));
+    std::int64_t total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    for (std::size_t j = vectors * 4; j < ids.size(); ++j) {
+        total += prices[ids[j]].toBani();
+    }
+    return Money::fromBani(total);
+}
+
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+#endif // PRICE_TOTALS_HAS_AVX2
+
+} // namespace
+
+Money PriceTotals::sumScalar(std::span<const Money> prices) {
+    std::int64_t total = 0;
+    for (const Money price : prices) {
+        total += price.toBani();
+    }
+    return Money::fromBani(total);
+}
+
+Money PriceTotals::sumSelectedScalar(std::span<const Money> prices, std::span<const std::uint32_t> ids) {
+    std::int64_t total = 0;
+    for (const std::uint32_t id : ids) {
+        total += prices[id].toBani();
+    }
+    return Money::fromBani(total);
+}
+
+Money PriceTotals::sum(std::span<const Money> prices) {
+#ifdef PRICE_TOTALS_HAS_AVX2
+    if (cpuHasAvx2()) {
+        return sumAvx2(prices);
+    }
+#endif
+    return sumScalar(prices);
+}
+
+Money PriceTotals::sumSelected(std::span<const Money> prices, std::span<const std::uint32_t> ids) {
+#ifdef PRICE_TOTALS_HAS_AVX2
+    // The gather takes signed 32-bit indices, so very large columns use the scalar kernel
+    if (cpuHasAvx2() && prices.size() <= 0x7fffffffu) {
+        return sumSelectedAvx2(prices, ids);
+    }
+#endif
+    return sumSelectedScalar(prices, ids);
+}
+
+const char* PriceTotals::activeKernel() {
+#ifdef PRICE_TOTALS_HAS_AVX2
+    if (cpuHasAvx2()) {
+        return "avx2";
+    }
+#endif
+    return "scalar";
+}
@@ -0,0 +1,219 @@
+#include "../h/SymbolTable.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+// Location of one interned string inside the text blocks
+struct Entry {
+    const char* data;
+    std::uint32_t length;
+};
+
+constexpr std::size_t EntryBlockBits = 12;
+constexpr std::size_t EntriesPerBlock = std::size_t{1} << EntryBlockBits;
+constexpr std::size_t MaxEntryBlocks = std::size_t{1} << 14;  // ~67M distinct strings
+constexpr std::size_t TextBlockSize = 64 * 1024;
+constexpr std::size_t ShardCount = 64;
+constexpr std::size_t InitialSlots = 64;
+
+// Entry blocks are published through atomics so view() can read them without a lock
+std::array<std::atomic<Entry*>, MaxEntryBlocks> entryBlocks{};
+
+// Open-addressing hash table of one shard. A slot holds the upper 32 bits of the
+// text's hash and the symbol + 1, or 0 when empty; it is probed without the lock
+struct Slots {
+    std::size_t mask;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+
+    explicit Slots(std::size_t capacity)
+        : mask(capacity - 1), slots(std::make_unique<std::atomic<std::uint64_t>[]>(capacity)) {}
+};
+
+// Strings are spread over the shards by hash; each shard has its own writer lock and text blocks
+struct alignas(64) Shard {
+    std::mutex mutex;                            // Serializes the writers of the shard
+    std::atomic<const Slots*> slots{nullptr};    // Current table, read without the lock
+    std::vector<std::unique_ptr<Slots>> tables;  // Current and outgrown tables; a reader may still probe an old one
+    std::size_t used = 0;                        // Filled slots of the current table
+    std::vector<std::unique_ptr<char[]>> textBlocks;
+    std::size_t textBytes = 0;                   // Bytes allocated for text blocks
+    char* textCursor = nullptr;
+    std::size_t textLeft = 0;
+
+    Shard() {
+        tables.push_back(std::make_unique<Slots>(InitialSlots));
+        slots.store(tables.back().get(), std::memory_order_release);
+    }
+};
+
+struct TableState {
+    std::array<Shard, ShardCount> shards;
+    std::atomic<std::size_t> count{0};  // Symbols handed out
+    std::mutex entryMutex;              // Guards ownedEntryBlocks; taken once per EntriesPerBlock symbols
+    std::vector<std::unique_ptr<Entry[]>> ownedEntryBlocks;
+};
+
+TableState& state() {
+    static TableState table;
+    return table;
+}
+
+// std::hash followed by the SplitMix64 finalizer, so every bit depends on the whole text
+std::uint64_t hashText(std::string_view text) {
+    std::uint64_t hash = std::hash<std::string_view>{}(text);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebULL;
+    return hash ^ (hash >> 31);
+}
+
+Shard& shardOf(TableState& table, std::uint64_t hash) {
+    return table.shards[hash & (ShardCount - 1)];
+}
+
+// Looks the text up in a table; lock-free
+std::optional<Symbol> probe(const Slots& table, std::uint32_t fragment, std::string_view text) {
+    for (std::size_t i = fragment & table.mask;; i = (i + 1) & table.mask) {
+        const std::uint64_t slot = table.slots[i].load(std::memory_order_acquire);
+        if (slot == 0) {
+            return std::nullopt;
+        }
+        if (static_cast<std::uint32_t>(slot >> 32) == fragment) {
+            const auto symbol = static_cast<Symbol>(static_cast<std::uint32_t>(slot) - 1);
+            if (SymbolTable::view(symbol) == text) {
+                return symbol;
+            }
+        }
+    }
+}
+
+void place(Slots& table, std::uint64_t slot) {
+    std::size_t i = static_cast<std::uint32_t>(slot >> 32) & table.mask;
+    while (table.slots[i].load(std::memory_order_relaxed) != 0) {
+        i = (i + 1) & table.mask;
+    }
+    table.slots[i].store(slot, std::memory_order_release);
+}
+
+// Makes room for one more slot, keeping the table at most half full; called with the shard's lock
+Slots& reserveSlot(Shard& shard) {
+    Slots& current = *shard.tables.back();
+    if ((shard.used + 1) * 2 <= current.mask + 1) {
+        return current;
+    }
+    auto grown = std::make_unique<Slots>((current.mask + 1) * 2);
+    for (std::size_t i = 0; i <= current.mask; ++i) {
+        if (const std::uint64_t slot = current.slots[i].load(std::memory_order_relaxed)) {
+            place(*grown, slot);
+        }
+    }
+    shard.tables.push_back(std::move(grown));
+    shard.slots.store(shard.tables.back().get(), std::memory_order_release);
+    return *shard.tables.back();
+}
+
+// Copies the text into the shard's current block, starting a new block when it does not fit
+const char* storeText(Shard& shard, std::string_view text) {
+    if (text.size() > shard.textLeft) {
+        const std::size_t blockSize = std::max(TextBlockSize, text.size());
+        shard.textBlocks.push_back(std::make_unique<char[]>(blockSize));
+        shard.textBytes += blockSize;
+        shard.textCursor = shard.textBlocks.back().get();
+        shard.textLeft = blockSize;
+    }
+    char* stored = shard.textCursor;
+    if (!text.empty()) {
+        std::memcpy(stored, text.data(), text.size());
+    }
+    shard.textCursor += text.size();
+    shard.textLeft -= text.size();
+    return stored;
+}
+
+// Returns the entry of a new symbol, creating its block on first use
+Entry& entryOf(TableState& table, std::size_t symbol) {
+    const std::size_t blockIndex = symbol >> EntryBlockBits;
+    Entry* block = entryBlocks[blockIndex].load(std::memory_order_acquire);
+    if (block == nullptr) {
+        const std::scoped_lock lock(table.entryMutex);
+        block = entryBlocks[blockIndex].load(std::memory_order_relaxed);
+        if (block == nullptr) {
+            table.ownedEntryBlocks.push_back(std::make_unique<Entry[]>(EntriesPerBlock));
+            block = table.ownedEntryBlocks.back().get();
+            entryBlocks[blockIndex].store(block, std::memory_order_release);
+        }
+    }
+    return block[symbol & (EntriesPerBlock - 1)];
+}
+
+} // namespace
+
+// Returns the existing symbol for the text or stores a new copy of it
+// A name seen before is found without a lock; a new name locks only the shard it hashes to
+Symbol SymbolTable::intern(std::string_view text) {
+    TableState& table = state();
+    const std::uint64_t hash = hashText(text);
+    const auto fragment = static_cast<std::uint32_t>(hash >> 32);
+    Shard& shard = shardOf(table, hash);
+    if (const auto found = probe(*shard.slots.load(std::memory_order_acquire), fragment, text)) {
+        return *found;
+    }
+
+    const std::scoped_lock lock(shard.mutex);
+    if (const auto found = probe(*shard.tables.back(), fragment, text)) {
+        return *found;  // Interned by another thread since the first probe
+    }
+    Slots& slots = reserveSlot(shard);
+    const std::size_t next = table.count.fetch_add(1, std::memory_order_relaxed);
+    if ((next >> EntryBlockBits) >= MaxEntryBlocks) {
+        throw std::length_error("SymbolTable is full.");
+    }
+    const char* stored = storeText(shard, text);
+    entryOf(table, next) = {stored, static_cast<std::uint32_t>(text.size())};
+
+    // Published last: a reader that finds the slot also sees the entry and the text
+    place(slots, (std::uint64_t{fragment} << 32) | (next + 1));
+    ++shard.used;
+    return static_cast<Symbol>(next);
+}
+
+// Looks up the text without interning it; lock-free
+std::optional<Symbol> SymbolTable::find(std::string_view text) {
+    TableState& table = state();
+    const std::uint64_t hash = hashText(text);
+    return probe(*shardOf(table, hash).slots.load(std::memory_order_acquire), static_cast<std::uint32_t>(hash >> 32), text);
+}
+
+// Resolves a symbol to its text; lock-free
+std::string_view SymbolTable::view(Symbol symbol) {
+    const Entry* block = entryBlocks[symbol >> EntryBlockBits].load(std::memory_order_acquire);
+    const Entry& entry = block[symbol & (EntriesPerBlock - 1)];
+    return {entry.data, entry.length};
+}
+
+// Returns the number of distinct interned strings
+std::size_t SymbolTable::size() {
+    return state().count.load(std::memory_order_acquire);
+}
+
+// Estimates the heap bytes owned by the table
+std::size_t SymbolTable::memoryUsage() {
+    TableState& table = state();
+    std::size_t bytes = 0;
+    for (Shard& shard : table.shards) {
+        const std::scoped_lock lock(shard.mutex);
+        bytes += shard.textBytes;
+        for (const auto& slots : shard.tables) {
+            bytes += (slots->mask + 1) * sizeof(std::uint64_t);
+        }
+    }
+    const std::scoped_lock lock(table.entryMutex);
+    return bytes + table.ownedEntryBlocks.size() * EntriesPerBlock * sizeof(Entry);
+}
@@ -0,0 +1,149 @@
+#include "../h/ThreadPool.h"
+#include <algorithm>
+#include <exception>
+#include <latch>
+#include <utility>
+
+namespace {
+
+// The pool and the worker index of the calling thread, so tasks submitted by a task stay local
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local std::size_t currentWorker = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threads) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    this->threads.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        this->threads.emplace_back([this, i] { run(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    wait();
+    {
+        const std::scoped_lock lock(sleepMutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    threads.clear();  // Joins the workers
+}
+
+void ThreadPool::submit(Task task) {
+    const std::size_t target = currentPool == this
+        ? currentWorker
+        : nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size();
+    unfinished.fetch_add(1, std::memory_order_relaxed);
+    queued.fetch_add(1);  // Counted first, so it never drops below the tasks in the deques
+    {
+        Worker& worker = *workers[target];
+        const std::scoped_lock lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    // Sequentially consistent with run(): either a worker about to sleep sees the task in
+    // `queued`, or we see it in `sleepers`. Only then is the shared lock taken
+    if (sleepers.load() == 0) {
+        return;
+    }
+    {
+        // Taken so the sleeper cannot miss the notification between checking `queued` and waiting
+        const std::scoped_lock lock(sleepMutex);
+    }
+    workAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock lock(sleepMutex);
+    allDone.wait(lock, [this] { return unfinished.load(std::memory_order_acquire) == 0; });
+}
+
+void ThreadPool::forEach(std::size_t count, const std::function<void(std::size_t)>& body) {
+    std::latch done(static_cast<std::ptrdiff_t>(count));
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::size_t submitted = 0;
+    try {
+        for (; submitted < count; ++submitted) {
+            submit([&, index = submitted] {
+                try {
+                    body(index);
+                } catch (...) {
+                    const std::scoped_lock lock(errorMutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                }
+                done.count_down();  // Last touch of this frame: the caller may return right after
+            });
+        }
+    } catch (...) {
+        done.count_down(static_cast<std::ptrdiff_t>(count - submitted));  // The calls never queued
+        done.wait();
+        throw;
+    }
+    done.wait();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Runs the newest task of the worker's own deque, or else steals the oldest task of another deque
+bool ThreadPool::tryRunOne(std::size_t self) {
+    Task task;
+    {
+        Worker& own = *workers[self];
+        const std::scoped_lock lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    for (std::size_t offset = 1; !task && offset < workers.size(); ++offset) {
+        Worker& victim = *workers[(self + offset) % workers.size()];
+        const std::scoped_lock lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            stealCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    try {
+        task();
+    } catch (...) {
+        failureCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    task = nullptr;  // Destroys the captures before the task counts as finished
+    if (unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        const std::scoped_lock lock(sleepMutex);
+        allDone.notify_all();
+    }
+    return true;
+}
+
+void ThreadPool::run(std::size_t self) {
+    currentPool = this;
+    currentWorker = self;
+    while (true) {
+        if (tryRunOne(self)) {
+            continue;
+        }
+        std::unique_lock lock(sleepMutex);
+        sleepers.fetch_add(1);  // Before checking `queued`, pairs with submit()
+        workAvailable.wait(lock, [this] { return stopping || queued.load() > 0; });
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+        if (stopping && queued.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
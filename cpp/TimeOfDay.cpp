@@ -0,0 +1,38 @@
+#include "../h/TimeOfDay.h"
+#include "../h/InvalidTimeException.h"
+
+// Parses a time in the strict "HH:MM" format
+// @param text: The time to parse
+// @return: The parsed time of day
+// @throws InvalidTimeException: If the text is not a valid time
+TimeOfDay TimeOfDay::parse(std::string_view text) {
+    const auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+    if (text.size() != 5 || text[2] != ':' ||
+        !isDigit(text[0]) || !isDigit(text[1]) || !isDigit(text[3]) || !isDigit(text[4])) {
+        throw InvalidTimeException("Invalid time format: \"" + std::string(text) + "\" (expected HH:MM).");
+    }
+
+    const int hours = (text[0] - '0') * 10 + (text[1] - '0');
+    const int mins = (text[3] - '0') * 10 + (text[4] - '0');
+    if (hours > 23 || mins > 59) {
+        throw InvalidTimeException("Invalid time of day: \"" + std::string(text) + "\".");
+    }
+    return {hours, mins};
+}
+
+// Formats the time as "HH:MM"
+std::string TimeOfDay::toString() const {
+    const int hours = minutes / 60;
+    const int mins = minutes % 60;
+    return {static_cast<char>('0' + hours / 10), static_cast<char>('0' + hours % 10), ':',
+            static_cast<char>('0' + mins / 10), static_cast<char>('0' + mins % 10)};
+}
+
+// Output stream operator overload for TimeOfDay
+// @param os: The output stream to print to
+// @param time: The time to print
+// @return: The output stream after printing the time
+std::ostream& operator<<(std::ostream& os, const TimeOfDay& time) {
+    os << time.toString();
+    return os;
+}
@@ -0,0 +1,85 @@
+#ifndef AVAILABILITY_TIMELINE_H
+#define AVAILABILITY_TIMELINE_H
+
+#include "Menu.h"
+#include "Category.h"
+#include "TimeOfDay.h"
+#include <bitset>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Precomputed availability of a restaurant's menus and categories.
+ *
+ * Every registered Menu or Category is sampled once for each minute of the day and
+ * stored as a 1440-slot bitmap, so answering "is it available now?" is a single bit
+ * test instead of a virtual call and a comparison.
+ *
+ * The timeline is a snapshot: register the entries again after their availability changes.
+ */
+class AvailabilityTimeline {
+public:
+    using EntryId = std::size_t; ///< Index of a registered menu or category.
+
+    /**
+     * @brief Registers a menu and precomputes its availability.
+     *
+     * @param menu The menu to sample.
+     * @return The id used to query the menu.
+     */
+    EntryId addMenu(const Menu& menu);
+
+    /**
+     * @brief Registers a category and precomputes its availability.
+     *
+     * @param category The category to sample.
+     * @return The id used to query the category.
+     */
+    EntryId addCategory(const Category& category);
+
+    /**
+     * @brief Checks whether a registered entry is available at the given time.
+     *
+     * @param id The id returned when the entry was registered.
+     * @param time The time of day to check.
+     * @return True if the entry is available, false otherwise.
+     */
+    [[nodiscard]] bool isAvailable(EntryId id, TimeOfDay time) const {
+        return slots[id].test(time.minutesSinceMidnight());
+    }
+
+    /**
+     * @brief Lists every registered entry available at the given time.
+     *
+     * @param time The time of day to check.
+     * @return The ids of the available entries, in registration order.
+     */
+    [[nodiscard]] std::vector<EntryId> availableAt(TimeOfDay time) const;
+
+    /**
+     * @brief Returns the number of registered entries.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return slots.size();
+    }
+
+private:
+    using DayBitmap = std::bitset<TimeOfDay::MinutesPerDay>;
+
+    std::vector<DayBitmap> slots; ///< One bitmap per registered entry, one bit per minute.
+
+    /**
+     * @brief Samples the availability of any type exposing isAvailableAt(TimeOfDay).
+     */
+    template <typename T>
+    EntryId sample(const T& source) {
+        DayBitmap bitmap;
+        for (std::uint16_t minute = 0; minute < TimeOfDay::MinutesPerDay; ++minute) {
+            bitmap.set(minute, source.isAvailableAt(TimeOfDay::fromMinutes(minute)));
+        }
+        slots.push_back(bitmap);
+        return slots.size() - 1;
+    }
+};
+
+#endif // AVAILABILITY_TIMELINE_H
@@ -0,0 +1,30 @@
+#ifndef BINARYMENUDISPLAY_H
+#define BINARYMENUDISPLAY_H
+
+
+#include "MenuDisplayStrategy.h"
+#include <cstdint>
+
+/**
+ * @brief Strategy encoding a menu in a compact length-prefixed binary format, for kiosks.
+ *
+ * All counts and lengths are unsigned LEB128 varints (7 bits per byte, low bits first),
+ * and a string is its byte length followed by its UTF-8 bytes:
+ *
+ *     "MB" version:u8
+ *     categoryCount
+ *     per category: name dishCount
+ *       per dish: name price weight:f32 foodMask:u8 ingredientCount
+ *         per ingredient: name type:u8 (the FoodType)
+ *
+ * The price is in bani, zigzag-encoded into a varint so small amounts take one or two
+ * bytes; the weight is an IEEE 754 float, little-endian.
+ */
+class BinaryMenuDisplay final : public MenuDisplayStrategy {
+public:
+    static constexpr std::uint8_t Version = 1;
+
+    void encode(const Menu& menu, MenuRenderer& out) const override;
+};
+
+#endif
@@ -15,18 +15,36 @@ public:
      * Calls the constructor of the base Menu class to initialize the menu categories.
      *
      * @param categories A vector of Category objects that represent the categories in the breakfast menu.
+     * @param allocator The memory resource of the menu's categories (the default heap if omitted).
      */
-    explicit Breakfast(const std::vector<Category>& categories);
+    explicit Breakfast(std::pmr::vector<Category> categories, const allocator_type& allocator = {});
+
+    /**
+     * @brief Constructor that copies the categories from any other range (e.g., a std::vector<Category>).
+     *
+     * @param categories The categories of the breakfast menu; the categories of an rvalue container are moved.
+     * @param allocator The memory resource of the menu's categories (the default heap if omitted).
+     */
+    template <ElementRange<Category> Categories>
+    explicit Breakfast(Categories&& categories, const allocator_type& allocator = {})
+        : Breakfast(toPmrVector<Category>(std::forward<Categories>(categories), allocator), allocator) {}
+
+    using Menu::isAvailableAt; // Keep the "HH:MM" string overload visible
 
     /**
      * @brief Checks if the breakfast menu is available at the given time.
      *
      * The breakfast menu is available only within specific hours (e.g., 08:00 - 10:00).
      *
-     * @param time The time in "HH:MM" format to check for availability.
+     * @param time The time of day to check for availability.
      * @return True if the menu is available at the given time, otherwise false.
      */
-    bool isAvailableAt(const std::string& time) const override;
+    bool isAvailableAt(TimeOfDay time) const override;
+
+    /**
+     * @brief Copies the breakfast menu on the heap, keeping its dynamic type.
+     */
+    std::unique_ptr<Menu> clone() const override;
 
 protected:
     /**
@@ -45,6 +63,13 @@ protected:
      */
     void print() const override;
 
+    /**
+     * @brief Renders the title printed before the categories: "Breakfast Menu:" and the description.
+     *
+     * @param renderer The renderer to append the title to.
+     */
+    void renderTitle(MenuRenderer& renderer) const override;
+
 };
 
 
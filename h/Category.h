@@ -3,30 +3,62 @@
 
 
 #include "Dish.h"  // Include the Dish class to use it within Category
+#include "DishOrdering.h" // Include DishOrdering for the multi-key dish sort
+#include "ElementRange.h" // Include ElementRange for the constructor taking any range of dishes
+#include "TimeOfDay.h" // Include TimeOfDay for the availability window
+#include <memory_resource> // Include memory_resource for the polymorphic allocator
 #include <string>   // Include string for handling text data
+#include <string_view> // Include string_view for the category name accessor
 #include <vector>   // Include vector for storing a collection of Dish objects
 #include <iostream> // Include iostream for output streaming (printing to console)
 #include <algorithm> // Include algorithm for sorting functions
 #include <ranges>    // Include ranges for modern sorting capabilities
+#include <span>      // Include span for the dishes view and the sorted keys passed to permuteDishes
+#include <utility>   // Include utility for std::move and std::forward
 
 // Class representing a category of dishes (e.g., "Breakfast", "Lunch")
+// The name and the dishes use a polymorphic allocator, which is passed down to every dish,
+// so a category built with an arena allocator keeps its whole subtree inside the arena.
 class Category {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
 private:
-    std::string name;           // Name of the category (e.g., "Breakfast")
-    std::vector<Dish> dishes;   // A list of Dish objects that belong to this category
+    std::pmr::string name;           // Name of the category (e.g., "Breakfast")
+    std::pmr::vector<Dish> dishes;   // A list of Dish objects that belong to this category
+    TimeWindow availability = TimeWindow::allDay(); // When the category can be ordered (whole day by default)
+    FoodMask foodMask = 0;      // Union of the food masks of all dishes, kept in sync on every change
 
 public:
     // Constructor that initializes the category with a name and a list of dishes
     // @param name: The name of the category (e.g., "Breakfast", "Lunch")
     // @param dishes: A list of Dish objects belonging to this category
-    Category(const std::string& name, const std::vector<Dish>& dishes);
-    const std::string& getName() const {
+    // @param allocator: The memory resource of the category and its dishes (the default heap if omitted)
+    // The dishes are moved in; pass an rvalue to avoid copying them
+    Category(std::string_view name, std::pmr::vector<Dish> dishes, const allocator_type& allocator = {});
+
+    // Constructor that copies the dishes from any other range (e.g., a std::vector<Dish>)
+    // @param dishes: The dishes of the category; the dishes of an rvalue container are moved
+    template <ElementRange<Dish> Dishes>
+    Category(std::string_view name, Dishes&& dishes, const allocator_type& allocator = {})
+        : Category(name, toPmrVector<Dish>(std::forward<Dishes>(dishes), allocator), allocator) {}
+
+    std::string_view getName() const {
         return name;
     }
 
-    // Sorts the dishes in the category alphabetically by their name
+    // Sorts the dishes in the category alphabetically by their name; dishes with the same name keep their order
     void sortDishesAlphabetically();
 
+    // Sorts the dishes by several keys (e.g., price, then name); equal dishes keep their order
+    // @param ordering: The keys to sort by, compared through keys precomputed once per dish
+    void sortDishes(const DishOrdering& ordering);
+
+    // Moves the dishes into the order of keys sorted by a DishOrdering, without allocating from the category's memory resource
+    // @param sorted: One key per dish, each position once; the dish at sorted[i].position moves to slot i
+    // @throws std::invalid_argument if there is not one key per dish
+    void permuteDishes(std::span<const DishOrdering::Key> sorted);
+
     // Overload the << operator to allow printing Category objects directly
     // @param os: The output stream to write to
     // @param category: The Category object to be printed
@@ -34,20 +66,89 @@ public:
     friend std::ostream& operator<<(std::ostream& os, const Category& category);
 
     // Returns the list of dishes in the category
-    // @return A vector containing all dishes in the category
-    const std::vector<Dish>& getDishes() const;
+    // @return A view of all dishes in the category, valid until the category changes
+    std::span<const Dish> getDishes() const;
+
+    // Adds a dish to the category and updates the aggregated food mask
+    // @param dish: The dish to add (moved in; pass an rvalue to avoid a copy)
+    void addDish(Dish dish);
+
+    // Removes the first dish with the given name and recomputes the aggregated food mask
+    // @param dish: The interned name of the dish
+    // @return true if a dish was removed
+    bool removeDish(Symbol dish);
+
+    // Looks up a dish by its interned name
+    // @param dish: The interned name of the dish
+    // @return The first dish with that name, or nullptr; valid until the category changes
+    [[nodiscard]] const Dish* findDish(Symbol dish) const;
+    [[nodiscard]] Dish* findDish(Symbol dish);
+
+    // Reserves room for a number of dishes, avoiding reallocation while the category is filled
+    // @param count: The expected number of dishes
+    void reserve(std::size_t count);
+
+    // Constructs a dish in place at the end of the category
+    // The pmr vector passes the category's allocator to the Dish constructor as its last argument
+    // @param args: The arguments of a Dish constructor
+    // @return The new dish, valid until the category changes
+    template <typename... Args>
+    Dish& emplaceDish(Args&&... args) {
+        Dish& dish = dishes.emplace_back(std::forward<Args>(args)...);
+        foodMask |= dish.getFoodMask();
+        return dish;
+    }
+
+    // Returns the food types found in any dish of the category
+    // @return The union of the dishes' food masks
+    [[nodiscard]] FoodMask getFoodMask() const;
+
+    // Checks if every dish in the category is vegetarian, in O(1)
+    // @return true if no dish contains meat
+    [[nodiscard]] bool isVegetarian() const;
+
+    // Returns the dishes matching a dietary constraint
+    // @param filter: The constraint to check (e.g., DietaryFilter::vegan())
+    // @return Pointers to the matching dishes, valid until the category changes
+    [[nodiscard]] std::vector<const Dish*> filter(DietaryFilter filter) const;
 
     // Virtual destructor ensures proper cleanup in derived classes
     virtual ~Category() = default;
 
+    Category(const Category&) = default;
+    Category(Category&&) noexcept = default;
+    Category& operator=(const Category&) = default;
+    Category& operator=(Category&&) noexcept = default;
+
+    // Allocator-extended copy and move, used by std::pmr containers of categories
+    Category(const Category& other, const allocator_type& allocator);
+    Category(Category&& other, const allocator_type& allocator);
+
+    // Returns the allocator of the category, shared by its dishes
+    [[nodiscard]] allocator_type get_allocator() const {
+        return dishes.get_allocator();
+    }
+
     // Prints the category name and details of each dish
     void print() const;
 
     // Checks if the category is available at a given time of the day
-    // This is a virtual function that can be overridden by derived classes
+    // @param timeOfDay: The time to check availability for
+    // @return True if the time falls inside the category's availability window
+    bool isAvailableAt(TimeOfDay timeOfDay) const;
+
+    // Parses the time and forwards to the TimeOfDay overload
     // @param timeOfDay: The time to check availability for (e.g., "10:00")
     // @return True if the category is available, false otherwise
+    // @throws InvalidTimeException if the time is not in "HH:MM" format
     bool isAvailableAt(const std::string& timeOfDay) const;
+
+    // Restricts the category to a window of the day (e.g., desserts only after 12:00)
+    // @param window: The interval during which the category is available
+    void setAvailability(TimeWindow window);
+
+    // Returns the window of the day during which the category is available
+    [[nodiscard]] TimeWindow getAvailability() const;
 };
 
 #endif // CATEGORY_H
@@ -0,0 +1,42 @@
+#ifndef DIETARY_FILTER_H
+#define DIETARY_FILTER_H
+
+#include "Ingredient.h"
+
+/**
+ * @brief A dietary constraint expressed as two FoodMask sets.
+ *
+ * A dish matches when it contains every required food type and none of the excluded ones,
+ * which is two bitwise operations on the dish's precomputed FoodMask.
+ * Filters can be combined with operator&.
+ */
+struct DietaryFilter {
+    FoodMask required = 0; ///< Food types the dish must contain.
+    FoodMask excluded = 0; ///< Food types the dish must not contain.
+
+    /**
+     * @brief Checks a dish's food mask against the constraint.
+     *
+     * @param mask The FoodMask of the dish.
+     * @return True if the dish satisfies the constraint.
+     */
+    [[nodiscard]] constexpr bool matches(FoodMask mask) const {
+        return (mask & required) == required && (mask & excluded) == 0;
+    }
+
+    static constexpr DietaryFilter vegetarian() { return {0, toFoodMask(FoodType::MEAT)}; }
+    static constexpr DietaryFilter vegan() { return {0, toFoodMask(FoodType::MEAT) | toFoodMask(FoodType::DAIRY)}; }
+    static constexpr DietaryFilter glutenFree() { return {0, toFoodMask(FoodType::CEREAL)}; }
+    static constexpr DietaryFilter containsDairy() { return {toFoodMask(FoodType::DAIRY), 0}; }
+    static constexpr DietaryFilter containsMeat() { return {toFoodMask(FoodType::MEAT), 0}; }
+    static constexpr DietaryFilter containsGluten() { return {toFoodMask(FoodType::CEREAL), 0}; }
+
+    /**
+     * @brief Combines two constraints; a dish must satisfy both.
+     */
+    friend constexpr DietaryFilter operator&(DietaryFilter lhs, DietaryFilter rhs) {
+        return {static_cast<FoodMask>(lhs.required | rhs.required), static_cast<FoodMask>(lhs.excluded | rhs.excluded)};
+    }
+};
+
+#endif // DIETARY_FILTER_H
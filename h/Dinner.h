@@ -8,12 +8,24 @@ class Dinner : public Menu {
 public:
     // Constructor for the Dinner class, initializes the base Menu class with categories
     // @param categories: A vector of Category objects that represent the available categories in the dinner menu
-    explicit Dinner(const std::vector<Category>& categories);
+    // @param allocator: The memory resource of the menu's categories (the default heap if omitted)
+    explicit Dinner(std::pmr::vector<Category> categories, const allocator_type& allocator = {});
+
+    // Constructor that copies the categories from any other range (e.g., a std::vector<Category>)
+    // @param categories: The categories of the dinner menu; the categories of an rvalue container are moved
+    template <ElementRange<Category> Categories>
+    explicit Dinner(Categories&& categories, const allocator_type& allocator = {})
+        : Dinner(toPmrVector<Category>(std::forward<Categories>(categories), allocator), allocator) {}
+
+    using Menu::isAvailableAt; // Keep the "HH:MM" string overload visible
 
     // Function to check if the dinner menu is available at the specified time
-    // @param time: A string representing the time (e.g., "18:00", "20:00")
+    // @param time: The time of day to check (e.g., 18:00, 20:00)
     // @return true if the time is between 18:00 and 22:00, indicating availability for dinner
-    bool isAvailableAt(const std::string& time) const override;
+    bool isAvailableAt(TimeOfDay time) const override;
+
+    // Function to copy the dinner menu on the heap, keeping its dynamic type
+    std::unique_ptr<Menu> clone() const override;
 
 protected:
     // Function to return the description of the dinner menu
@@ -22,6 +34,9 @@ protected:
 
     // Function to print the dinner menu along with its categories and dishes
     void print() const override;
+
+    // Function to render the "Dinner Menu:" header printed before the categories
+    void renderTitle(MenuRenderer& renderer) const override;
 };
 
 #endif // DINNER_H
@@ -2,33 +2,84 @@
 #define DISH_H
 
 #include "Ingredient.h"
-#include <string>
+#include "DietaryFilter.h"
+#include "Money.h"
+#include "SymbolTable.h"
+#include <atomic>
+#include <memory_resource>
+#include <string_view>
 #include <vector>
 #include <iostream>
 
 // Represents a dish on the menu with its properties and ingredients
+// The ingredient list uses a polymorphic allocator, so a dish stored in a std::pmr container
+// (e.g., a Category built inside a MenuArena) allocates from the container's memory resource.
 class Dish {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
 private:
-    std::string name;            // Name of the dish
-    float price;                 // Price of the dish
-    [[maybe_unused]]float weight;                // Weight of the dish (could be useful in some menus)
-    std::vector<Ingredient> ingredients;  // List of ingredients that make up the dish
-    static int instanceCount;
+    Symbol name;                 // Interned name of the dish
+    Money price;                 // Price of the dish, in fixed-point bani
+    float weight;                // Weight of the dish (could be useful in some menus)
+    std::pmr::vector<Ingredient> ingredients;  // List of ingredients that make up the dish
+    FoodMask foodMask;           // Food types present in the ingredients, kept in sync on every change
+    static std::atomic<int> instanceCount; // Atomic so dishes can be built on several threads (e.g., MenuImporter)
 public:
     // Constructor to initialize a dish object
-    // @param name: Name of the dish
+    // @param name: Name of the dish (interned in the SymbolTable)
     // @param price: Price of the dish
     // @param weight: Weight of the dish
-    // @param ingredients: A vector of Ingredient objects that are part of the dish
-    Dish(std::string name, float price, float weight, const std::vector<Ingredient>& ingredients);
+    // @param ingredients: A vector of Ingredient objects that are part of the dish (moved in; pass an rvalue to avoid a copy)
+    // @param allocator: The memory resource of the ingredient list (the default heap if omitted)
+    Dish(std::string_view name, Money price, float weight, std::pmr::vector<Ingredient> ingredients,
+         const allocator_type& allocator = {});
 
     // Returns the name of the dish
-    // @return The name of the dish
-    [[nodiscard]] const std::string& getName() const;
+    // @return A view of the interned name of the dish
+    [[nodiscard]] std::string_view getName() const;
+
+    // Returns the interned name of the dish
+    // @return The symbol identifying the dish's name
+    [[nodiscard]] Symbol getSymbol() const;
+
+    // Returns the price of the dish; inline so filters over many dishes stay call-free
+    // @return The exact price of the dish
+    [[nodiscard]] Money getPrice() const {
+        return price;
+    }
+
+    // Changes the price of the dish
+    // @param newPrice: The new price
+    void setPrice(Money newPrice);
+
+    // Returns the weight of the dish
+    // @return The weight of the dish
+    [[nodiscard]] float getWeight() const;
+
+    // Returns the ingredients that make up the dish
+    // @return A vector containing the dish's ingredients
+    [[nodiscard]] const std::pmr::vector<Ingredient>& getIngredients() const;
 
-    // Returns the price of the dish
-    // @return The price of the dish
-    [[nodiscard]] float getPrice() const;
+    // Adds an ingredient to the dish and updates its food mask
+    // @param ingredient: The ingredient to add
+    void addIngredient(const Ingredient& ingredient);
+
+    // Removes every ingredient with the given name and recomputes the food mask
+    // @param ingredientName: The name of the ingredient to remove
+    // @return true if at least one ingredient was removed
+    bool removeIngredient(std::string_view ingredientName);
+
+    // Returns the food types present in the dish's ingredients; inline like getPrice()
+    // @return A FoodMask with one bit per FoodType found
+    [[nodiscard]] FoodMask getFoodMask() const {
+        return foodMask;
+    }
+
+    // Checks the dish against a dietary constraint using its precomputed food mask
+    // @param filter: The constraint to check
+    // @return true if the dish satisfies the constraint
+    [[nodiscard]] bool matches(DietaryFilter filter) const;
 
     // Checks whether the dish is vegetarian based on its ingredients
     // @return true if no meat is found in the ingredients, otherwise false
@@ -43,6 +94,20 @@ public:
     // Destructor (default implementation)
     ~Dish() = default;
 
+    Dish(const Dish&) = default;
+    Dish(Dish&&) noexcept = default;
+    Dish& operator=(const Dish&) = default;
+    Dish& operator=(Dish&&) noexcept = default;
+
+    // Allocator-extended copy and move, used by std::pmr containers of dishes
+    Dish(const Dish& other, const allocator_type& allocator);
+    Dish(Dish&& other, const allocator_type& allocator);
+
+    // Returns the allocator of the ingredient list
+    [[nodiscard]] allocator_type get_allocator() const {
+        return ingredients.get_allocator();
+    }
+
     // Prints the name and price of the dish
     void print() const;
 };
@@ -0,0 +1,290 @@
+#ifndef DISH_CATALOG_H
+#define DISH_CATALOG_H
+
+#include "Category.h"
+#include "Dish.h"
+#include "Menu.h"
+#include "MenuEvent.h"
+#include "Money.h"
+#include "Observer.h"
+#include "SymbolTable.h"
+#include "TimeOfDay.h"
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+using DishId = std::uint32_t; ///< Row index of a dish inside a DishCatalog; valid until the catalog changes.
+
+class DishCatalog;
+
+/**
+ * @brief Read-only view of one category stored in a DishCatalog.
+ *
+ * A CategoryView is the index of a row of the catalog's category table, which holds the
+ * range of the category's dishes; copying it is free, and it follows the range when the
+ * catalog moves the dishes. It offers the same getDishes()/operator<< behavior as
+ * Category through materialization. It is valid until its category is removed.
+ */
+class CategoryView {
+private:
+    friend class DishCatalog;
+
+    const DishCatalog* catalog; ///< The catalog holding the dish columns.
+    std::uint32_t index;        ///< Row of the category inside the catalog.
+
+public:
+    CategoryView(const DishCatalog& catalog, std::uint32_t index) : catalog(&catalog), index(index) {}
+
+    /**
+     * @brief Returns the name of the category.
+     */
+    [[nodiscard]] std::string_view getName() const;
+
+    /**
+     * @brief Returns the id of the first dish of the category.
+     */
+    [[nodiscard]] DishId firstDish() const;
+
+    /**
+     * @brief Returns the number of dishes in the category.
+     */
+    [[nodiscard]] std::uint32_t size() const;
+
+    /**
+     * @brief Checks if the category is available at the given time.
+     */
+    [[nodiscard]] bool isAvailableAt(TimeOfDay time) const;
+
+    /**
+     * @brief Rebuilds the dishes of the category as Dish objects.
+     *
+     * @return A vector with the same content as Category::getDishes().
+     */
+    [[nodiscard]] std::vector<Dish> getDishes() const;
+
+    /**
+     * @brief Sums the prices of the category with a contiguous column scan.
+     */
+    [[nodiscard]] Money totalPrice() const;
+
+    /**
+     * @brief Returns the ids of the dishes matching a dietary constraint.
+     */
+    [[nodiscard]] std::vector<DishId> filter(DietaryFilter filter) const;
+
+    /**
+     * @brief Returns the ids of the vegetarian dishes in the category.
+     */
+    [[nodiscard]] std::vector<DishId> vegetarianDishes() const;
+
+    /**
+     * @brief Prints the category exactly like operator<< for Category.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const CategoryView& category);
+};
+
+/**
+ * @brief Read-only view of a menu tracked by a DishCatalog.
+ *
+ * Lists the menu's categories in the menu's current order.
+ */
+class MenuView {
+private:
+    const DishCatalog* catalog; ///< The catalog holding the menu table.
+    std::uint32_t index;        ///< Row of the menu inside the catalog.
+
+public:
+    MenuView(const DishCatalog& catalog, std::uint32_t index) : catalog(&catalog), index(index) {}
+
+    /**
+     * @brief Returns the number of categories in the menu.
+     */
+    [[nodiscard]] std::uint32_t size() const;
+
+    /**
+     * @brief Returns a view of the i-th category of the menu.
+     */
+    [[nodiscard]] CategoryView category(std::uint32_t i) const;
+
+    /**
+     * @brief Prints the menu exactly like operator<< for Menu.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const MenuView& menu);
+};
+
+/**
+ * @class DishCatalog
+ * @brief Structure-of-arrays backing store for dishes.
+ *
+ * Every dish attribute lives in its own contiguous column (names, prices, weights,
+ * ingredient spans and dietary flags), so scans such as price totals, vegetarian
+ * filtering and sorting touch only the bytes they need. Categories and menus are
+ * flattened into index ranges and exposed through CategoryView and MenuView.
+ *
+ * A menu added with addMenu() stays in sync: the catalog observes it and applies each
+ * change to the columns as it happens. A repricing writes one price, an added dish
+ * fills a row reserved at the end of its category's range (the range moves to the end
+ * of the columns, with room to spare, once it is full), a removed dish shifts the rest
+ * of its category, and sorting the menu rewrites the ranges in the new order. The
+ * rows left behind are reclaimed by compacting the columns once they outnumber the
+ * dishes, which renumbers the dishes. Like the menus themselves, the catalog must be
+ * used from one thread at a time, and every tracked menu must outlive it.
+ *
+ * The catalog is a mirror: the menus keep owning their Category and Dish objects, and
+ * the catalog holds a second copy of each dish. Menu and Category are copied by value
+ * throughout (clone(), MenuManager's copy-on-write, the version store and the journal),
+ * so they cannot be views into one shared catalog. A mirror follows only the menu
+ * passed to addMenu(): a clone of it, such as the copy MenuManager publishes, starts
+ * without observers and is not tracked until it is added too.
+ */
+class DishCatalog : public Observer {
+public:
+    DishCatalog() = default;
+
+    /**
+     * @brief Stops observing the tracked menus.
+     */
+    ~DishCatalog() override;
+
+    DishCatalog(const DishCatalog&) = delete;
+    DishCatalog& operator=(const DishCatalog&) = delete;
+
+    /**
+     * @brief Appends a single dish to the catalog, outside any category.
+     *
+     * @param dish The dish to copy into the columns.
+     * @return The id of the new row.
+     */
+    DishId addDish(const Dish& dish);
+
+    /**
+     * @brief Copies the dishes of a category into the catalog as one contiguous range.
+     *
+     * The catalog owns the copy, like a menu owns the categories added to it.
+     *
+     * @param category The category to flatten.
+     * @return A view over the stored category.
+     */
+    CategoryView addCategory(const Category& category);
+
+    /**
+     * @brief Flattens every category of a menu and keeps them in sync with the menu.
+     *
+     * @param menu The menu to track; it must outlive the catalog. Adding it again returns the same view.
+     * @return A view over the tracked menu.
+     */
+    MenuView addMenu(Menu& menu);
+
+    /**
+     * @brief Applies a change of a tracked menu to the columns; called by the menu.
+     */
+    void update(const MenuEvent& event) override;
+
+    /**
+     * @brief Sorts the dishes of a stored category alphabetically, in place.
+     *
+     * The sort is stable and permutes every column of the category's range.
+     *
+     * @param category A view returned by this catalog.
+     * @throws std::invalid_argument If the category belongs to a tracked menu; sort the menu instead.
+     */
+    void sortCategory(const CategoryView& category);
+
+    /**
+     * @brief Rebuilds a Dish object from a catalog row.
+     */
+    [[nodiscard]] Dish dish(DishId id) const;
+
+    /**
+     * @brief Returns the number of dishes in the catalog.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return names.size() - unusedRows;
+    }
+
+    // The columns also hold the unused rows between the ranges of the categories
+    [[nodiscard]] std::span<const Symbol> nameColumn() const { return names; }
+    [[nodiscard]] std::span<const Money> priceColumn() const { return prices; }
+    [[nodiscard]] std::span<const float> weightColumn() const { return weights; }
+    [[nodiscard]] std::span<const FoodMask> flagColumn() const { return flags; }
+
+    /**
+     * @brief Returns the ingredients of a dish as a span into the shared ingredient pool.
+     */
+    [[nodiscard]] std::span<const Ingredient> ingredientsOf(DishId id) const {
+        return std::span<const Ingredient>(ingredientPool).subspan(ingredientBegin[id], ingredientCount[id]);
+    }
+
+    /**
+     * @brief Sums the prices of a contiguous range of dishes.
+     */
+    [[nodiscard]] Money totalPrice(DishId first, std::uint32_t count) const;
+
+    /**
+     * @brief Sums the prices of a batch of order lines given as dish ids.
+     *
+     * @param ids The dish id of each order line; ids may repeat.
+     * @return The exact total.
+     */
+    [[nodiscard]] Money totalPrice(std::span<const DishId> ids) const;
+
+private:
+    friend class CategoryView;
+    friend class MenuView;
+
+    static constexpr std::uint32_t NoMenu = std::numeric_limits<std::uint32_t>::max();
+
+    /// The columns are compacted once they hold more unused rows (or ingredients) than this and than used ones.
+    static constexpr std::size_t MinUnusedToCompact = 1024;
+
+    // Dish columns, one entry per DishId
+    std::vector<Symbol> names;
+    std::vector<Money> prices;
+    std::vector<float> weights;
+    std::vector<std::uint32_t> ingredientBegin;
+    std::vector<std::uint32_t> ingredientCount;
+    std::vector<FoodMask> flags;       ///< One bit per FoodType present in the dish.
+    std::vector<Ingredient> ingredientPool;
+    std::vector<bool> used;            ///< Whether the row holds a dish, rather than room left by a moved or removed one.
+    std::size_t unusedRows = 0;        ///< Rows outside every category's dishes.
+    std::size_t unusedIngredients = 0; ///< Pool entries of dishes no longer stored.
+
+    // Category table, one entry per stored category
+    struct CategoryRow {
+        Symbol name;
+        DishId first;
+        std::uint32_t count;
+        std::uint32_t capacity;         ///< Rows reserved for the category, count included.
+        TimeWindow availability;
+        std::uint32_t menu = NoMenu;    ///< The tracked menu the category belongs to, if any.
+    };
+    std::vector<CategoryRow> categories;
+    std::vector<std::uint32_t> freeCategories; ///< Rows of removed categories, reused first.
+
+    // Menu table, one entry per tracked menu
+    struct MenuRow {
+        Menu* menu;
+        std::vector<std::uint32_t> categories;              ///< Category rows, in the menu's order.
+        std::unordered_map<Symbol, std::uint32_t> rowOf;    ///< Category name -> category row.
+    };
+    std::vector<MenuRow> menus;
+    std::unordered_map<std::uint64_t, std::uint32_t> menuRows; ///< Menu::getId() -> menu row.
+
+    DishId appendRows(std::size_t count);
+    void writeDish(DishId id, const Dish& dish);
+    void copyRow(DishId from, DishId to);
+    void clearRows(DishId first, std::uint32_t count);
+    void reserveRows(CategoryRow& category, std::uint32_t capacity);
+    std::uint32_t storeCategory(const Category& category, std::uint32_t menu);
+    void fillCategory(CategoryRow& category, const Category& source);
+    void releaseCategory(std::uint32_t row);
+    void appendDish(CategoryRow& category, const Dish& dish);
+    void removeDish(CategoryRow& category, Symbol dish);
+    void followOrder(MenuRow& menu);
+    void compactIfSparse();
+};
+
+#endif // DISH_CATALOG_H
@@ -0,0 +1,138 @@
+#ifndef DISH_ORDERING_H
+#define DISH_ORDERING_H
+
+#include "Dish.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <span>
+
+/**
+ * @brief A property dishes can be ordered by.
+ */
+enum class DishSortField : std::uint8_t {
+    Name,       ///< Byte order of the names, like std::string's operator<.
+    Price,
+    Popularity, ///< The number given by the ordering's popularity function (e.g., orders served).
+};
+
+/**
+ * @brief One key of a DishOrdering: a field and its direction.
+ */
+struct DishSortKey {
+    DishSortField field;
+    bool descending = false;
+};
+
+/**
+ * @class DishOrdering
+ * @brief A stable multi-key order of dishes, compared through precomputed integer keys.
+ *
+ * Before sorting, each dish gets a Key: one unsigned integer per sort key, mapped so
+ * that the smaller integer comes first, and the dish's position. A name becomes its
+ * first 8 bytes packed big-endian, so two names compare like their integers unless
+ * they share those 8 bytes; only then are the full names read. Prices are shifted to
+ * unsigned, and a descending key is stored complemented. The position breaks the
+ * remaining ties, which makes any sort by less() stable, and lets sorted runs of keys
+ * be merged in parallel with the same result.
+ *
+ * Example, cheapest first and most popular first at the same price:
+ *
+ *     DishOrdering ordering({{DishSortField::Price}, {DishSortField::Popularity, true}},
+ *                           [&](const Dish& dish) { return ordersServed[dish.getSymbol()]; });
+ *     category.sortDishes(ordering);
+ */
+class DishOrdering {
+public:
+    static constexpr std::size_t MaxKeys = 3;
+
+    /**
+     * @brief Computes the popularity of a dish, once per dish and sort.
+     *
+     * A parallel sort calls it from several workers at once.
+     */
+    using Popularity = std::function<std::uint64_t(const Dish&)>;
+
+    /**
+     * @brief The precomputed key of a dish.
+     */
+    struct Key {
+        std::array<std::uint64_t, MaxKeys> fields{}; ///< One value per sort key; unused ones stay 0.
+        std::uint32_t position = 0;                  ///< Slot of the dish before sorting.
+    };
+
+    /**
+     * @brief Orders dishes by name.
+     */
+    DishOrdering();
+
+    /**
+     * @brief Orders dishes by several keys, the most significant first.
+     *
+     * @param keys Up to MaxKeys keys, each field at most once.
+     * @param popularity Required if a key is DishSortField::Popularity.
+     * @throws std::invalid_argument If the keys are empty, too many or repeated, or the popularity function is missing.
+     */
+    DishOrdering(std::initializer_list<DishSortKey> keys, Popularity popularity = {});
+
+    /**
+     * @brief Computes the keys of a run of dishes.
+     *
+     * @param dishes All the dishes being sorted, read by less() on ties of names.
+     * @param first The position of the first dish of the run.
+     * @param keys Receives the key of dishes[first + i] at index i.
+     */
+    void computeKeys(std::span<const Dish> dishes, std::size_t first, std::span<Key> keys) const;
+
+    /**
+     * @brief Tells whether the dish of key a comes before the dish of key b.
+     *
+     * @param dishes The dishes the keys were computed from, in their unsorted order.
+     */
+    [[nodiscard]] bool less(const Key& a, const Key& b, std::span<const Dish> dishes) const {
+        for (std::size_t key = 0; key < MaxKeys; ++key) {  // A fixed count, so the loop unrolls
+            if (a.fields[key] != b.fields[key]) {
+                return a.fields[key] < b.fields[key];
+            }
+            if (key == nameKey) {
+                const int order = compareNames(a, b, dishes);
+                if (order != 0) {
+                    return order < 0;
+                }
+            }
+        }
+        return a.position < b.position;
+    }
+
+    /**
+     * @brief Sorts keys computed from dishes.
+     */
+    void sort(std::span<Key> keys, std::span<const Dish> dishes) const;
+
+    /**
+     * @brief Returns the sort keys, the most significant first.
+     */
+    [[nodiscard]] std::span<const DishSortKey> sortKeys() const { return {keys.data(), keyCount}; }
+
+    /**
+     * @brief Tells whether the order depends only on the dishes, so sorting equal dishes again gives it back.
+     *
+     * False when a key is DishSortField::Popularity, whose numbers come from outside the dishes.
+     */
+    [[nodiscard]] bool dependsOnDishesOnly() const;
+
+private:
+    /**
+     * @brief Compares the full names of two dishes whose 8-byte prefixes are equal, in the key's direction.
+     */
+    [[nodiscard]] int compareNames(const Key& a, const Key& b, std::span<const Dish> dishes) const;
+
+    std::array<DishSortKey, MaxKeys> keys{};
+    std::size_t keyCount = 0;
+    std::size_t nameKey = MaxKeys; ///< Index of the name key, or MaxKeys if there is none.
+    Popularity popularity;
+};
+
+#endif // DISH_ORDERING_H
@@ -0,0 +1,16 @@
+#ifndef DUPLICATE_CATEGORY_EXCEPTION_H
+#define DUPLICATE_CATEGORY_EXCEPTION_H
+
+#include "MenuException.h"
+
+// Exception class thrown when a menu would hold two categories with the same name
+// This class is derived from the MenuException base class.
+class DuplicateCategoryException : public MenuException {
+public:
+    // Constructor to initialize the exception with an error message
+    // @param message: The error message naming the duplicated category
+    explicit DuplicateCategoryException(const std::string& message)
+        : MenuException(message) {}  // Pass the message to the base class constructor
+};
+
+#endif // DUPLICATE_CATEGORY_EXCEPTION_H
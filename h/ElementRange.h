@@ -0,0 +1,45 @@
+#ifndef ELEMENT_RANGE_H
+#define ELEMENT_RANGE_H
+
+#include <concepts>
+#include <memory_resource>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A range whose elements can build an Element, other than the std::pmr::vector<Element> the model stores.
+ *
+ * Lets the model's constructors accept a std::vector, a span or any other range next to
+ * their std::pmr::vector overloads; a braced list still picks the std::pmr::vector one.
+ */
+template <typename Range, typename Element>
+concept ElementRange = std::ranges::input_range<Range> &&
+                       std::constructible_from<Element, std::ranges::range_reference_t<Range>> &&
+                       !std::same_as<std::remove_cvref_t<Range>, std::pmr::vector<Element>>;
+
+/**
+ * @brief Copies a range into a std::pmr::vector using an allocator.
+ *
+ * The elements of a container passed as an rvalue are moved instead of copied; a view
+ * is always copied from, since it does not own its elements.
+ */
+template <typename Element, ElementRange<Element> Range>
+std::pmr::vector<Element> toPmrVector(Range&& range, const std::pmr::polymorphic_allocator<>& allocator) {
+    std::pmr::vector<Element> elements(allocator);
+    if constexpr (std::ranges::sized_range<Range>) {
+        elements.reserve(std::ranges::size(range));
+    }
+    constexpr bool owned = !std::is_lvalue_reference_v<Range> && !std::ranges::view<std::remove_cvref_t<Range>>;
+    for (auto&& element : range) {
+        if constexpr (owned) {
+            elements.emplace_back(std::move(element));
+        } else {
+            elements.emplace_back(element);
+        }
+    }
+    return elements;
+}
+
+#endif // ELEMENT_RANGE_H
@@ -1,7 +1,9 @@
 #ifndef INGREDIENT_H
 #define INGREDIENT_H
 
-#include <string>
+#include "SymbolTable.h"
+#include <cstdint>
+#include <string_view>
 #include <iostream>
 
 // Enum class for FoodType, representing different categories of food
@@ -15,20 +17,34 @@ enum class FoodType {
     CEREAL
 };
 
+// Bitmask with one bit per FoodType, used to summarize the ingredients of a dish
+using FoodMask = std::uint8_t;
+
+// Returns the bit corresponding to a food type
+// @param type: The food type
+// @return: A mask with only that type's bit set
+constexpr FoodMask toFoodMask(FoodType type) {
+    return static_cast<FoodMask>(1u << static_cast<unsigned>(type));
+}
+
 class Ingredient {
 private:
-    std::string name;  // Name of the ingredient (e.g., "Tomato", "Cheese")
+    Symbol name;      // Interned name of the ingredient (e.g., "Tomato", "Cheese")
     FoodType type;    // The type of the ingredient (using FoodType enum)
 
 public:
     // Constructor to initialize the ingredient with a name and type
-    // @param name: Name of the ingredient
+    // @param name: Name of the ingredient (interned in the SymbolTable)
     // @param type: Type of the ingredient (from FoodType enum)
-    Ingredient(std::string name, FoodType type);
+    Ingredient(std::string_view name, FoodType type);
 
     // Getter for the name of the ingredient
-    // @return: A constant reference to the name of the ingredient
-    [[nodiscard]] const std::string& getName() const;
+    // @return: A view of the interned name of the ingredient
+    [[nodiscard]] std::string_view getName() const;
+
+    // Getter for the interned name of the ingredient
+    // @return: The symbol identifying the ingredient's name
+    [[nodiscard]] Symbol getSymbol() const;
 
     // Getter for the type of the ingredient
     // @return: The type of the ingredient (FoodType)
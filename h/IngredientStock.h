@@ -0,0 +1,124 @@
+#ifndef INGREDIENT_STOCK_H
+#define INGREDIENT_STOCK_H
+
+#include "Dish.h"
+#include "Ingredient.h"
+#include "SymbolTable.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+/**
+ * @class IngredientStock
+ * @brief Lock-free ledger of the units of each ingredient left in the kitchen.
+ *
+ * Every tracked ingredient has its own atomic counter on its own cache line, so
+ * orders that use different ingredients never touch the same memory, and orders
+ * that share a popular ingredient only contend on that counter. Reserving a dish
+ * takes one unit of each of its ingredients with a compare-and-swap that never lets
+ * a counter go below zero; on a shortfall the units already taken are given back,
+ * so a failed reservation leaves the stock as it was.
+ *
+ * Ingredients without a stock level are not tracked and never run out (e.g., salt).
+ * Dishes registered with trackDish() keep a count of their depleted ingredients,
+ * updated when an ingredient reaches or leaves zero, so isAvailable() is O(1). That
+ * flag is a hint for displaying the menu; reserve() is what decides a sale.
+ *
+ * Ingredients and dishes are identified by their interned names.
+ */
+class IngredientStock {
+public:
+    IngredientStock();
+    ~IngredientStock();
+
+    IngredientStock(const IngredientStock&) = delete;
+    IngredientStock& operator=(const IngredientStock&) = delete;
+
+    /**
+     * @brief Sets the units left of an ingredient, which becomes tracked.
+     */
+    void setStock(const Ingredient& ingredient, std::int64_t units);
+
+    /**
+     * @brief Adds units of an ingredient (a delivery), which becomes tracked.
+     */
+    void restock(const Ingredient& ingredient, std::int64_t units);
+
+    /**
+     * @brief Returns the units left of an ingredient, or nothing if it is not tracked.
+     */
+    [[nodiscard]] std::optional<std::int64_t> unitsOf(const Ingredient& ingredient) const;
+
+    /**
+     * @brief Takes one unit of every ingredient of a dish per portion, all or nothing.
+     *
+     * @param dish The dish to prepare.
+     * @param portions The number of portions.
+     * @return false, with the stock unchanged, if an ingredient does not have enough units.
+     */
+    bool reserve(const Dish& dish, unsigned portions = 1);
+
+    /**
+     * @brief Gives back the units taken by reserve(), e.g., when an order is cancelled.
+     */
+    void release(const Dish& dish, unsigned portions = 1);
+
+    /**
+     * @brief Starts keeping the availability flag of a dish up to date.
+     */
+    void trackDish(const Dish& dish);
+
+    /**
+     * @brief Checks in O(1) that no ingredient of a tracked dish has run out.
+     *
+     * @return true for dishes that are not tracked.
+     */
+    [[nodiscard]] bool isAvailable(const Dish& dish) const;
+
+private:
+    struct alignas(64) IngredientSlot {
+        std::atomic<std::int64_t> units{0};
+        std::atomic<bool> tracked{false};
+        std::mutex dependentsMutex;        ///< Guards the two members below; taken only when the ingredient reaches or leaves zero.
+        std::vector<Symbol> dependents;    ///< Tracked dishes using the ingredient.
+        bool depletedApplied = false;      ///< Whether the dependents currently count this ingredient as depleted.
+    };
+
+    struct DishSlot {
+        std::atomic<std::int32_t> depletedIngredients{0};
+        std::atomic<bool> tracked{false};
+    };
+
+    /**
+     * @brief Slots indexed by symbol, in chunks allocated on first use without locking.
+     */
+    template <typename Slot>
+    class SymbolSlots {
+    public:
+        SymbolSlots() = default;
+        ~SymbolSlots();
+        SymbolSlots(const SymbolSlots&) = delete;
+        SymbolSlots& operator=(const SymbolSlots&) = delete;
+
+        [[nodiscard]] Slot* find(Symbol symbol) const;
+        Slot& get(Symbol symbol);
+
+    private:
+        static constexpr std::size_t ChunkSize = 1024;
+        static constexpr std::size_t MaxChunks = 4096;
+        std::array<std::atomic<Slot*>, MaxChunks> chunks{};
+    };
+
+    static std::int64_t take(IngredientSlot& slot, unsigned units);  ///< Units left, or -1 on a shortfall.
+    void give(IngredientSlot& slot, unsigned units);
+    void reconcile(IngredientSlot& slot);
+
+    SymbolSlots<IngredientSlot> ingredients;
+    SymbolSlots<DishSlot> dishes;
+};
+
+#endif // INGREDIENT_STOCK_H
@@ -0,0 +1,16 @@
+#ifndef JOURNAL_EXCEPTION_H
+#define JOURNAL_EXCEPTION_H
+
+#include "MenuException.h"
+
+// Exception class to handle errors of the menu change journal
+// (I/O failures while appending or syncing, unreadable journal directories).
+class JournalException : public MenuException {
+public:
+    // Constructor to initialize the exception with an error message
+    // @param message: The error message describing the journal problem
+    explicit JournalException(const std::string& message)
+        : MenuException(message) {}  // Pass the message to the base class constructor
+};
+
+#endif // JOURNAL_EXCEPTION_H
@@ -0,0 +1,24 @@
+#ifndef JSONMENUDISPLAY_H
+#define JSONMENUDISPLAY_H
+
+
+#include "MenuDisplayStrategy.h"
+
+/**
+ * @brief Strategy encoding a menu as compact JSON, for kiosks and web clients.
+ *
+ * The layout is
+ *
+ *     {"categories":[{"name":"Lunch","dishes":[{"name":"Margherita Pizza","price":20,
+ *       "weight":350,"vegetarian":true,"ingredients":["Tomato","Mozzarella"]}]}]}
+ *
+ * without whitespace. Prices are numbers of RON with at most two decimals, exactly as
+ * stored; names are UTF-8 with quotes, backslashes and control characters escaped.
+ * The text is written straight into the renderer, without building a document first.
+ */
+class JsonMenuDisplay final : public MenuDisplayStrategy {
+public:
+    void encode(const Menu& menu, MenuRenderer& out) const override;
+};
+
+#endif
@@ -6,14 +6,28 @@
 class Lunch : public Menu {
 public:
     // Constructor that initializes the lunch menu with categories.
-    explicit Lunch(const std::vector<Category>& categories);
+    // The allocator selects the memory resource of the categories (the default heap if omitted).
+    explicit Lunch(std::pmr::vector<Category> categories, const allocator_type& allocator = {});
+
+    // Constructor that copies the categories from any other range (e.g., a std::vector<Category>).
+    template <ElementRange<Category> Categories>
+    explicit Lunch(Categories&& categories, const allocator_type& allocator = {})
+        : Lunch(toPmrVector<Category>(std::forward<Categories>(categories), allocator), allocator) {}
+
+    using Menu::isAvailableAt; // Keep the "HH:MM" string overload visible
 
     // Method to check if the menu is available at a specific time.
-    bool isAvailableAt(const std::string& time) const override;
+    bool isAvailableAt(TimeOfDay time) const override;
 
     // Method to print out the lunch menu.
     void print() const override;
 
+    // Renders the "Lunch Menu:" title printed before the categories.
+    void renderTitle(MenuRenderer& renderer) const override;
+
+    // Method to copy the lunch menu on the heap.
+    std::unique_ptr<Menu> clone() const override;
+
 protected:
     // Method to return the description of the lunch menu.
     std::string getDescription() const override;
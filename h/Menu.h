@@ -2,10 +2,26 @@
 #define MENU_H
 
 #include "Category.h"
+#include "DishOrdering.h"
+#include "ElementRange.h"
+#include "MenuEvent.h"
 #include "Subject.h" // Include Subject pentru integrarea Observer Pattern
+#include "TimeOfDay.h"
+#include "Money.h"
+#include <array>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include <iostream>
 
+class MenuRenderer;
+class ThreadPool;
+
 /**
  * @brief Abstract base class representing a Menu.
  *
@@ -13,20 +29,122 @@
  * and provides functionality to sort categories, calculate total price, and
  * check availability. It also extends Subject to support notifications for
  * changes, such as adding or removing categories.
+ *
+ * The categories and the name index use a polymorphic allocator that is passed down to
+ * every category and dish, so a menu built inside a MenuArena keeps its whole tree in
+ * the arena's buffer. Copies of a menu allocate from the default heap.
  */
 
 class Menu : public Subject {
+public:
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+private:
+    /**
+     * @brief Transparent hash so the name index can be queried with a std::string_view.
+     */
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    std::pmr::unordered_map<std::pmr::string, std::size_t, NameHash, std::equal_to<>> categoryIndex; /**< Category name -> slot in categories. */
+    std::array<std::uint32_t, 8> foodTypeCounts{}; /**< Number of categories containing each FoodType. */
+
+    /**
+     * @brief Process-unique id of a menu object; a copy gets a new id, assignment keeps the target's.
+     */
+    struct Identity {
+        std::uint64_t value = next();
+
+        Identity() = default;
+        Identity(const Identity&) : value(next()) {}
+        Identity(Identity&&) noexcept : value(next()) {}
+        Identity& operator=(const Identity&) { return *this; }
+        Identity& operator=(Identity&&) noexcept { return *this; }
+
+        static std::uint64_t next();
+    };
+
+    Identity identity; /**< Id carried by the events of this menu. */
+
+    /**
+     * @brief The sort whose CategoriesSorted event is being delivered; set only during that call, never copied.
+     */
+    struct SortInProgress {
+        const DishOrdering* ordering = nullptr;                /**< Null when the sort replays recorded positions. */
+        std::span<const std::vector<DishOrdering::Key>> keys;  /**< The sorted keys of each category, in the new category order. */
+
+        SortInProgress() = default;
+        SortInProgress(const SortInProgress&) noexcept {}
+        SortInProgress& operator=(const SortInProgress&) noexcept { return *this; }
+    };
+
+    SortInProgress sorting; /**< Read by synchronous observers through sortingBy() and sortedKeys(). */
+
+    /**
+     * @brief Adds or removes a category's food types from foodTypeCounts and rebuilds foodMask.
+     */
+    void countFoodTypes(FoodMask mask, int delta);
+
+    /**
+     * @brief Indexes the category just appended to categories and notifies observers.
+     * @throws DuplicateCategoryException If the name is already used; the category is removed again.
+     */
+    Category& registerLastCategory();
+
+    /**
+     * @brief Counts the food types of the dish just appended to a category and notifies observers.
+     * @param before The food mask of the category before the dish was added.
+     */
+    void registerLastDish(std::string_view categoryName, const Category& category, FoodMask before);
+
+    /**
+     * @brief Interns a category name for an event, only if an observer will receive it.
+     * @return The symbol, or MenuEvent::NoSymbol when nobody listens (so nothing is allocated).
+     */
+    [[nodiscard]] Symbol eventSymbol(std::string_view name) const;
+
+    /**
+     * @brief Stamps the event with the menu id and notifies the observers, if there are any.
+     */
+    void publish(MenuEvent event);
+
+    /**
+     * @brief Orders the categories by name, updates the name index and publishes CategoriesSorted.
+     *
+     * @param ordering The ordering the dishes were sorted by, or null for replayed positions.
+     * @param keys The sorted keys of each category, reordered here along with the categories.
+     */
+    void sortCategoriesByName(const DishOrdering* ordering, std::vector<std::vector<DishOrdering::Key>>& keys);
+
 protected:
-    std::vector<Category> categories; /**< A vector of Category objects representing the menu's sections. */
+    std::pmr::vector<Category> categories; /**< A vector of Category objects representing the menu's sections; read-only for derived classes so the index stays valid. */
+    FoodMask foodMask = 0; /**< Union of the food masks of all categories, kept in sync on every change. */
 
    public:
 
     /**
      * @brief Constructor that initializes a Menu with a list of categories.
      *
-     * @param categories A vector of Category objects that represent different sections of the menu.
+     * @param categories A vector of Category objects that represent different sections of the menu (moved into the menu).
+     * @param allocator The memory resource of the categories and the name index (the default heap if omitted).
+     * @throws DuplicateCategoryException If two categories share a name.
      */
-    explicit Menu(const std::vector<Category>& categories);
+    explicit Menu(std::pmr::vector<Category> categories, const allocator_type& allocator = {});
+
+    /**
+     * @brief Constructor that copies the categories from any other range (e.g., a std::vector<Category>).
+     *
+     * @param categories The sections of the menu; the categories of an rvalue container are moved.
+     * @param allocator The memory resource of the categories and the name index (the default heap if omitted).
+     * @throws DuplicateCategoryException If two categories share a name.
+     */
+    template <ElementRange<Category> Categories>
+    explicit Menu(Categories&& categories, const allocator_type& allocator = {})
+        : Menu(toPmrVector<Category>(std::forward<Categories>(categories), allocator), allocator) {}
 
     /**
      * @brief Pure virtual function to check if the menu is available at a specific time.
@@ -34,7 +152,16 @@ protected:
      * @param time The time of day to check availability.
      * @return True if the menu is available at the specified time, false otherwise.
      */
-    virtual bool isAvailableAt(const std::string& time) const = 0;
+    virtual bool isAvailableAt(TimeOfDay time) const = 0;
+
+    /**
+     * @brief Parses a time in "HH:MM" format and checks availability.
+     *
+     * @param time The time of day to check availability (e.g., "12:30").
+     * @return True if the menu is available at the specified time, false otherwise.
+     * @throws InvalidTimeException If the time is not in "HH:MM" format.
+     */
+    bool isAvailableAt(const std::string& time) const;
 
     /**
      * @brief Pure virtual function for printing the details of the menu.
@@ -43,37 +170,243 @@ protected:
      */
     virtual void print() const = 0;
 
+    /**
+     * @brief Renders the title that print() writes before the categories; none by default.
+     *
+     * @param renderer The renderer to append the title to.
+     */
+    virtual void renderTitle(MenuRenderer& renderer) const;
+
+    /**
+     * @brief Returns a heap copy of the menu with its dynamic type, e.g., to edit a published menu.
+     *
+     * The copy starts with no observers and gets a new id, like any copy of a menu.
+     */
+    [[nodiscard]] virtual std::unique_ptr<Menu> clone() const = 0;
+
+    /**
+     * @brief Categories with at least this many dishes are cut into one run per worker by the parallel sortCategories().
+     */
+    static constexpr std::size_t ParallelSortThreshold = 16 * 1024;
+
     /**
      * @brief Sorts the categories of the menu and their respective dishes alphabetically.
+     *
+     * The sort is stable: dishes with the same name keep their order.
+     * Observers receive a CategoriesSorted event.
      */
     void sortCategories();
 
     /**
-     * @brief Adds a new category to the menu and notifies observers.
-     * @param category The category to add.
+     * @brief Sorts the categories by name and the dishes of each category by an ordering.
+     *
+     * Observers receive a CategoriesSorted event.
+     *
+     * @param ordering The keys to sort the dishes by (e.g., price, then popularity).
+     * @throws Whatever the ordering's popularity function throws; the dishes are then left unchanged.
+     */
+    void sortCategories(const DishOrdering& ordering);
+
+    /**
+     * @brief Sorts like sortCategories(ordering), spreading the work over the workers of a pool.
+     *
+     * Each category is sorted by its own task. A category of at least ParallelSortThreshold
+     * dishes is cut into one run per worker: the runs are sorted by separate tasks, then
+     * merged pairwise, also in parallel. The result is the same as the sequential sort.
+     * Must not be called from inside a task of the pool.
+     *
+     * @param pool The workers to sort on.
+     * @param ordering The keys to sort the dishes by.
+     * @throws Whatever the ordering's popularity function throws; the dishes are then left unchanged.
+     */
+    void sortCategories(ThreadPool& pool, const DishOrdering& ordering = DishOrdering());
+
+    /**
+     * @brief Moves the dishes of each category as a recorded sort did, then sorts the categories by name.
+     *
+     * Replays a sort whose order cannot be computed again, e.g., one by popularity.
+     * Observers receive a CategoriesSorted event.
+     *
+     * @param positions One list per category, in name order: the dish at positions[c][i] goes to slot i.
+     * @throws std::invalid_argument If a list is not a permutation of its category's slots; nothing moves then.
+     */
+    void reorderDishes(std::span<const std::vector<std::uint32_t>> positions);
+
+    /**
+     * @brief Returns the ordering of the sort whose CategoriesSorted event is being delivered.
+     *
+     * Only a synchronous observer can use it, from its update() for that event. Recording
+     * the keys (or, when the order depends on more than the dishes, sortedKeys()) is
+     * enough to replay the sort, without copying any dish.
+     *
+     * @return The ordering, or nullptr outside of that event and for reorderDishes().
+     */
+    [[nodiscard]] const DishOrdering* sortingBy() const;
+
+    /**
+     * @brief Returns the sorted keys of a category while its CategoriesSorted event is delivered.
+     *
+     * @param slot The category's slot in getCategory().
+     * @return The keys; the dish now at slot i came from slot keys[i].position. Empty outside of that event.
      */
-    void addCategory(const Category& category);
+    [[nodiscard]] std::span<const DishOrdering::Key> sortedKeys(std::size_t slot) const;
 
     /**
-     * @brief Removes a category from the menu by name and notifies observers.
-     * @param categoryName The name of the category to remove.
+     * @brief Adds a new category to the menu and notifies observers, in O(1) amortized.
+     * @param category The category to add (moved in; pass an rvalue to avoid copying its dishes).
+     * @throws DuplicateCategoryException If the menu already has a category with that name.
      */
-    void removeCategory(const std::string& categoryName);
+    void addCategory(Category category);
 
     /**
-     * @brief Returns the categories of the menu.
+     * @brief Constructs a category in place at the end of the menu and notifies observers.
+     *
+     * The category is read-only: its dishes change through the menu, which notifies observers.
      *
-     * @return A vector of Category objects representing the menu's sections.
+     * @param args The arguments of a Category constructor.
+     * @return The new category, valid until the menu changes.
+     * @throws DuplicateCategoryException If the menu already has a category with that name.
+     */
+    template <typename... Args>
+    const Category& emplaceCategory(Args&&... args) {
+        categories.emplace_back(std::forward<Args>(args)...);
+        return registerLastCategory();
+    }
+
+    /**
+     * @brief Constructs a dish in place at the end of a category and notifies observers with a DishAdded event.
+     * @param categoryName The name of the category.
+     * @param args The arguments of a Dish constructor.
+     * @return The new dish, or nullptr if the menu has no category with that name; valid until the menu changes.
      */
-    std::vector<Category> getCategory() const;
+    template <typename... Args>
+    const Dish* emplaceDish(std::string_view categoryName, Args&&... args) {
+        const auto it = categoryIndex.find(categoryName);
+        if (it == categoryIndex.end()) {
+            return nullptr;
+        }
+        Category& category = categories[it->second];
+        const FoodMask before = category.getFoodMask();
+        const Dish& dish = category.emplaceDish(std::forward<Args>(args)...);
+        registerLastDish(categoryName, category, before);
+        return &dish;
+    }
+
+    /**
+     * @brief Removes a category from the menu by name and notifies observers, in O(1).
+     *
+     * The last category takes the slot of the removed one, so the order of the
+     * remaining categories may change.
+     *
+     * @param categoryName The name of the category to remove; nothing happens if it is missing.
+     */
+    void removeCategory(std::string_view categoryName);
+
+    /**
+     * @brief Adds a dish to a category and notifies observers with a DishAdded event.
+     * @param categoryName The name of the category.
+     * @param dish The dish to add (moved in).
+     * @return false if the menu has no category with that name.
+     */
+    bool addDish(std::string_view categoryName, Dish dish);
+
+    /**
+     * @brief Removes a dish from a category and notifies observers with a DishRemoved event.
+     * @param categoryName The name of the category.
+     * @param dishName The name of the dish.
+     * @return false if the dish is not found.
+     */
+    bool removeDish(std::string_view categoryName, std::string_view dishName);
+
+    /**
+     * @brief Changes the price of a dish and notifies observers with a PriceChanged event.
+     * @param categoryName The name of the category.
+     * @param dishName The name of the dish.
+     * @param newPrice The new price.
+     * @return false if the dish is not found.
+     */
+    bool updateDishPrice(std::string_view categoryName, std::string_view dishName, Money newPrice);
+
+    /**
+     * @brief Returns the id of the menu object, carried by its events.
+     */
+    [[nodiscard]] std::uint64_t getId() const {
+        return identity.value;
+    }
+
+    /**
+     * @brief Looks up a category by name, in O(1).
+     * @param categoryName The name of the category.
+     * @return The category, or nullptr if the menu has none with that name; valid until the menu changes.
+     */
+    [[nodiscard]] const Category* findCategory(std::string_view categoryName) const;
+
+    /**
+     * @brief Looks up a dish inside a category.
+     *
+     * Takes no lock, so concurrent readers of a published menu never contend: the category
+     * comes from the name index and the dish name from the symbol table's lock-free lookup.
+     *
+     * @param categoryName The name of the category.
+     * @param dishName The name of the dish.
+     * @return The dish, or nullptr if it is not found; valid until the menu changes.
+     */
+    [[nodiscard]] const Dish* findDish(std::string_view categoryName, std::string_view dishName) const;
+
+    /**
+     * @brief Looks up a dish in every category of the menu.
+     * @param dishName The name of the dish.
+     * @return The first dish with that name, or nullptr if it is not found; valid until the menu changes.
+     */
+    [[nodiscard]] const Dish* findDish(std::string_view dishName) const;
+
+    /**
+     * @brief Returns the categories of the menu without copying them.
+     *
+     * @return The menu's sections, valid until the menu changes.
+     */
+    std::span<const Category> getCategory() const;
+
+    /**
+     * @brief Returns the allocator of the menu, shared by its categories and dishes.
+     */
+    [[nodiscard]] allocator_type get_allocator() const {
+        return categories.get_allocator();
+    }
+
+    /**
+     * @brief Returns the food types found in any dish of the menu.
+     */
+    [[nodiscard]] FoodMask getFoodMask() const;
+
+    /**
+     * @brief Checks if every dish of the menu is vegetarian, in O(1).
+     */
+    [[nodiscard]] bool isVegetarian() const;
+
+    /**
+     * @brief Returns the dishes of every category matching a dietary constraint.
+     *
+     * @param filter The constraint to check (e.g., DietaryFilter::vegetarian() & DietaryFilter::glutenFree()).
+     * @return Pointers to the matching dishes, valid until the menu changes.
+     */
+    [[nodiscard]] std::vector<const Dish*> filter(DietaryFilter filter) const;
 
     /**
      * @brief Static function to calculate the total price of a list of ordered dishes.
      *
      * @param orderedDishes A vector of Dish objects representing the dishes ordered by the customer.
-     * @return The total price of the ordered dishes.
+     * @return The exact total price of the ordered dishes.
      */
-    static float calculateTotalPrice(const std::vector<Dish>& orderedDishes);
+    static Money calculateTotalPrice(std::span<const Dish> orderedDishes);
+
+    /**
+     * @brief Totals a batch of order line prices with the fastest kernel available (see PriceTotals).
+     *
+     * @param linePrices The prices of the order lines.
+     * @return The exact total price.
+     */
+    static Money calculateTotalPrice(std::span<const Money> linePrices);
 
     /**
      * @brief Overloaded stream insertion operator to print the Menu details.
@@ -88,6 +421,21 @@ protected:
 
     virtual ~Menu() = default; /**< Virtual destructor. */
 
+protected:
+    Menu(const Menu&) = default;
+    Menu(Menu&&) noexcept = default;
+    Menu& operator=(const Menu&) = default;
+    Menu& operator=(Menu&&) noexcept = default;
+
+public:
+
+    /**
+     * @brief Check that the time is one of the menu opening times (08:00, 12:00 or 18:00).
+     * @param time The time to check.
+     * @throws InvalidTimeException If the time is not an opening time.
+     */
+    static void checkAvailability(TimeOfDay time);
+
     /**
      * @brief Check the availability of the menu based on the time.
      * @param time The time to check (e.g., "12:00").
@@ -0,0 +1,120 @@
+#ifndef MENU_ARENA_H
+#define MENU_ARENA_H
+
+#include "Category.h"
+#include "Menu.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @class MenuArena
+ * @brief Owns a monotonic buffer holding whole Menu trees.
+ *
+ * A menu created by the arena gets the arena's allocator, which the pmr containers
+ * pass down to every category and dish. Building the tree is therefore a sequence of
+ * pointer bumps inside a few large blocks, the tree sits contiguously in memory, and
+ * tearing it down frees those blocks at once instead of every string and vector.
+ *
+ * Memory given back by a menu (e.g., when a vector grows) is only reclaimed when the
+ * arena is reset or destroyed, so reserve the categories before filling them. Copies
+ * of an arena menu made with the regular copy constructors live on the heap.
+ */
+class MenuArena {
+public:
+    static constexpr std::size_t DefaultInitialBytes = 64u << 10; ///< Size of the first block.
+
+    /**
+     * @brief Creates an empty arena.
+     *
+     * @param initialBytes The size of the first block requested from the heap; later blocks grow geometrically.
+     */
+    explicit MenuArena(std::size_t initialBytes = DefaultInitialBytes);
+
+    /**
+     * @brief Destroys every menu of the arena and frees its blocks.
+     */
+    ~MenuArena();
+
+    // The menus hold pointers to the buffer, so the arena cannot be copied or moved
+    MenuArena(const MenuArena&) = delete;
+    MenuArena& operator=(const MenuArena&) = delete;
+
+    /**
+     * @brief Constructs a menu inside the arena.
+     *
+     * @tparam MenuT Breakfast, Lunch or Dinner.
+     * @param categories The categories of the menu; copied into the arena unless they already use its allocator.
+     * @return The new menu, valid until the arena is reset or destroyed.
+     * @throws DuplicateCategoryException If two categories share a name.
+     */
+    template <typename MenuT>
+    MenuT& emplaceMenu(std::pmr::vector<Category> categories = {}) {
+        static_assert(std::is_base_of_v<Menu, MenuT>, "MenuArena only holds menus");
+        menus.reserve(menus.size() + 1);  // Nothing can throw once the menu exists
+        MenuT* menu = allocator().new_object<MenuT>(std::move(categories));
+        menus.push_back(menu);
+        return *menu;
+    }
+
+    /**
+     * @brief Deep-copies a menu, with all its categories and dishes, into the arena.
+     *
+     * @param menu The menu to copy; it may live on the heap or in another arena.
+     * @return The copy, valid until the arena is reset or destroyed.
+     */
+    template <typename MenuT>
+    MenuT& copyMenu(const MenuT& menu) {
+        const auto categories = menu.getCategory();
+        return emplaceMenu<MenuT>(std::pmr::vector<Category>(categories.begin(), categories.end(), allocator()));
+    }
+
+    /**
+     * @brief Destroys every menu and gives the blocks back to the heap, so the arena can hold the next menu.
+     */
+    void reset();
+
+    /**
+     * @brief Returns the allocator to pass to categories and dishes built for this arena.
+     */
+    [[nodiscard]] Menu::allocator_type allocator() {
+        return Menu::allocator_type(&buffer);
+    }
+
+    /**
+     * @brief Returns the menus of the arena, in creation order.
+     */
+    [[nodiscard]] const std::vector<Menu*>& getMenus() const {
+        return menus;
+    }
+
+    /**
+     * @brief Returns the bytes currently obtained from the heap, including the unused end of the last block.
+     */
+    [[nodiscard]] std::size_t reservedBytes() const {
+        return upstream.bytes;
+    }
+
+private:
+    /**
+     * @brief Forwards to the default heap and keeps track of the bytes it hands out.
+     */
+    struct CountingResource : std::pmr::memory_resource {
+        std::size_t bytes = 0;
+
+        void* do_allocate(std::size_t size, std::size_t alignment) override;
+        void do_deallocate(void* memory, std::size_t size, std::size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    void destroyMenus();
+
+    CountingResource upstream;                 ///< Source of the blocks.
+    std::pmr::monotonic_buffer_resource buffer; ///< Bump-pointer allocator over the blocks.
+    std::vector<Menu*> menus;                  ///< Menus to destroy before the blocks are freed.
+};
+
+#endif // MENU_ARENA_H
@@ -3,6 +3,8 @@
 
 #include "Observer.h"
 #include <iostream>
+#include <span>
+#include <string>
 
 /**
  * @brief A concrete observer that logs menu changes.
@@ -12,17 +14,38 @@
  * to the console.
  */
 class MenuChangeLogger : public Observer {
+private:
+    std::string lines; ///< Text being written, reused so logging rarely allocates.
+
 public:
     /**
      * @brief Reacts to notifications from the subject.
      *
      * This method is called whenever the subject notifies its observers.
-     * It logs the message describing the change.
+     * It logs a description of the change.
+     *
+     * @param event The change to log.
+     */
+    void update(const MenuEvent& event) override {
+        lines.assign("[MenuChangeLogger] ");
+        event.formatTo(lines);
+        lines += '\n';
+        std::cout << lines;  // One insertion and no flush per event; std::cout flushes when needed
+    }
+
+    /**
+     * @brief Logs a batch of notifications with a single write and a single flush.
      *
-     * @param message The notification message describing the change.
+     * @param events The changes to log, oldest first.
      */
-    void update(const std::string& message) override {
-        std::cout << "[MenuChangeLogger] " << message << std::endl;
+    void updateBatch(std::span<const MenuEvent> events) override {
+        lines.clear();
+        for (const auto& event : events) {
+            lines += "[MenuChangeLogger] ";
+            event.formatTo(lines);
+            lines += '\n';
+        }
+        std::cout << lines << std::flush;
     }
 };
 
@@ -3,28 +3,72 @@
 #define MENUCONTEXT_H
 
 
+#include "BinaryMenuDisplay.h"
+#include "JsonMenuDisplay.h"
 #include "MenuDisplayStrategy.h"
+#include "TextMenuDisplay.h"
+#include <cstdint>
+
+/**
+ * @brief The wire formats a MenuContext can select at runtime.
+ */
+enum class MenuFormat : std::uint8_t {
+    Text,   ///< TextMenuDisplay
+    Json,   ///< JsonMenuDisplay
+    Binary, ///< BinaryMenuDisplay
+};
 
 /**
  * @brief The menu context that uses a display strategy.
  */
 class MenuContext {
 private:
-    MenuDisplayStrategy* strategy;  ///< The current display strategy
+    const MenuDisplayStrategy* strategy;  ///< The current display strategy
 
 public:
-   explicit MenuContext(MenuDisplayStrategy* initialStrategy)
+   explicit MenuContext(const MenuDisplayStrategy* initialStrategy)
         : strategy(initialStrategy) {}
 
     // Change the display strategy
-    void setStrategy(MenuDisplayStrategy* newStrategy) {
+    void setStrategy(const MenuDisplayStrategy* newStrategy) {
         strategy = newStrategy;
     }
 
+    // Select the strategy of a wire format (e.g., from a kiosk's request)
+    void setFormat(MenuFormat format) {
+        static const TextMenuDisplay text;
+        static const JsonMenuDisplay json;
+        static const BinaryMenuDisplay binary;
+        switch (format) {
+            case MenuFormat::Text:
+                strategy = &text;
+                break;
+            case MenuFormat::Json:
+                strategy = &json;
+                break;
+            case MenuFormat::Binary:
+                strategy = &binary;
+                break;
+        }
+    }
+
     // Display the menu using the current strategy
     void displayMenu(const std::string& menuName) const {
         strategy->display(menuName);  ///< Call the display() method from the current strategy
     }
+
+    // Encode a menu with the current strategy into a caller-provided renderer
+    // One virtual call for the whole menu; the strategy loops over the dishes itself
+    void encodeMenu(const Menu& menu, MenuRenderer& out) const {
+        strategy->encode(menu, out);
+    }
+
+    // Encode a menu with the current strategy and write it to a sink at once
+    void displayMenu(const Menu& menu, RenderSink& sink) const {
+        MenuRenderer& renderer = MenuRenderer::local();
+        strategy->encode(menu, renderer);
+        renderer.flushTo(sink);
+    }
 };
 
 #endif
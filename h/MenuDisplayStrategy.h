@@ -3,11 +3,17 @@
 
 
 
+#include "Menu.h"
+#include "MenuRenderer.h"
+#include <iostream>
 #include <string>
 
 /**
  * @brief Interface for menu display strategy.
  * Each menu type will implement this interface to display dishes in a specific way.
+ *
+ * A strategy encodes a whole menu per call, so choosing the strategy costs one
+ * virtual call per menu, never one per dish.
  */
 class MenuDisplayStrategy {
 public:
@@ -18,7 +24,21 @@ public:
      *
      * @param menuName The name of the menu (e.g., "Breakfast", "Lunch", "Dinner").
      */
-    virtual void display(const std::string& menuName) const = 0;
+    virtual void display(const std::string& menuName) const {
+        std::cout << "Displaying " << menuName << " menu\n";
+    }
+
+    /**
+     * @brief Appends the whole menu to a caller-provided renderer, in the strategy's format.
+     *
+     * The plain-text listing of print() by default.
+     *
+     * @param menu The menu to encode.
+     * @param out The renderer to append to; nothing is written to a sink.
+     */
+    virtual void encode(const Menu& menu, MenuRenderer& out) const {
+        out.menuListing(menu);
+    }
 };
 
 #endif
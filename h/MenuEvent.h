@@ -0,0 +1,56 @@
+#ifndef MENU_EVENT_H
+#define MENU_EVENT_H
+
+#include "Money.h"
+#include "SymbolTable.h"
+#include <cstdint>
+#include <limits>
+#include <string>
+
+/**
+ * @brief The kind of change a MenuEvent describes.
+ */
+enum class MenuEventKind : std::uint8_t {
+    CategoryAdded,
+    CategoryRemoved,
+    CategoriesSorted,
+    DishAdded,
+    DishRemoved,
+    PriceChanged,
+};
+
+/**
+ * @brief Typed description of one change of a Menu, sent to its observers.
+ *
+ * Names are carried as interned symbols and prices as Money, so an event is a small
+ * trivially copyable value: building, queuing and copying it never allocates. Observers
+ * that need text call formatTo() or toString().
+ */
+struct MenuEvent {
+    static constexpr Symbol NoSymbol = std::numeric_limits<Symbol>::max(); ///< Marks an unused name field.
+    static constexpr std::uint32_t NoIndex = std::numeric_limits<std::uint32_t>::max(); ///< Marks an unused dishIndex.
+
+    MenuEventKind kind = MenuEventKind::CategoryAdded;
+    std::uint64_t menuId = 0;    ///< Menu::getId() of the changed menu.
+    Symbol category = NoSymbol;  ///< The category concerned, if any.
+    Symbol dish = NoSymbol;      ///< The dish concerned, for the dish and price events.
+    std::uint32_t dishIndex = NoIndex; ///< Slot of that dish in its category: where it was added, repriced or removed from.
+    Money oldPrice{};            ///< The price before a PriceChanged event.
+    Money newPrice{};            ///< The price after a PriceChanged event, or of the added dish.
+
+    /**
+     * @brief Appends a readable description (e.g., "Category added: Pancakes") to a string.
+     *
+     * @param out The string to append to; reusing it across events avoids reallocations.
+     */
+    void formatTo(std::string& out) const;
+
+    /**
+     * @brief Returns the readable description of the event.
+     */
+    [[nodiscard]] std::string toString() const;
+
+    bool operator==(const MenuEvent&) const = default;
+};
+
+#endif // MENU_EVENT_H
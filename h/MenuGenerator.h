@@ -0,0 +1,147 @@
+#ifndef MENU_GENERATOR_H
+#define MENU_GENERATOR_H
+
+#include "Category.h"
+#include "Dish.h"
+#include "Ingredient.h"
+#include "Money.h"
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Inclusive range of integers sampled uniformly.
+ */
+struct UniformRange {
+    std::uint32_t min; ///< Smallest value.
+    std::uint32_t max; ///< Largest value.
+};
+
+/**
+ * @brief Distributions used by MenuGenerator.
+ *
+ * The defaults describe a mid-sized restaurant; benchmarks and soak tests tune them.
+ */
+struct GeneratorConfig {
+    std::uint64_t seed = 2024;                         ///< Same seed, same catalog, on every platform.
+    UniformRange dishesPerCategory{5, 40};             ///< Dishes in each generated category.
+    UniformRange ingredientsPerDish{1, 6};             ///< Ingredients in each generated dish.
+    UniformRange nameLength{6, 18};                    ///< Length of dish names, in characters.
+    Money minPrice = 5.0;                              ///< Cheapest dish.
+    Money maxPrice = 120.0;                            ///< Most expensive dish.
+    std::uint32_t categoriesPerMenu = 8;               ///< Categories in each generated menu.
+    std::uint32_t distinctDishNames = 1u << 16;        ///< Dish names are drawn from this many distinct names.
+    std::uint32_t distinctIngredients = 512;           ///< Size of the ingredient pantry.
+    /// Relative frequency of each FoodType in the pantry, indexed by FoodType.
+    std::array<std::uint32_t, 7> foodTypeWeights = {30, 12, 18, 10, 10, 8, 12};
+};
+
+/**
+ * @class MenuGenerator
+ * @brief Deterministic, seeded generator of synthetic restaurant catalogs.
+ *
+ * Produces Ingredient, Dish, Category and Breakfast/Lunch/Dinner objects following the
+ * distributions of a GeneratorConfig. The random stream is a SplitMix64 sequence, so a
+ * given seed yields the same catalog with every compiler and standard library.
+ *
+ * Names are drawn from bounded pools, so the SymbolTable stops growing once every
+ * name has been seen, and the streaming functions hand out one object at a time:
+ * generating tens of millions of dishes needs memory for a single category only.
+ */
+class MenuGenerator {
+public:
+    /**
+     * @brief Creates a generator; the ingredient pantry is built once from the config.
+     */
+    explicit MenuGenerator(const GeneratorConfig& config = {});
+
+    /**
+     * @brief Returns a random ingredient from the pantry.
+     */
+    Ingredient nextIngredient();
+
+    /**
+     * @brief Returns a new dish following the configured distributions.
+     */
+    Dish nextDish();
+
+    /**
+     * @brief Returns a new category with a random number of dishes.
+     */
+    Category nextCategory();
+
+    /**
+     * @brief Returns a new category with exactly the given number of dishes.
+     */
+    Category nextCategory(std::size_t dishes);
+
+    /**
+     * @brief Returns a menu of the given type (Breakfast, Lunch or Dinner) with categoriesPerMenu categories.
+     */
+    template <typename MenuT>
+    MenuT nextMenu() {
+        std::pmr::vector<Category> categories;
+        categories.reserve(config.categoriesPerMenu);
+        for (std::uint32_t i = 0; i < config.categoriesPerMenu; ++i) {
+            categories.push_back(nextCategory());
+        }
+        return MenuT(std::move(categories));
+    }
+
+    /**
+     * @brief Returns a menu of the given type holding exactly totalDishes dishes.
+     *
+     * @param totalDishes The number of dishes in the menu.
+     * @param dishesPerCategory The size of every category except possibly the last one.
+     */
+    template <typename MenuT>
+    MenuT nextMenu(std::size_t totalDishes, std::size_t dishesPerCategory) {
+        std::pmr::vector<Category> categories;
+        streamCategories(totalDishes, dishesPerCategory, [&](Category&& category) {
+            categories.push_back(std::move(category));
+        });
+        return MenuT(std::move(categories));
+    }
+
+    /**
+     * @brief Generates dishes one at a time and hands each to the sink.
+     *
+     * @param count The number of dishes to generate.
+     * @param sink Receives every dish; the generator keeps no reference to it.
+     */
+    void streamDishes(std::size_t count, const std::function<void(Dish&&)>& sink);
+
+    /**
+     * @brief Generates categories until totalDishes dishes were produced.
+     *
+     * @param totalDishes The number of dishes to generate across all categories.
+     * @param dishesPerCategory The category size; 0 samples it from the config for each category.
+     * @param sink Receives every category; only one category is alive at a time.
+     * @return The number of categories produced.
+     */
+    std::size_t streamCategories(std::size_t totalDishes, std::size_t dishesPerCategory,
+                                 const std::function<void(Category&&)>& sink);
+
+    /**
+     * @brief Returns the configuration the generator was created with.
+     */
+    [[nodiscard]] const GeneratorConfig& getConfig() const {
+        return config;
+    }
+
+private:
+    GeneratorConfig config;
+    std::uint64_t state;                 ///< SplitMix64 state.
+    std::vector<Ingredient> pantry;      ///< Pool every dish picks its ingredients from.
+    std::uint64_t categoriesGenerated = 0;
+
+    std::uint64_t next();
+    std::uint32_t uniform(UniformRange range);
+    FoodType sampleFoodType();
+    std::string dishName(std::uint32_t index) const;
+};
+
+#endif // MENU_GENERATOR_H
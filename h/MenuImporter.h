@@ -0,0 +1,114 @@
+#ifndef MENU_IMPORTER_H
+#define MENU_IMPORTER_H
+
+#include "Category.h"
+#include "Dish.h"
+#include "InvalidDishException.h"
+#include <cstddef>
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Layout of the rows read by MenuImporter.
+ *
+ * Csv: one dish per line, `category,dish,price,weight,ingredients`, where ingredients is
+ * `name:TYPE;name:TYPE` (TYPE is a FoodType name such as VEGETABLE or MEAT). Fields may be
+ * double-quoted, with "" as an escaped quote.
+ *
+ * JsonLines: one JSON object per line with the keys category, dish, price, weight and
+ * ingredients (an array of {"name": ..., "type": ...}). A JSON array export that keeps
+ * one object per line is accepted too: the brackets and trailing commas are skipped.
+ *
+ * In both formats a record may not span several lines; this is what allows the
+ * input to be cut into chunks at any newline.
+ */
+enum class ImportFormat {
+    Csv,
+    JsonLines,
+};
+
+/**
+ * @brief Settings of a MenuImporter.
+ */
+struct ImportOptions {
+    ImportFormat format = ImportFormat::Csv;
+    bool csvHeader = true;               ///< Skip the first line of CSV input.
+    std::size_t chunkSize = 4u << 20;    ///< Bytes read per chunk; a chunk always ends at a newline.
+    unsigned threads = 0;                ///< Chunks parsed at once; 0 uses every core.
+    std::size_t maxErrors = 1000;        ///< Row errors kept in the report; later ones are only counted.
+};
+
+/**
+ * @brief Outcome of an import.
+ */
+struct ImportReport {
+    std::size_t bytes = 0;      ///< Bytes read from the input.
+    std::size_t lines = 0;      ///< Lines read, including the header and blank lines.
+    std::size_t dishes = 0;     ///< Rows turned into dishes.
+    std::size_t rejected = 0;   ///< Rows skipped because of an error.
+    double seconds = 0;         ///< Wall time of the import.
+    std::vector<InvalidDishException> errors; ///< The first maxErrors row errors, as "line N: reason".
+
+    /**
+     * @brief Returns the import throughput in MB/s (1 MB = 10^6 bytes).
+     */
+    [[nodiscard]] double megabytesPerSecond() const {
+        return seconds > 0 ? static_cast<double>(bytes) / 1e6 / seconds : 0;
+    }
+};
+
+/**
+ * @class MenuImporter
+ * @brief Streaming importer of dishes from CSV or JSON Lines exports.
+ *
+ * The input is read in chunks cut at newlines; a batch of chunks (one per thread)
+ * is parsed in parallel into Dish objects, then the dishes are handed to the sink
+ * in file order before the next batch is read. Memory use is bounded by
+ * threads * chunkSize plus the dishes of one batch, whatever the file size.
+ *
+ * A malformed row does not stop the import: it is reported in ImportReport::errors
+ * as an InvalidDishException carrying its line number and the load goes on.
+ */
+class MenuImporter {
+public:
+    /**
+     * @brief Receives every imported dish together with the name of its category.
+     */
+    using DishSink = std::function<void(std::string_view category, Dish&& dish)>;
+
+    explicit MenuImporter(const ImportOptions& options = {});
+
+    /**
+     * @brief Imports every row of a stream.
+     *
+     * @param input The CSV or JSON Lines text.
+     * @param sink Receives the dishes in input order.
+     * @return The statistics and row errors of the import.
+     */
+    ImportReport importDishes(std::istream& input, const DishSink& sink) const;
+
+    /**
+     * @brief Imports every row of a file.
+     *
+     * @throws MenuException If the file cannot be opened.
+     */
+    ImportReport importDishes(const std::string& path, const DishSink& sink) const;
+
+    /**
+     * @brief Imports a file and groups the dishes by category, in order of first appearance.
+     *
+     * @param path The file to read.
+     * @param report Receives the statistics and row errors of the import.
+     * @return The imported categories.
+     * @throws MenuException If the file cannot be opened.
+     */
+    std::pmr::vector<Category> importCategories(const std::string& path, ImportReport& report) const;
+
+private:
+    ImportOptions options;
+};
+
+#endif // MENU_IMPORTER_H
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <iostream>
+#include <utility>
 
 /**
  * @brief Template class for managing a menu inventory.
@@ -19,10 +20,27 @@ private:
 public:
     /**
      * @brief Adds a menu to the inventory.
-     * @param menu The menu object to add.
+     * @param menu The menu object to add (moved in; pass an rvalue to avoid copying its categories).
      */
-    void addMenu(const T& menu) {
-        menus.push_back(menu);
+    void addMenu(T menu) {
+        menus.push_back(std::move(menu));
+    }
+
+    /**
+     * @brief Constructs a menu in place at the end of the inventory.
+     * @param args The arguments of a T constructor (e.g., the categories).
+     * @return The new menu, valid until the inventory changes.
+     */
+    template <typename... Args>
+    T& emplaceMenu(Args&&... args) {
+        return menus.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Returns the menus of the inventory without copying them.
+     */
+    const std::vector<T>& getMenus() const {
+        return menus;
     }
 
     /**
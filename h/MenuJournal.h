@@ -0,0 +1,177 @@
+#ifndef MENU_JOURNAL_H
+#define MENU_JOURNAL_H
+
+#include "Menu.h"
+#include "MenuEvent.h"
+#include "Observer.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Settings of a MenuJournal.
+ */
+struct JournalOptions {
+    std::size_t groupCommitBytes = 64u << 10;                    ///< Buffered bytes that wake the writer before the delay ends.
+    std::chrono::milliseconds groupCommitDelay{2};               ///< Longest time a record waits in memory before it is written.
+    unsigned syncEveryWrites = 1;                                ///< fsync after this many group writes; 0 syncs only in commit() and compact().
+    std::uint64_t compactAfterBytes = std::uint64_t{64} << 20;  ///< Journal size after which the writer thread compacts it; 0 disables.
+};
+
+/**
+ * @brief Result of MenuJournal::recover().
+ */
+struct JournalRecovery {
+    std::unique_ptr<Menu> menu;     ///< The rebuilt menu, or nullptr if the directory holds no snapshot.
+    std::uint64_t generation = 0;   ///< Generation of the snapshot and journal that were read.
+    std::size_t records = 0;        ///< Journal records replayed on top of the snapshot.
+    std::size_t discardedBytes = 0; ///< Bytes of a torn or corrupt tail that were ignored.
+};
+
+/**
+ * @class MenuJournal
+ * @brief Durable write-ahead journal of the changes of one menu.
+ *
+ * The journal directory holds generations: `snapshot-N.menusnap` is a MenuSnapshot
+ * of the menu and `journal-N.log` the binary records of every change made after it.
+ * Creating a MenuJournal writes a new generation from the current state; compaction
+ * starts the next one later, so the journal never grows without bound, and removes
+ * the older generations. recover() maps the newest snapshot and replays its journal.
+ *
+ * The journal is a synchronous observer, because a record must capture the menu
+ * as it is right after the change (e.g., the dishes of an added category). A sort is
+ * recorded as its keys and replayed by sorting again; only when the order depends on
+ * more than the dishes (a popularity key) does the record hold the slot each dish came
+ * from, 4 bytes per dish. Encoding a record is a memory copy; the file writes and
+ * fsyncs happen on a writer thread that groups the records of several changes into
+ * one write (group commit). A change is therefore durable only after the next sync;
+ * call commit() to wait for it.
+ * Compaction also runs on the writer thread, once the journal reaches
+ * JournalOptions::compactAfterBytes: it rebuilds the state from the snapshot and the
+ * journal it wrote, never from the live menu, so changes do not wait for it. Its
+ * errors are reported by the next commit(), like those of the writes.
+ *
+ * A failed write or compaction is final, because the records it lost leave a gap that
+ * later records cannot be replayed across. From then on the journal takes no more
+ * records and writes nothing, and every commit() and compact() throws the error. The
+ * directory still recovers the changes made before the gap; to journal again, destroy
+ * this journal and create a new one, which starts from a fresh snapshot.
+ *
+ * Like the menu itself, the journal must be used from one thread at a time.
+ */
+class MenuJournal : public Observer {
+public:
+    /**
+     * @brief Starts journaling a menu in a directory, beginning with a snapshot of its current state.
+     *
+     * @param menu The menu to journal; it must outlive the journal.
+     * @param directory The journal directory, created if needed.
+     * @param options Group commit, sync and compaction settings.
+     * @throws JournalException If the directory or the first generation cannot be written.
+     */
+    MenuJournal(Menu& menu, std::string directory, const JournalOptions& options = {});
+
+    /**
+     * @brief Writes and syncs the remaining records, then stops the writer thread.
+     */
+    ~MenuJournal() override;
+
+    MenuJournal(const MenuJournal&) = delete;
+    MenuJournal& operator=(const MenuJournal&) = delete;
+
+    /**
+     * @brief Rebuilds a menu from the newest snapshot of a directory and the tail of its journal.
+     *
+     * Replay stops at the first torn or corrupt record, which is what a crash in the
+     * middle of a write leaves behind.
+     *
+     * @param directory The journal directory.
+     * @throws SnapshotException If the newest snapshot cannot be read.
+     */
+    static JournalRecovery recover(const std::string& directory);
+
+    /**
+     * @brief Appends the record of a change; called by the menu. Ignored once the writer has failed.
+     */
+    void update(const MenuEvent& event) override;
+
+    /**
+     * @brief Waits until every change made so far is written and synced.
+     * @throws JournalException If the writer thread failed, now or at any earlier time.
+     */
+    void commit();
+
+    /**
+     * @brief Starts a new generation holding every change made so far and removes the older ones.
+     *
+     * The writer thread compacts; this waits for it like commit().
+     *
+     * @throws JournalException If the snapshot or the new journal cannot be written, or the writer failed earlier.
+     */
+    void compact();
+
+    /**
+     * @brief Returns the generation the writer currently appends to.
+     */
+    [[nodiscard]] std::uint64_t generation() const;
+
+    [[nodiscard]] std::uint64_t records() const { return recordCount; }
+
+    /**
+     * @brief Returns the bytes appended since the last compaction started, header included.
+     */
+    [[nodiscard]] std::uint64_t journalBytes() const { return generationBytes; }
+
+    /**
+     * @brief Returns the number of file writes; each holds the records of one group commit.
+     */
+    [[nodiscard]] std::uint64_t writes() const;
+
+    /**
+     * @brief Returns the number of fsync calls.
+     */
+    [[nodiscard]] std::uint64_t syncs() const;
+
+private:
+    void encode(const MenuEvent& event);
+    void startGeneration(std::uint64_t generation);
+    void rotate();
+    void runWriter();
+    void rethrowWriterError();
+
+    Menu& menu;
+    const std::string directory;
+    const JournalOptions options;
+    std::uint64_t recordCount = 0;
+    std::uint64_t generationBytes = 0;  ///< Bytes appended since the last compaction request, header included.
+    std::vector<std::byte> record;      ///< Scratch buffer of the record being encoded.
+
+    // Shared with the writer thread, guarded by mutex
+    mutable std::mutex mutex;
+    std::condition_variable wakeWriter;
+    std::condition_variable written;
+    std::vector<std::byte> pending;     ///< Records waiting for the next group write.
+    std::uint64_t openRequest = 0;      ///< Generation whose journal the writer must switch to, or 0.
+    bool compactRequested = false;      ///< The writer must start the next generation after its next write.
+    std::uint64_t currentGeneration = 0;
+    std::uint64_t commitsRequested = 0;
+    std::uint64_t commitsDone = 0;
+    std::uint64_t writeCount = 0;
+    std::uint64_t syncCount = 0;
+    bool stopping = false;
+    std::exception_ptr writerError;     ///< The first failure of the writer thread; never cleared.
+
+    std::FILE* file = nullptr;          ///< Current journal, used by the writer thread only.
+    std::thread writer;                 ///< Started last, once every other member exists.
+};
+
+#endif // MENU_JOURNAL_H
@@ -2,70 +2,148 @@
 #define MENUMANAGER_H
 
 #include "Menu.h"
+#include "EmptyMenuException.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
 
 /**
  * @class MenuManager
- * @brief Singleton class to manage a Menu object, ensuring only one instance exists.
+ * @brief Singleton that publishes the active Menu to every thread of the program.
  *
- * The MenuManager class is responsible for managing a pointer to a Menu object, allowing operations like displaying
- * and sorting the menu. It follows the Singleton design pattern to ensure a single instance exists throughout the program.
+ * The published menu is immutable: a writer never changes it in place but publishes a
+ * new version with setMenu() or update() (copy-on-write), in one atomic step. A reader
+ * sees either the old or the new version, never a half-changed menu.
+ *
+ * Reads take no lock. Each thread keeps the version it read last and compares a
+ * version counter on every read; only after a publication does it load the new
+ * version, once, from an atomic shared pointer. Steady-state reads therefore touch
+ * no shared cache line that another reader writes. An old version is destroyed
+ * (deferred reclamation) when the last thread that still uses it reads again, exits,
+ * or drops its snapshot().
  */
 class MenuManager {
-private:
-    Menu* menu;  ///< Pointer to the base class Menu
-    static MenuManager* instance;  ///< Static instance for the Singleton
+public:
+    using Snapshot = std::shared_ptr<const Menu>; ///< A published version, kept alive while it is held.
 
     /**
-     * @brief Private constructor for Singleton pattern.
+     * @brief Static method to access the unique instance of MenuManager.
      *
-     * This ensures the class cannot be instantiated directly.
+     * The instance is created on the first call, safely even if several threads make it at once.
      *
-     * @param m Optional pointer to a Menu object.
+     * @return MenuManager& The single instance of MenuManager.
      */
-    explicit MenuManager(Menu* m = nullptr);
+    static MenuManager& getInstance();
 
-public:
     /**
-     * @brief Static method to access the unique instance of MenuManager.
+     * @brief Publishes a new menu; readers switch to it on their next read.
      *
-     * This ensures that only one instance of MenuManager exists. If the instance does not exist, it is created.
+     * @param m The new menu, now owned by the manager, or nullptr to withdraw the current one.
+     */
+    void setMenu(std::unique_ptr<Menu> m);
+
+    /**
+     * @brief Calls a function with the published menu, without locking or copying it.
      *
-     * @param m Optional pointer to initialize the menu (only applies on the first call).
-     * @return MenuManager& The single instance of MenuManager.
+     * The menu stays valid for the whole call, even if a writer publishes a new version
+     * meanwhile. Calls may be nested; the inner ones see the same version as the outer one.
+     *
+     * @param reader Called with a `const Menu&`; its result is returned.
+     * @throws EmptyMenuException If no menu is published.
      */
-    static MenuManager& getInstance(Menu* m = nullptr);
+    template <typename Reader>
+    decltype(auto) read(Reader&& reader) const {
+        ReaderCache& cache = readerCache;
+        if (cache.depth == 0 && cache.version != publishedVersion.load(std::memory_order_acquire)) {
+            refresh(cache);
+        }
+        if (!cache.menu) {
+            throw EmptyMenuException("No menu is published.");
+        }
+        ++cache.depth;
+        struct DepthGuard {
+            ReaderCache& cache;
+            ~DepthGuard() { --cache.depth; }
+        } guard{cache};
+        return std::forward<Reader>(reader)(*cache.menu);
+    }
 
     /**
-     * @brief Sets a new Menu object to be managed.
+     * @brief Returns the published menu, to keep one version across several calls.
+     *
+     * Unlike read(), this updates the shared reference count; prefer read() on hot paths.
      *
-     * @param m Pointer to the new Menu object.
+     * @return The menu, or nullptr if none is published.
      */
-    void setMenu(Menu* m);
+    [[nodiscard]] Snapshot snapshot() const;
 
     /**
-     * @brief Calls the `print()` method of the Menu object.
+     * @brief Changes a copy of the published menu and publishes it (copy-on-write).
+     *
+     * Writers are serialized, so concurrent updates are never lost. Like any copy of a
+     * menu, the copy starts with no observers: those of the published menu are not notified.
      *
-     * This method invokes the `print()` method of the `menu` object, which is a virtual method defined in the Menu base class
-     * or its derived classes.
+     * @param writer Called with a `Menu&` copy of the published menu.
+     * @throws EmptyMenuException If no menu is published.
      */
-    [[maybe_unused]] void displayMenu() const;
+    template <typename Writer>
+    void update(Writer&& writer) {
+        std::lock_guard lock(writers);
+        const Snapshot current = published.load(std::memory_order_acquire);
+        if (!current) {
+            throw EmptyMenuException("No menu is published.");
+        }
+        std::unique_ptr<Menu> next = current->clone();
+        std::forward<Writer>(writer)(*next);
+        publish(std::move(next));
+    }
+
+    /**
+     * @brief Returns the number of publications so far; it changes whenever a new version is published.
+     */
+    [[nodiscard]] std::uint64_t version() const {
+        return publishedVersion.load(std::memory_order_acquire);
+    }
 
     /**
-     * @brief Calls the `sortCategories()` method of the Menu object.
+     * @brief Calls the `print()` method of the published menu.
      *
-     * This method invokes the `sortCategories()` method of the `menu` object, which sorts the categories of the menu.
+     * If no menu is published, nothing happens.
      */
-    void sortCategories() const;
+    [[maybe_unused]] void displayMenu() const;
 
     /**
-     * @brief Destructor for MenuManager.
+     * @brief Publishes a copy of the menu with its categories sorted.
      *
-     * The destructor cleans up the resources by deleting the managed `menu` object.
+     * If no menu is published, nothing happens.
      */
-    ~MenuManager();
+    void sortCategories();
 
     MenuManager(const MenuManager&) = delete;
     MenuManager& operator=(const MenuManager&) = delete;
+
+private:
+    /**
+     * @brief The version a thread read last; the published one once it is refreshed.
+     */
+    struct ReaderCache {
+        std::uint64_t version = 0;
+        Snapshot menu;
+        unsigned depth = 0;  ///< Nesting of read() calls, which must not switch versions.
+    };
+
+    static thread_local ReaderCache readerCache;
+
+    std::atomic<Snapshot> published;            ///< The current version.
+    std::atomic<std::uint64_t> publishedVersion{0};
+    std::mutex writers;                         ///< Serializes setMenu() and update().
+
+    MenuManager() = default;
+
+    void refresh(ReaderCache& cache) const;
+    void publish(std::unique_ptr<Menu> m);
 };
 
 #endif // MENUMANAGER_H
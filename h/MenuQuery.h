@@ -0,0 +1,329 @@
+#ifndef MENU_QUERY_H
+#define MENU_QUERY_H
+
+#include "Category.h"
+#include "DietaryFilter.h"
+#include "Dish.h"
+#include "Menu.h"
+#include "Money.h"
+#include "TimeOfDay.h"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+/**
+ * @brief Dish queries composed at compile time into a single loop over a category.
+ *
+ * A query is a tree of small predicate objects combined with &&, || and !, e.g.
+ *
+ *     const auto cheapVegetarianLunch = query::inCategory("Lunch")
+ *                                       && query::price(0.0, 25.0)
+ *                                       && query::diet(DietaryFilter::vegetarian());
+ *     std::size_t found = query::select(menu, cheapVegetarianLunch, results);
+ *
+ * The type of the tree is the query, so the compiler inlines every test into the
+ * loop: there is no std::function and no virtual call per dish. Before a category is
+ * scanned, each predicate is bound to it: tests that depend only on the category
+ * (its name, its availability window, its food types) are decided once, and may rule
+ * the whole category in or out without looking at its dishes.
+ */
+namespace query {
+
+/**
+ * @brief What a predicate bound to a category tells about its dishes before testing them.
+ */
+enum class Scope : std::uint8_t {
+    None, ///< No dish of the category can match.
+    Some, ///< Each dish must be tested.
+    All,  ///< Every dish of the category matches.
+};
+
+/**
+ * @brief A predicate bound to a category: a scope and an exact test for each of its dishes.
+ */
+template <typename B>
+concept BoundPredicate = requires(const B& bound, const Dish& dish) {
+    { bound.scope } -> std::convertible_to<Scope>;
+    { bound(dish) } -> std::same_as<bool>;
+};
+
+/**
+ * @brief A query predicate: binds to a category, giving a BoundPredicate.
+ */
+template <typename P>
+concept DishPredicate = requires(const P& predicate, const Category& category) {
+    { predicate.bind(category) } -> BoundPredicate;
+};
+
+/**
+ * @brief Bound form of the predicates decided by the category alone.
+ */
+struct Decided {
+    Scope scope;
+    [[nodiscard]] bool operator()(const Dish&) const { return scope == Scope::All; }
+};
+
+/**
+ * @brief Dishes priced from min to max RON, both included.
+ */
+struct PriceRange {
+    Money min;
+    Money max;
+
+    struct Bound {
+        Scope scope;
+        Money min;
+        Money max;
+        [[nodiscard]] bool operator()(const Dish& dish) const {
+            return min <= dish.getPrice() && dish.getPrice() <= max;
+        }
+    };
+
+    [[nodiscard]] Bound bind(const Category&) const { return {Scope::Some, min, max}; }
+};
+
+/**
+ * @brief Dishes containing every required food type and none of the excluded ones.
+ */
+struct Diet {
+    DietaryFilter filter;
+
+    struct Bound {
+        Scope scope;
+        DietaryFilter filter;
+        [[nodiscard]] bool operator()(const Dish& dish) const { return filter.matches(dish.getFoodMask()); }
+    };
+
+    [[nodiscard]] Bound bind(const Category& category) const {
+        const FoodMask present = category.getFoodMask();  // Union of the masks of the dishes
+        if ((present & filter.required) != filter.required) {
+            return {Scope::None, filter};
+        }
+        return {filter.required == 0 && (present & filter.excluded) == 0 ? Scope::All : Scope::Some, filter};
+    }
+};
+
+/**
+ * @brief Dishes of the category with the given name.
+ */
+struct InCategory {
+    std::string_view name;
+
+    [[nodiscard]] Decided bind(const Category& category) const {
+        return {category.getName() == name ? Scope::All : Scope::None};
+    }
+};
+
+/**
+ * @brief Dishes of categories available at the given time.
+ */
+struct AvailableAt {
+    TimeOfDay time;
+
+    [[nodiscard]] Decided bind(const Category& category) const {
+        return {category.getAvailability().contains(time) ? Scope::All : Scope::None};
+    }
+};
+
+template <DishPredicate L, DishPredicate R>
+struct And {
+    L left;
+    R right;
+
+    template <typename LB, typename RB>
+    struct Bound {
+        Scope scope;
+        LB left;
+        RB right;
+        [[nodiscard]] bool operator()(const Dish& dish) const { return left(dish) && right(dish); }
+    };
+
+    [[nodiscard]] auto bind(const Category& category) const {
+        const auto l = left.bind(category);
+        const auto r = right.bind(category);
+        Scope scope = Scope::Some;
+        if (l.scope == Scope::None || r.scope == Scope::None) {
+            scope = Scope::None;
+        } else if (l.scope == Scope::All && r.scope == Scope::All) {
+            scope = Scope::All;
+        }
+        return Bound<decltype(l), decltype(r)>{scope, l, r};
+    }
+};
+
+template <DishPredicate L, DishPredicate R>
+struct Or {
+    L left;
+    R right;
+
+    template <typename LB, typename RB>
+    struct Bound {
+        Scope scope;
+        LB left;
+        RB right;
+        [[nodiscard]] bool operator()(const Dish& dish) const { return left(dish) || right(dish); }
+    };
+
+    [[nodiscard]] auto bind(const Category& category) const {
+        const auto l = left.bind(category);
+        const auto r = right.bind(category);
+        Scope scope = Scope::Some;
+        if (l.scope == Scope::All || r.scope == Scope::All) {
+            scope = Scope::All;
+        } else if (l.scope == Scope::None && r.scope == Scope::None) {
+            scope = Scope::None;
+        }
+        return Bound<decltype(l), decltype(r)>{scope, l, r};
+    }
+};
+
+template <DishPredicate P>
+struct Not {
+    P inner;
+
+    template <typename B>
+    struct Bound {
+        Scope scope;
+        B inner;
+        [[nodiscard]] bool operator()(const Dish& dish) const { return !inner(dish); }
+    };
+
+    [[nodiscard]] auto bind(const Category& category) const {
+        const auto b = inner.bind(category);
+        const Scope scope = b.scope == Scope::All ? Scope::None : b.scope == Scope::None ? Scope::All : Scope::Some;
+        return Bound<decltype(b)>{scope, b};
+    }
+};
+
+template <DishPredicate L, DishPredicate R>
+[[nodiscard]] constexpr And<L, R> operator&&(L left, R right) {
+    return {left, right};
+}
+
+template <DishPredicate L, DishPredicate R>
+[[nodiscard]] constexpr Or<L, R> operator||(L left, R right) {
+    return {left, right};
+}
+
+template <DishPredicate P>
+[[nodiscard]] constexpr Not<P> operator!(P inner) {
+    return {inner};
+}
+
+[[nodiscard]] constexpr PriceRange price(Money min, Money max) {
+    return {min, max};
+}
+
+[[nodiscard]] constexpr Diet diet(DietaryFilter filter) {
+    return {filter};
+}
+
+/**
+ * @brief Dishes containing the food type.
+ */
+[[nodiscard]] constexpr Diet contains(FoodType type) {
+    return {{toFoodMask(type), 0}};
+}
+
+/**
+ * @brief Dishes without the food type.
+ */
+[[nodiscard]] constexpr Diet excludes(FoodType type) {
+    return {{0, toFoodMask(type)}};
+}
+
+/**
+ * @brief Dishes of the named category; the name must outlive the query.
+ */
+[[nodiscard]] constexpr InCategory inCategory(std::string_view name) {
+    return {name};
+}
+
+[[nodiscard]] constexpr AvailableAt availableAt(TimeOfDay time) {
+    return {time};
+}
+
+/**
+ * @brief Writes the dishes of a category matching a query to out, in menu order.
+ *
+ * @param category The category to scan.
+ * @param predicate The query.
+ * @param out Where to write pointers to the matching dishes; the scan stops when it is full.
+ * @return The number of pointers written.
+ */
+template <DishPredicate P>
+std::size_t select(const Category& category, const P& predicate, std::span<const Dish*> out) {
+    const auto bound = predicate.bind(category);
+    const auto& dishes = category.getDishes();
+    std::size_t found = 0;
+    switch (bound.scope) {
+        case Scope::None:
+            break;
+        case Scope::All:
+            for (; found < dishes.size() && found < out.size(); ++found) {
+                out[found] = &dishes[found];
+            }
+            break;
+        case Scope::Some:
+            if (out.size() >= dishes.size()) {
+                for (const Dish& dish : dishes) {  // Room for every dish: no bounds check in the loop
+                    if (bound(dish)) {
+                        out[found++] = &dish;
+                    }
+                }
+                break;
+            }
+            for (const Dish& dish : dishes) {
+                if (found == out.size()) {
+                    break;
+                }
+                if (bound(dish)) {
+                    out[found++] = &dish;
+                }
+            }
+            break;
+    }
+    return found;
+}
+
+/**
+ * @brief Writes the dishes of every category of a menu matching a query to out, in menu order.
+ *
+ * @return The number of pointers written; out.size() means the results may have been cut short.
+ */
+template <DishPredicate P>
+std::size_t select(const Menu& menu, const P& predicate, std::span<const Dish*> out) {
+    std::size_t found = 0;
+    for (const auto& category : menu.getCategory()) {
+        if (found == out.size()) {
+            break;
+        }
+        found += select(category, predicate, out.subspan(found));
+    }
+    return found;
+}
+
+/**
+ * @brief Counts the dishes of a menu matching a query, without storing them.
+ */
+template <DishPredicate P>
+std::size_t count(const Menu& menu, const P& predicate) {
+    std::size_t matching = 0;
+    for (const auto& category : menu.getCategory()) {
+        const auto bound = predicate.bind(category);
+        if (bound.scope == Scope::All) {
+            matching += category.getDishes().size();
+        } else if (bound.scope == Scope::Some) {
+            for (const Dish& dish : category.getDishes()) {
+                matching += bound(dish) ? 1 : 0;
+            }
+        }
+    }
+    return matching;
+}
+
+} // namespace query
+
+#endif // MENU_QUERY_H
@@ -0,0 +1,103 @@
+#ifndef MENU_RENDER_CACHE_H
+#define MENU_RENDER_CACHE_H
+
+#include "Menu.h"
+#include "MenuEvent.h"
+#include "MenuRenderer.h"
+#include "Observer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief The text layouts of a menu that MenuRenderCache keeps.
+ */
+enum class RenderFormat : std::uint8_t {
+    Listing, ///< The layout of print() and display().
+    Details, ///< The layout of operator<<.
+};
+
+inline constexpr std::size_t RenderFormatCount = 2;
+
+/**
+ * @class MenuRenderCache
+ * @brief Keeps the rendered text of every category of a menu, re-rendering only the categories that changed.
+ *
+ * The text of each category is cached once per RenderFormat. The cache observes the
+ * menu: a dish added, removed or repriced invalidates its category only, a removed
+ * category drops its text, and sorting the menu (which reorders the dishes of every
+ * category) invalidates everything. Rendering the menu copies the text of the clean
+ * categories and renders the others, in the current order of the menu.
+ *
+ * Each category served counts as a hit when its text was reused and as a miss when it
+ * was rendered. Like the menu itself, the cache must be used from one thread at a time.
+ */
+class MenuRenderCache : public Observer {
+public:
+    /**
+     * @brief Starts observing a menu; nothing is rendered until the first render().
+     *
+     * @param menu The menu to cache; it must outlive the cache.
+     */
+    explicit MenuRenderCache(Menu& menu);
+
+    /**
+     * @brief Stops observing the menu.
+     */
+    ~MenuRenderCache() override;
+
+    MenuRenderCache(const MenuRenderCache&) = delete;
+    MenuRenderCache& operator=(const MenuRenderCache&) = delete;
+
+    /**
+     * @brief Invalidates the categories touched by a change of the menu; called by the menu.
+     */
+    void update(const MenuEvent& event) override;
+
+    /**
+     * @brief Appends the menu in a format to a renderer, from the cached category texts.
+     *
+     * The text is the same as renderer.menuListing(menu) or renderer.menu(menu).
+     */
+    void render(RenderFormat format, MenuRenderer& renderer);
+
+    /**
+     * @brief Prints the menu like Menu::display(), from the cache.
+     */
+    void display();
+
+    [[nodiscard]] std::uint64_t hits() const { return hitCount; }
+    [[nodiscard]] std::uint64_t misses() const { return missCount; }
+
+private:
+    /**
+     * @brief The cached texts of one category, with a validity flag per format.
+     */
+    struct Segments {
+        std::array<std::string, RenderFormatCount> text;
+        std::array<bool, RenderFormatCount> valid{};
+    };
+
+    /**
+     * @brief Transparent hash so segments can be looked up by the category name's view.
+     */
+    struct NameHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view name) const noexcept {
+            return std::hash<std::string_view>{}(name);
+        }
+    };
+
+    void invalidate(std::string_view category);
+
+    Menu& menu;
+    std::unordered_map<std::string, Segments, NameHash, std::equal_to<>> segments; ///< Category name -> texts.
+    std::uint64_t hitCount = 0;
+    std::uint64_t missCount = 0;
+};
+
+#endif // MENU_RENDER_CACHE_H
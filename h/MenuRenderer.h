@@ -0,0 +1,192 @@
+#ifndef MENU_RENDERER_H
+#define MENU_RENDERER_H
+
+#include "Category.h"
+#include "Dish.h"
+#include "Menu.h"
+#include "Money.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Destination of the text rendered by a MenuRenderer.
+ *
+ * A renderer hands its whole buffer to the sink in one write() call.
+ */
+class RenderSink {
+public:
+    virtual ~RenderSink() = default;
+
+    /**
+     * @brief Writes all of the text, or throws.
+     */
+    virtual void write(std::string_view text) = 0;
+};
+
+/**
+ * @brief Writes to a file descriptor (e.g., a receipt printer, a kiosk's terminal, a file).
+ *
+ * Each write() is a single write system call, repeated only when the kernel accepts
+ * part of the text or the call is interrupted. The descriptor is not closed.
+ */
+class FdSink : public RenderSink {
+public:
+    explicit FdSink(int descriptor) : descriptor(descriptor) {}
+
+    /**
+     * @throws std::system_error If the descriptor cannot be written.
+     */
+    void write(std::string_view text) override;
+
+private:
+    int descriptor;
+};
+
+/**
+ * @brief Appends to a string.
+ */
+class StringSink : public RenderSink {
+public:
+    explicit StringSink(std::string& out) : out(out) {}
+
+    void write(std::string_view text) override { out += text; }
+
+private:
+    std::string& out;
+};
+
+/**
+ * @brief Writes to an output stream with a single insertion.
+ */
+class StreamSink : public RenderSink {
+public:
+    explicit StreamSink(std::ostream& os) : os(os) {}
+
+    void write(std::string_view text) override;
+
+private:
+    std::ostream& os;
+};
+
+/**
+ * @brief Copies into a fixed block of memory, dropping what does not fit.
+ */
+class MemorySink : public RenderSink {
+public:
+    explicit MemorySink(std::span<char> memory) : memory(memory) {}
+
+    void write(std::string_view text) override;
+
+    /**
+     * @brief Returns the text written so far.
+     */
+    [[nodiscard]] std::string_view view() const { return {memory.data(), used}; }
+
+    /**
+     * @brief Tells whether some text did not fit in the memory.
+     */
+    [[nodiscard]] bool truncated() const { return dropped; }
+
+private:
+    std::span<char> memory;
+    std::size_t used = 0;
+    bool dropped = false;
+};
+
+/**
+ * @class MenuRenderer
+ * @brief Formats menus, categories and dishes into a reusable buffer, then writes it to a sink at once.
+ *
+ * Numbers and prices are formatted with std::to_chars, without locales or temporary
+ * strings, and the buffer keeps its capacity between renders, so rendering a menu
+ * allocates nothing once the buffer has grown to the size of the menu. The layouts
+ * are the ones of operator<< (menu(), category(), dish()) and of print() (the
+ * "listing" functions); those operators and print() functions render through the
+ * renderer of the calling thread, local().
+ */
+class MenuRenderer {
+public:
+    static constexpr std::size_t DefaultCapacity = 64 * 1024;
+
+    /**
+     * @brief Creates an empty renderer.
+     *
+     * @param capacity The bytes to reserve for the buffer up front.
+     */
+    explicit MenuRenderer(std::size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Returns the renderer of the calling thread, used by print() and operator<<.
+     */
+    static MenuRenderer& local();
+
+    MenuRenderer& text(std::string_view value);
+    MenuRenderer& character(char value);
+    MenuRenderer& number(std::int64_t value);
+    MenuRenderer& real(float value);  ///< Shortest text that reads back as the same float.
+    MenuRenderer& money(Money value);
+
+    /**
+     * @brief Renders a menu like operator<<: every category with the details of its dishes.
+     */
+    void menu(const Menu& menu);
+
+    /**
+     * @brief Renders a menu like print(): its title, then one line per dish.
+     */
+    void menuListing(const Menu& menu);
+
+    /**
+     * @brief Renders a category like operator<<.
+     */
+    void category(const Category& category);
+
+    /**
+     * @brief Renders a category like print(): its name, then one "name: price RON" line per dish.
+     */
+    void categoryListing(const Category& category);
+
+    /**
+     * @brief Renders a dish like operator<<: name, price and ingredients.
+     */
+    void dish(const Dish& dish);
+
+    /**
+     * @brief Renders a dish like print(): "name: price RON", without a newline.
+     */
+    void dishLine(const Dish& dish);
+
+    /**
+     * @brief Returns the text rendered since the last flush.
+     */
+    [[nodiscard]] std::string_view view() const { return buffer; }
+
+    /**
+     * @brief Drops the text rendered since the last flush.
+     */
+    void clear();
+
+    /**
+     * @brief Writes the rendered text to a sink with a single call, then clears the buffer.
+     *
+     * The buffer is cleared even if the sink throws.
+     */
+    void flushTo(RenderSink& sink);
+
+    /**
+     * @brief Writes the rendered text to a stream with a single insertion, then clears the buffer.
+     */
+    void flushTo(std::ostream& os);
+
+private:
+    /// A buffer grown beyond this by a huge render is released after the flush instead of kept.
+    static constexpr std::size_t MaxRetainedCapacity = 16 * 1024 * 1024;
+
+    std::string buffer;
+};
+
+#endif // MENU_RENDERER_H
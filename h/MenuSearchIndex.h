@@ -0,0 +1,172 @@
+#ifndef MENU_SEARCH_INDEX_H
+#define MENU_SEARCH_INDEX_H
+
+#include "Menu.h"
+#include "MenuEvent.h"
+#include "Observer.h"
+#include "SymbolTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief How a search hit matched the query, from the best to the weakest match.
+ */
+enum class SearchMatch : std::uint8_t {
+    Exact,      ///< The whole dish name.
+    Prefix,     ///< The beginning of the dish name.
+    WordPrefix, ///< The beginning of another word of the dish name.
+    Fuzzy,      ///< A dish name sharing most trigrams with the query (e.g., a typo).
+    Ingredient, ///< One of the dish's ingredients, by any of the above.
+};
+
+/**
+ * @brief A dish found by MenuSearchIndex::search(), with its category.
+ *
+ * The pointers refer to the indexed menu and are valid until the menu changes.
+ */
+struct SearchHit {
+    const Category* category = nullptr;
+    const Dish* dish = nullptr;
+    SearchMatch match = SearchMatch::Exact;
+    float score = 0.0f;  ///< Higher is better; 1 for an exact match.
+};
+
+/**
+ * @class MenuSearchIndex
+ * @brief Search-as-you-type index over the dish and ingredient names of a menu.
+ *
+ * Names are folded before indexing and searching: ASCII letters are lowercased and the
+ * Romanian diacritics (ă, â, î, ș, ț and the cedilla forms ş, ţ) become plain letters,
+ * so "ciorba" finds "Ciorbă" and "ȘNITEL" finds "Snitel".
+ *
+ * Each distinct folded name is a term with the dishes that carry it. Prefix queries use
+ * a sorted array of every word start of every term (a sorted-suffix array restricted to
+ * word boundaries), so "pizza" finds "Margherita Pizza". For typos, every word of the
+ * query is compared with the distinct words of all names by the trigrams they share
+ * (Dice coefficient), so "piza" still finds "Margherita Pizza". Ingredient names are
+ * searched the same way and rank below the dish names.
+ *
+ * The index observes the menu and is updated incrementally on every change. Like the
+ * menu itself, it must be used from one thread at a time.
+ */
+class MenuSearchIndex : public Observer {
+public:
+    /**
+     * @brief Indexes a menu and starts observing it.
+     *
+     * @param menu The menu to index; it must outlive the index.
+     */
+    explicit MenuSearchIndex(Menu& menu);
+
+    /**
+     * @brief Stops observing the menu.
+     */
+    ~MenuSearchIndex() override;
+
+    MenuSearchIndex(const MenuSearchIndex&) = delete;
+    MenuSearchIndex& operator=(const MenuSearchIndex&) = delete;
+
+    /**
+     * @brief Updates the index after a change of the menu; called by the menu.
+     */
+    void update(const MenuEvent& event) override;
+
+    /**
+     * @brief Returns the dishes best matching a query, best first.
+     *
+     * @param query Part of a dish or ingredient name, as typed.
+     * @param limit The maximum number of hits.
+     * @return The hits; the pointers are valid until the menu changes.
+     */
+    [[nodiscard]] std::vector<SearchHit> search(std::string_view query, std::size_t limit = 10) const;
+
+    /**
+     * @brief Returns the number of distinct folded names indexed.
+     */
+    [[nodiscard]] std::size_t termCount() const;
+
+    /**
+     * @brief Folds a name for searching: lowercase ASCII, Romanian diacritics removed.
+     */
+    static std::string fold(std::string_view text);
+
+private:
+    /**
+     * @brief A dish of the menu, by the interned names of its category and itself.
+     */
+    struct Posting {
+        Symbol category;
+        Symbol dish;
+        bool operator==(const Posting&) const = default;
+    };
+
+    struct Term {
+        std::string text;                   ///< Folded name.
+        std::vector<Posting> dishes;        ///< Dishes with this name.
+        std::vector<Posting> ingredientOf;  ///< Dishes with an ingredient of this name.
+    };
+
+    /**
+     * @brief A distinct folded word, for the fuzzy search.
+     */
+    struct Word {
+        std::uint16_t trigramCount = 0;
+        std::vector<std::uint32_t> terms;   ///< Terms containing the word.
+    };
+
+    /**
+     * @brief The start of a word inside a term; the array of them is sorted by the text from there on.
+     */
+    struct WordStart {
+        std::uint32_t term;
+        std::uint16_t offset;
+    };
+
+    /**
+     * @brief What was indexed for a dish, to remove it again after it left the menu.
+     */
+    struct IndexedDish {
+        Symbol dish;
+        std::uint32_t nameTerm;
+        std::vector<std::uint32_t> ingredientTerms;
+    };
+
+    struct Candidate {
+        std::uint32_t term;
+        SearchMatch match;
+        float score;
+    };
+
+    std::uint32_t termFor(Symbol name);
+    void addWords(std::uint32_t term);
+    void addDish(Symbol category, const Dish& dish);
+    void removeDish(Symbol category, Symbol dish);
+    void addCategory(const Category& category);
+    void removeCategory(Symbol category);
+    void findCandidates(std::string_view folded, std::vector<Candidate>& candidates) const;
+    std::string_view wordStartText(const WordStart& start) const;
+
+    Menu& menu;
+    bool bulkLoading = true;            ///< While the constructor indexes the menu, word starts are sorted once at the end.
+    std::vector<Term> terms;
+    std::unordered_map<std::string, std::uint32_t> termIndex;   ///< Folded name -> term.
+    std::unordered_map<Symbol, std::uint32_t> symbolTerms;      ///< Interned name -> term, so each name is folded once.
+    std::vector<WordStart> wordStarts;
+    std::vector<Word> words;
+    std::unordered_map<std::string, std::uint32_t> wordIndex;   ///< Folded word -> word.
+    std::unordered_map<std::uint32_t, std::vector<std::uint32_t>> trigrams;  ///< Packed trigram -> words containing it.
+    std::unordered_map<Symbol, std::vector<IndexedDish>> categories;
+
+    // Scratch buffers of the fuzzy search, reused between queries
+    mutable std::vector<std::uint16_t> sharedTrigrams;  ///< Per word, trigrams shared with the query word.
+    mutable std::vector<std::uint32_t> touchedWords;    ///< Words whose count is not 0.
+    mutable std::vector<float> bestDice;                ///< Per term, best match of the current query word.
+    mutable std::vector<float> fuzzyScore;              ///< Per term, sum of the best matches of all query words.
+    mutable std::vector<std::uint32_t> touchedTerms;    ///< Terms whose scores are not 0.
+};
+
+#endif // MENU_SEARCH_INDEX_H
@@ -0,0 +1,225 @@
+#ifndef MENU_SNAPSHOT_H
+#define MENU_SNAPSHOT_H
+
+#include "Category.h"
+#include "Dish.h"
+#include "Menu.h"
+#include "Money.h"
+#include "TimeOfDay.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Concrete type of a menu stored in a snapshot.
+ */
+enum class MenuKind : std::uint8_t {
+    Breakfast,
+    Lunch,
+    Dinner,
+};
+
+class MenuSnapshot;
+
+/**
+ * @brief Read-only view of one dish inside a MenuSnapshot.
+ *
+ * Every accessor reads straight from the mapped file; copying a view is free.
+ */
+class SnapshotDishView {
+private:
+    const MenuSnapshot* snapshot; ///< The snapshot holding the dish columns.
+    std::uint32_t id;             ///< Row of the dish inside the snapshot.
+
+public:
+    SnapshotDishView(const MenuSnapshot& snapshot, std::uint32_t id) : snapshot(&snapshot), id(id) {}
+
+    [[nodiscard]] std::string_view getName() const;
+    [[nodiscard]] Money getPrice() const;
+    [[nodiscard]] float getWeight() const;
+    [[nodiscard]] FoodMask getFoodMask() const;
+
+    /**
+     * @brief Checks if the dish contains no meat, in O(1).
+     */
+    [[nodiscard]] bool isVegetarian() const;
+
+    /**
+     * @brief Returns the number of ingredients of the dish.
+     */
+    [[nodiscard]] std::uint32_t ingredientCount() const;
+
+    /**
+     * @brief Returns the name of the i-th ingredient.
+     */
+    [[nodiscard]] std::string_view ingredientName(std::uint32_t i) const;
+
+    /**
+     * @brief Returns the food type of the i-th ingredient.
+     */
+    [[nodiscard]] FoodType ingredientType(std::uint32_t i) const;
+
+    /**
+     * @brief Rebuilds the dish as a Dish object.
+     */
+    [[nodiscard]] Dish toDish() const;
+};
+
+/**
+ * @brief Read-only view of one category inside a MenuSnapshot.
+ */
+class SnapshotCategoryView {
+private:
+    const MenuSnapshot* snapshot; ///< The snapshot holding the category table.
+    std::uint32_t index;          ///< Row of the category inside the snapshot.
+
+public:
+    SnapshotCategoryView(const MenuSnapshot& snapshot, std::uint32_t index) : snapshot(&snapshot), index(index) {}
+
+    [[nodiscard]] std::string_view getName() const;
+
+    /**
+     * @brief Returns the number of dishes in the category.
+     */
+    [[nodiscard]] std::uint32_t size() const;
+
+    /**
+     * @brief Returns a view of the i-th dish of the category.
+     */
+    [[nodiscard]] SnapshotDishView dish(std::uint32_t i) const;
+
+    [[nodiscard]] TimeWindow getAvailability() const;
+    [[nodiscard]] bool isAvailableAt(TimeOfDay time) const;
+    [[nodiscard]] FoodMask getFoodMask() const;
+
+    /**
+     * @brief Sums the prices of the category with a contiguous column scan.
+     */
+    [[nodiscard]] Money totalPrice() const;
+
+    /**
+     * @brief Rebuilds the category as a Category object.
+     */
+    [[nodiscard]] Category toCategory() const;
+};
+
+/**
+ * @class MenuSnapshot
+ * @brief Versioned binary snapshot of a full Menu hierarchy, loaded with mmap.
+ *
+ * The file holds a header followed by aligned sections: the category table (names,
+ * dish ranges, availability windows, food masks), one column per dish attribute
+ * (name, price, weight, ingredient range, food mask), the ingredient columns, a
+ * deduplicated string table and the minute-by-minute availability of the menu.
+ * All numbers are little-endian.
+ *
+ * open() maps the file and validates it once; after that the views read directly
+ * from the mapping, so loading allocates nothing per category or dish. toMenu()
+ * rebuilds regular Menu objects when mutation is needed.
+ */
+class MenuSnapshot {
+public:
+    static constexpr std::uint32_t Version = 1; ///< Incremented on every incompatible format change.
+
+    /**
+     * @brief Writes a snapshot of the menu to a file.
+     *
+     * @param menu A Breakfast, Lunch or Dinner menu.
+     * @param path The file to create or overwrite.
+     * @throws SnapshotException If the menu type is unknown or the file cannot be written.
+     */
+    static void write(const Menu& menu, const std::string& path);
+
+    /**
+     * @brief Maps a snapshot file and validates its structure.
+     *
+     * @param path The file written by write().
+     * @return The loaded snapshot; views stay valid while it is alive.
+     * @throws SnapshotException If the file is missing, truncated, of another version or inconsistent.
+     */
+    static MenuSnapshot open(const std::string& path);
+
+    MenuSnapshot(MenuSnapshot&& other) noexcept;
+    MenuSnapshot& operator=(MenuSnapshot&& other) noexcept;
+    MenuSnapshot(const MenuSnapshot&) = delete;
+    MenuSnapshot& operator=(const MenuSnapshot&) = delete;
+    ~MenuSnapshot();
+
+    [[nodiscard]] MenuKind kind() const { return menuKind; }
+    [[nodiscard]] std::uint32_t categoryCount() const { return static_cast<std::uint32_t>(categories.size()); }
+    [[nodiscard]] std::uint32_t dishCount() const { return static_cast<std::uint32_t>(dishNames.size()); }
+
+    /**
+     * @brief Returns a view of the i-th category.
+     */
+    [[nodiscard]] SnapshotCategoryView category(std::uint32_t i) const { return {*this, i}; }
+
+    /**
+     * @brief Returns a view of a dish by its row in the snapshot.
+     */
+    [[nodiscard]] SnapshotDishView dish(std::uint32_t id) const { return {*this, id}; }
+
+    /**
+     * @brief Checks if the menu is available at the given time, with a single bit test.
+     */
+    [[nodiscard]] bool isAvailableAt(TimeOfDay time) const;
+
+    /**
+     * @brief Returns the price column of every dish, in category order.
+     */
+    [[nodiscard]] std::span<const Money> priceColumn() const { return dishPrices; }
+
+    /**
+     * @brief Returns the size of the mapped file in bytes.
+     */
+    [[nodiscard]] std::size_t fileSize() const { return size; }
+
+    /**
+     * @brief Rebuilds the menu as a Breakfast, Lunch or Dinner object.
+     */
+    [[nodiscard]] std::unique_ptr<Menu> toMenu() const;
+
+private:
+    friend class SnapshotDishView;
+    friend class SnapshotCategoryView;
+
+    // One row of the category table, as stored in the file
+    struct CategoryRecord {
+        std::uint32_t name;
+        std::uint32_t firstDish;
+        std::uint32_t dishCount;
+        std::uint16_t windowStart;
+        std::uint16_t windowEnd;
+        FoodMask foodMask;
+        std::uint8_t padding[3];
+    };
+
+    MenuSnapshot() = default;
+    void release();
+    void load();
+    [[nodiscard]] std::string_view string(std::uint32_t index) const;
+
+    const std::byte* data = nullptr;  ///< Start of the mapped file.
+    std::size_t size = 0;             ///< Size of the mapped file.
+    bool mapped = false;              ///< True if data comes from mmap, false if it points into buffer.
+    std::vector<std::uint64_t> buffer; ///< File contents on platforms without mmap.
+
+    MenuKind menuKind = MenuKind::Lunch;
+    std::span<const CategoryRecord> categories;
+    std::span<const std::uint32_t> dishNames;
+    std::span<const Money> dishPrices;
+    std::span<const float> dishWeights;
+    std::span<const std::uint32_t> ingredientBegin; ///< dishCount + 1 prefix offsets into the ingredient columns.
+    std::span<const FoodMask> dishFlags;
+    std::span<const std::uint32_t> ingredientNames;
+    std::span<const std::uint8_t> ingredientTypes;
+    std::span<const std::uint32_t> stringOffsets;   ///< stringCount + 1 offsets into stringData.
+    std::span<const char> stringData;
+    std::span<const std::uint64_t> availability;    ///< One bit per minute of the day.
+};
+
+#endif // MENU_SNAPSHOT_H
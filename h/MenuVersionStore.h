@@ -0,0 +1,174 @@
+#ifndef MENU_VERSION_STORE_H
+#define MENU_VERSION_STORE_H
+
+#include "Dish.h"
+#include "Menu.h"
+#include "MenuEvent.h"
+#include "Observer.h"
+#include "SymbolTable.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief One category of a menu as it was at some point in time (see MenuVersionStore::asOf()).
+ */
+struct CategoryVersion {
+    std::string_view name;                              ///< Interned name, valid for the whole program.
+    std::vector<std::shared_ptr<const Dish>> dishes;    ///< The dishes of that time, shared with the store.
+};
+
+/**
+ * @class MenuVersionStore
+ * @brief Keeps every past version of a menu so it can be queried at a point in time.
+ *
+ * The store observes a menu and records each change with the time it happened, e.g.,
+ * to find what a dish cost when an order was placed. Versions share their structure:
+ * every dish is kept as an immutable object, and a change only adds the new version
+ * of the dish or category it touches to that item's history. Memory therefore grows
+ * with the size of each change, never with the catalog size times the version count.
+ *
+ * Every dish added to a category gets its own history, so two dishes with the same
+ * name stay apart; an event names the changed dish by its slot in the category. A
+ * sort records the new order of each category's dishes, which is the size of the
+ * category, from the slots the menu moved each dish from (Menu::sortedKeys()). An
+ * event that does not fit the dishes the store follows never lands in another dish's
+ * history: the histories of that category's dishes end, and new ones start from the
+ * menu's dishes.
+ *
+ * A query looks up each history with a binary search on time. The categories come in
+ * the order in which they first appeared, the dishes in the menu's order of that time.
+ *
+ * Changes are recorded on the thread that changes the menu; queries may run on any
+ * thread at the same time.
+ */
+class MenuVersionStore : public Observer {
+public:
+    using Clock = std::chrono::system_clock;
+    using Timestamp = Clock::time_point;
+
+    /**
+     * @brief Records the current state of a menu as its first version and starts observing it.
+     *
+     * @param menu The menu to version; it must outlive the store.
+     */
+    explicit MenuVersionStore(Menu& menu);
+
+    /**
+     * @brief Stops observing the menu.
+     */
+    ~MenuVersionStore() override;
+
+    MenuVersionStore(const MenuVersionStore&) = delete;
+    MenuVersionStore& operator=(const MenuVersionStore&) = delete;
+
+    /**
+     * @brief Records a change of the menu; called by the menu.
+     */
+    void update(const MenuEvent& event) override;
+
+    /**
+     * @brief Returns the menu as it was at a point in time.
+     *
+     * @param time The point in time; changes made at exactly that time are included.
+     * @return The categories of that time, or an empty list before the store was created.
+     */
+    [[nodiscard]] std::vector<CategoryVersion> asOf(Timestamp time) const;
+
+    /**
+     * @brief Returns a dish as it was at a point in time, without building the whole menu.
+     *
+     * @param categoryName The name of the category.
+     * @param dishName The name of the dish.
+     * @param time The point in time.
+     * @return The dish, or nullptr if the category or the dish was not on the menu then.
+     */
+    [[nodiscard]] std::shared_ptr<const Dish> dishAsOf(std::string_view categoryName, std::string_view dishName,
+                                                       Timestamp time) const;
+
+    /**
+     * @brief Returns the time of the first version.
+     */
+    [[nodiscard]] Timestamp createdAt() const { return created; }
+
+    /**
+     * @brief Returns the number of changes recorded since the first version.
+     */
+    [[nodiscard]] std::uint64_t changes() const;
+
+    /**
+     * @brief Returns the number of dish objects kept for all versions together.
+     */
+    [[nodiscard]] std::size_t storedDishes() const;
+
+private:
+    /**
+     * @brief A version of a dish; a null dish means it was removed at that time.
+     */
+    struct DishVersion {
+        Timestamp from;
+        std::shared_ptr<const Dish> dish;
+    };
+
+    /**
+     * @brief Whether a category was on the menu from a point in time on.
+     */
+    struct Presence {
+        Timestamp from;
+        bool present;
+    };
+
+    struct DishHistory {
+        Symbol name;
+        std::vector<DishVersion> versions;  ///< Sorted by time; starts with the dish being added.
+    };
+
+    /**
+     * @brief The order of a category's dishes from a sort on: the dishes it lists, then those added later.
+     */
+    struct DishOrder {
+        Timestamp from;
+        std::vector<std::uint32_t> dishes;  ///< Dish histories in the sorted order.
+        std::uint32_t firstLater;           ///< The histories from this one on were added after the sort.
+    };
+
+    struct CategoryHistory {
+        Symbol name;
+        std::vector<Presence> presence;     ///< Sorted by time.
+        std::vector<DishHistory> dishes;    ///< One per dish ever added, in order of appearance.
+        std::vector<DishOrder> orders;      ///< Sorted by time; the order of appearance holds before the first.
+        std::vector<std::uint32_t> current; ///< The histories of the menu's dishes, in the menu's order.
+        std::unordered_map<Symbol, std::vector<std::uint32_t>> byName; ///< The histories of each dish name.
+    };
+
+    Timestamp stamp();
+    CategoryHistory& categoryHistory(Symbol name);
+    void addDish(CategoryHistory& category, const Dish& dish, Timestamp time);
+    void restartDishes(CategoryHistory& history, const Category& category, Timestamp time);
+    void recordCategory(const Category& category, Timestamp time);
+    void recordOrder(CategoryHistory& history, const Category& category, std::span<const DishOrdering::Key> sorted,
+                     Timestamp time);
+    static bool follows(const CategoryHistory& history, const Category& category, const MenuEvent& event);
+    const CategoryHistory* findCategory(std::string_view name) const;
+
+    template <typename Visit>
+    static void forEachInOrder(const CategoryHistory& category, Timestamp time, Visit visit);
+
+    Menu& menu;
+    Timestamp created;
+    Timestamp last;                     ///< Time of the newest version; times never go back.
+
+    mutable std::shared_mutex mutex;    ///< Exclusive while a change is recorded, shared by the queries.
+    std::vector<CategoryHistory> categories;
+    std::unordered_map<Symbol, std::size_t> categoryIndex;
+    std::uint64_t changeCount = 0;
+    std::size_t dishCount = 0;
+};
+
+#endif // MENU_VERSION_STORE_H
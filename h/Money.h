@@ -0,0 +1,98 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <type_traits>
+
+/**
+ * @class Money
+ * @brief Fixed-point amount of RON stored as an integer number of bani (1 RON = 100 bani).
+ *
+ * Sums of Money values are exact, unlike sums of floats, and a Money is a single
+ * 64-bit integer so arrays of prices can be totaled with SIMD kernels (see PriceTotals).
+ */
+class Money {
+private:
+    std::int64_t bani; ///< The amount in bani.
+
+public:
+    /**
+     * @brief Constructs a zero amount.
+     */
+    constexpr Money() : bani(0) {}
+
+    /**
+     * @brief Converts an amount in RON, rounded to the nearest ban.
+     *
+     * Implicit so prices can still be written as plain numbers (e.g., Dish("Pizza", 20.0, ...)).
+     *
+     * @param ron The amount in RON.
+     */
+    constexpr Money(double ron) // NOLINT(google-explicit-constructor)
+        : bani(static_cast<std::int64_t>(ron * 100.0 + (ron >= 0 ? 0.5 : -0.5))) {}
+
+    /**
+     * @brief Builds an amount from a number of bani.
+     */
+    static constexpr Money fromBani(std::int64_t amount) {
+        Money money;
+        money.bani = amount;
+        return money;
+    }
+
+    /**
+     * @brief Returns the amount in bani.
+     */
+    [[nodiscard]] constexpr std::int64_t toBani() const {
+        return bani;
+    }
+
+    /**
+     * @brief Returns the amount in RON (for display or averages only).
+     */
+    [[nodiscard]] constexpr double toRon() const {
+        return static_cast<double>(bani) / 100.0;
+    }
+
+    constexpr Money& operator+=(Money other) {
+        bani += other.bani;
+        return *this;
+    }
+
+    constexpr Money& operator-=(Money other) {
+        bani -= other.bani;
+        return *this;
+    }
+
+    friend constexpr Money operator+(Money lhs, Money rhs) { return lhs += rhs; }
+    friend constexpr Money operator-(Money lhs, Money rhs) { return lhs -= rhs; }
+    friend constexpr Money operator*(Money price, std::int64_t quantity) { return fromBani(price.bani * quantity); }
+
+    constexpr auto operator<=>(const Money&) const = default;
+
+    /**
+     * @brief Formats the amount as RON: "20" for whole amounts, "12.50" otherwise.
+     */
+    [[nodiscard]] std::string toString() const;
+
+    static constexpr std::size_t MaxChars = 24; ///< Longest text of toChars(): sign, 19 digits, point and 2 decimals.
+
+    /**
+     * @brief Writes the amount like toString(), without allocating.
+     *
+     * @param first The start of the output; it must have room for MaxChars characters.
+     * @return One past the last character written.
+     */
+    char* toChars(char* first) const;
+
+    friend std::ostream& operator<<(std::ostream& os, const Money& money);
+};
+
+static_assert(sizeof(Money) == sizeof(std::int64_t) && std::is_trivially_copyable_v<Money>,
+              "Money must stay layout-compatible with int64 for the SIMD kernels");
+
+#endif // MONEY_H
@@ -0,0 +1,112 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/**
+ * @class MpscQueue
+ * @brief Bounded lock-free queue for many producer threads and one consumer thread.
+ *
+ * The queue is a ring of cells, each with a sequence number telling whether it is
+ * free for the producer of a given position or filled for the consumer. Producers
+ * claim a position with one compare-and-swap on the tail; the consumer owns the head
+ * alone. Neither side takes a lock or allocates after construction.
+ *
+ * @tparam T The element type; it must be default-constructible and move-assignable.
+ */
+template <typename T>
+class MpscQueue {
+public:
+    /**
+     * @brief Creates an empty queue.
+     *
+     * @param capacity The maximum number of elements, rounded up to a power of two.
+     */
+    explicit MpscQueue(std::size_t capacity)
+        : mask(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1), cells(std::make_unique<Cell[]>(mask + 1)) {
+        for (std::size_t i = 0; i <= mask; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * @brief Appends an element; safe to call from any number of threads.
+     *
+     * @param value The element; it is only moved from if the push succeeds.
+     * @return false if the queue is full.
+     */
+    bool tryPush(T& value) {
+        std::size_t position = tail.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+            if (difference == 0) {
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false;  // The consumer has not freed this cell yet
+            } else {
+                position = tail.load(std::memory_order_relaxed);  // Another producer took the position
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest element; only the consumer thread may call it.
+     *
+     * @param value Receives the element.
+     * @return false if the queue is empty.
+     */
+    bool tryPop(T& value) {
+        Cell& cell = cells[head & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.sequence.store(head + mask + 1, std::memory_order_release);
+        ++head;
+        return true;
+    }
+
+    /**
+     * @brief Checks if an element is ready for the consumer; only the consumer thread may call it.
+     */
+    [[nodiscard]] bool empty() const {
+        return cells[head & mask].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+
+    /**
+     * @brief Returns the maximum number of elements.
+     */
+    [[nodiscard]] std::size_t capacity() const {
+        return mask + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        T value{};
+    };
+
+    const std::size_t mask;
+    std::unique_ptr<Cell[]> cells;
+    alignas(64) std::atomic<std::size_t> tail{0}; ///< Next position claimed by a producer.
+    alignas(64) std::size_t head = 0;             ///< Next position read by the consumer.
+};
+
+#endif // MPSC_QUEUE_H
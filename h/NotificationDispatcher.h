@@ -0,0 +1,112 @@
+#ifndef NOTIFICATION_DISPATCHER_H
+#define NOTIFICATION_DISPATCHER_H
+
+#include "MpscQueue.h"
+#include "Observer.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief What NotificationDispatcher::post does when the queue is full.
+ */
+enum class BackpressurePolicy {
+    Block,      ///< Wait until the dispatcher frees a slot; nothing is lost.
+    DropNewest, ///< Discard the new notification and count it in dropped().
+};
+
+/**
+ * @brief How notifications waiting in the same batch are merged.
+ */
+enum class CoalescePolicy {
+    None,        ///< Deliver every notification.
+    DropRepeats, ///< Skip an event equal to the previous one for the same observer.
+};
+
+/**
+ * @brief Settings of a NotificationDispatcher.
+ */
+struct DispatchOptions {
+    std::size_t capacity = 4096;  ///< Notifications the queue holds; rounded up to a power of two.
+    std::size_t maxBatch = 256;   ///< Notifications taken from the queue per batch.
+    BackpressurePolicy backpressure = BackpressurePolicy::Block;
+    CoalescePolicy coalesce = CoalescePolicy::None;
+};
+
+/**
+ * @class NotificationDispatcher
+ * @brief Delivers observer notifications on a background thread, in batches.
+ *
+ * post() copies the event into a bounded lock-free queue and returns, so the
+ * thread changing the subject never waits for a slow observer (unless the queue is
+ * full and the policy is Block). The dispatcher thread takes up to maxBatch
+ * notifications at a time and hands each observer its share through
+ * Observer::updateBatch, in posting order.
+ *
+ * An observer may post from inside update(). If the queue is full then, with the
+ * Block policy, the dispatcher thread cannot wait for itself: the notification is held
+ * back and delivered after everything queued before it, so each observer still sees
+ * its events in posting order.
+ *
+ * Observers must outlive the dispatcher, or call flush() before they are destroyed.
+ * An exception thrown by an observer is counted in failures() and delivery goes on.
+ */
+class NotificationDispatcher {
+public:
+    explicit NotificationDispatcher(const DispatchOptions& options = {});
+
+    /**
+     * @brief Delivers the notifications still queued, then stops the dispatcher thread.
+     */
+    ~NotificationDispatcher();
+
+    NotificationDispatcher(const NotificationDispatcher&) = delete;
+    NotificationDispatcher& operator=(const NotificationDispatcher&) = delete;
+
+    /**
+     * @brief Queues a notification for an observer; safe to call from any thread.
+     *
+     * @param observer The observer to notify.
+     * @param event The change; it is copied, the queue never allocates.
+     * @return false if the queue was full and the notification was dropped.
+     */
+    bool post(Observer& observer, const MenuEvent& event);
+
+    /**
+     * @brief Waits until every notification posted before the call has been delivered or coalesced.
+     */
+    void flush();
+
+    [[nodiscard]] std::uint64_t delivered() const { return deliveredCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t dropped() const { return droppedCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t coalesced() const { return coalescedCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t batches() const { return batchCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t failures() const { return failureCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Notification {
+        Observer* observer = nullptr;
+        MenuEvent event;
+    };
+
+    void run();
+    void wake();
+
+    const DispatchOptions options;
+    MpscQueue<Notification> queue;
+    std::atomic<std::uint64_t> posted{0};    ///< Notifications accepted by post().
+    std::atomic<std::uint64_t> processed{0}; ///< Notifications delivered or coalesced; flush() waits on it.
+    std::atomic<std::uint64_t> deliveredCount{0};
+    std::atomic<std::uint64_t> droppedCount{0};
+    std::atomic<std::uint64_t> coalescedCount{0};
+    std::atomic<std::uint64_t> batchCount{0};
+    std::atomic<std::uint64_t> failureCount{0};
+    std::atomic<bool> sleeping{false};       ///< Set by the dispatcher thread before it waits for work.
+    std::atomic<bool> stopping{false};
+    std::vector<Notification> overflow;      ///< Posts from the dispatcher thread that found the queue full; only it touches them.
+    std::thread worker;                      ///< Started last, once every other member exists.
+};
+
+#endif // NOTIFICATION_DISPATCHER_H
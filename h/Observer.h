@@ -1,7 +1,8 @@
 #ifndef OBSERVER_H
 #define OBSERVER_H
 
-#include <string>
+#include "MenuEvent.h"
+#include <span>
 
 /**
  * @brief Interface for observer objects that react to changes in the subject.
@@ -12,9 +13,23 @@ public:
 
     /**
      * @brief React to a notification from the subject.
-     * @param message The notification message describing the change.
+     * @param event The change; it is only valid during the call, copy it to keep it.
      */
-    virtual void update(const std::string& message) = 0;
+    virtual void update(const MenuEvent& event) = 0;
+
+    /**
+     * @brief React to several notifications at once, as delivered by a NotificationDispatcher.
+     *
+     * The default calls update() for each event; override it to pay per-batch costs
+     * (such as flushing a stream) once instead of once per event.
+     *
+     * @param events The changes, oldest first.
+     */
+    virtual void updateBatch(std::span<const MenuEvent> events) {
+        for (const auto& event : events) {
+            update(event);
+        }
+    }
 };
 
 #endif // OBSERVER_H
@@ -0,0 +1,79 @@
+#ifndef ORDER_H
+#define ORDER_H
+
+#include "Money.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The kitchen station that prepares a dish, chosen from its food types.
+ */
+enum class KitchenStation : std::uint8_t {
+    Grill,  ///< Dishes with meat.
+    Oven,   ///< Dishes with cereals (pizza, pasta, bread).
+    Pastry, ///< Desserts.
+    Cold,   ///< Everything else (salads, starters).
+};
+
+inline constexpr std::size_t KitchenStationCount = 4;
+
+/**
+ * @brief The stage an order has reached in the OrderPipeline.
+ */
+enum class OrderStatus : std::uint8_t {
+    Received,
+    Validated,
+    Priced,
+    Routed,
+    Completed,
+    Rejected,
+};
+
+/**
+ * @brief One dish of an order, with the quantity asked for.
+ *
+ * The customer fills in the names and the quantity; the pipeline fills in the rest.
+ */
+struct OrderLine {
+    std::string categoryName;
+    std::string dishName;
+    unsigned quantity = 1;
+    Money unitPrice{};                              ///< Price on the menu when the order was priced.
+    KitchenStation station = KitchenStation::Cold;  ///< Station the line was routed to.
+};
+
+/**
+ * @brief A customer order flowing through the OrderPipeline.
+ */
+struct Order {
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t id = 0;
+    std::vector<OrderLine> lines{};
+    OrderStatus status = OrderStatus::Received;
+    Money total{};                     ///< Sum of the line prices, set when the order is priced.
+    std::string rejection{};           ///< Why the order was rejected, if it was.
+    Clock::time_point received{};      ///< When the pipeline accepted the order.
+    Clock::time_point completed{};     ///< When the order was completed or rejected.
+
+    /**
+     * @brief Prints the order id, status, lines and total.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Order& order);
+};
+
+/**
+ * @brief Returns the name of a kitchen station (e.g., "Grill").
+ */
+const char* toString(KitchenStation station);
+
+/**
+ * @brief Returns the name of an order status (e.g., "Completed").
+ */
+const char* toString(OrderStatus status);
+
+#endif // ORDER_H
@@ -0,0 +1,147 @@
+#ifndef ORDER_PIPELINE_H
+#define ORDER_PIPELINE_H
+
+#include "IngredientStock.h"
+#include "MenuManager.h"
+#include "Order.h"
+#include "ThreadPool.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Hooks of an OrderPipeline.
+ */
+struct PipelineOptions {
+    /// Called by a station for each line it prepares, e.g., to simulate cooking; nothing by default.
+    /// A throw rejects the order with the exception's message once its other stations are done.
+    std::function<void(KitchenStation, const OrderLine&)> prepare;
+    /// Called with every completed or rejected order, on a worker thread. Should not throw: the order
+    /// still counts as finished, and the exception is only counted in OrderPipeline::hookFailures().
+    std::function<void(const Order&)> onFinished;
+    /// Stock whose ingredients validation reserves for each line; none (unlimited ingredients) by default.
+    IngredientStock* stock = nullptr;
+};
+
+/**
+ * @brief Latency percentiles of the orders finished by an OrderPipeline.
+ */
+struct LatencySummary {
+    std::uint64_t count = 0;
+    std::chrono::nanoseconds p50{};
+    std::chrono::nanoseconds p99{};
+    std::chrono::nanoseconds max{};
+};
+
+/**
+ * @class OrderPipeline
+ * @brief Processes orders in stages on a ThreadPool: validate, price, route, prepare, complete.
+ *
+ * Each stage of an order is a separate task, so the stages of different orders overlap
+ * on the workers. An order is validated and priced against the menu published by the
+ * MenuManager when the order arrives; it keeps that version until it is finished, even
+ * if a new menu is published meanwhile. With an IngredientStock, validation also
+ * reserves the ingredients of every line, and rejects the whole order on a shortfall. Routing sends each line to a kitchen station
+ * by the food types of its dish, and the stations of one order prepare their lines in
+ * parallel; the order completes when the last station is done.
+ *
+ * An exception thrown in a stage (e.g., std::bad_alloc or the prepare hook) rejects the
+ * order with its message and releases the stock it reserved, so drain() never waits for
+ * an order that cannot finish.
+ */
+class OrderPipeline {
+public:
+    /**
+     * @brief Creates a pipeline; menus and pool must outlive it.
+     *
+     * @param menus The manager whose published menu validates and prices the orders.
+     * @param pool The workers that run the stages.
+     * @param options The station and completion hooks.
+     */
+    OrderPipeline(MenuManager& menus, ThreadPool& pool, PipelineOptions options = {});
+
+    /**
+     * @brief Destroying the pipeline waits for the orders still in flight.
+     */
+    ~OrderPipeline();
+
+    OrderPipeline(const OrderPipeline&) = delete;
+    OrderPipeline& operator=(const OrderPipeline&) = delete;
+
+    /**
+     * @brief Accepts an order and starts validating it; returns immediately.
+     *
+     * @param order The order, with its lines filled in by the customer.
+     */
+    void submit(Order order);
+
+    /**
+     * @brief Blocks until every order submitted so far is completed or rejected.
+     */
+    void drain();
+
+    [[nodiscard]] std::uint64_t completed() const { return completedCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t rejected() const { return rejectedCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of orders whose completion could not be recorded in full, e.g., because onFinished threw.
+     */
+    [[nodiscard]] std::uint64_t hookFailures() const { return hookFailureCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the p50, p99 and maximum time from submit() to completion of the finished orders.
+     */
+    [[nodiscard]] LatencySummary latency() const;
+
+private:
+    /**
+     * @brief An order between two stages, shared by the tasks of its stations.
+     */
+    struct InFlight {
+        Order order;
+        MenuManager::Snapshot menu;                                     ///< Menu version of the order.
+        std::vector<const Dish*> dishes;                                ///< Dish of each line, in that version.
+        std::array<std::vector<std::size_t>, KitchenStationCount> stationLines; ///< Lines routed to each station.
+        std::atomic<unsigned> stationsLeft{0};
+        std::atomic<bool> failed{false};                                ///< A station failed; failure says why.
+        std::string failure;                                            ///< Written by the first failing station only.
+        bool reserved = false;                                          ///< The stock holds the ingredients of every line.
+        std::atomic<bool> finished{false};                              ///< finish() ran; it counts an order once.
+    };
+
+    using Job = std::shared_ptr<InFlight>;
+
+    void validate(Job job);
+    void price(Job job);
+    void route(Job job);
+    void prepare(const Job& job, KitchenStation station);
+    void runStage(const Job& job, void (OrderPipeline::*stage)(Job));
+    void fail(const Job& job, std::string reason);
+    void stationsDone(const Job& job, unsigned count);
+    void reject(Job job, std::string reason);
+    void finish(Job job);
+
+    MenuManager& menus;
+    ThreadPool& pool;
+    const PipelineOptions options;
+    std::atomic<std::uint64_t> completedCount{0};
+    std::atomic<std::uint64_t> rejectedCount{0};
+    std::atomic<std::uint64_t> hookFailureCount{0};
+
+    std::mutex inFlightMutex;
+    std::condition_variable allFinished;
+    std::uint64_t inFlight = 0;                         ///< Orders submitted and not finished; guarded by inFlightMutex.
+
+    mutable std::mutex latencyMutex;
+    std::vector<std::chrono::nanoseconds> latencies;    ///< Guarded by latencyMutex.
+};
+
+#endif // ORDER_PIPELINE_H
@@ -0,0 +1,47 @@
+#ifndef PRICE_TOTALS_H
+#define PRICE_TOTALS_H
+
+#include "Money.h"
+#include <cstdint>
+#include <span>
+
+/**
+ * @class PriceTotals
+ * @brief Bulk totaling of prices for order lines and batch jobs.
+ *
+ * The kernels add 64-bit bani amounts, so totals are exact. On x86-64 builds with
+ * GCC or Clang an AVX2 kernel is selected at runtime when the CPU supports it;
+ * every other target uses the scalar kernel.
+ */
+class PriceTotals {
+public:
+    /**
+     * @brief Adds up a contiguous array of prices.
+     *
+     * @param prices The prices to add.
+     * @return The exact total.
+     */
+    static Money sum(std::span<const Money> prices);
+
+    /**
+     * @brief Adds up the prices selected by a list of row ids (e.g., DishIds of order lines).
+     *
+     * @param prices The price column to read from.
+     * @param ids The rows to add; ids may repeat and must be smaller than prices.size().
+     * @return The exact total.
+     */
+    static Money sumSelected(std::span<const Money> prices, std::span<const std::uint32_t> ids);
+
+    /**
+     * @brief Scalar reference kernels, always available (used by the benchmarks for comparison).
+     */
+    static Money sumScalar(std::span<const Money> prices);
+    static Money sumSelectedScalar(std::span<const Money> prices, std::span<const std::uint32_t> ids);
+
+    /**
+     * @brief Returns the name of the kernel chosen at runtime ("avx2" or "scalar").
+     */
+    static const char* activeKernel();
+};
+
+#endif // PRICE_TOTALS_H
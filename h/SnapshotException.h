@@ -0,0 +1,16 @@
+#ifndef SNAPSHOT_EXCEPTION_H
+#define SNAPSHOT_EXCEPTION_H
+
+#include "MenuException.h"
+
+// Exception class to handle errors while writing or loading a menu snapshot
+// (I/O failures, wrong magic or version, truncated or inconsistent files).
+class SnapshotException : public MenuException {
+public:
+    // Constructor to initialize the exception with an error message
+    // @param message: The error message describing the snapshot problem
+    explicit SnapshotException(const std::string& message)
+        : MenuException(message) {}  // Pass the message to the base class constructor
+};
+
+#endif // SNAPSHOT_EXCEPTION_H
@@ -1,35 +1,98 @@
 #ifndef SUBJECT_H
 #define SUBJECT_H
 
+#include "NotificationDispatcher.h"
 #include "Observer.h"
 #include <vector>
 #include <algorithm>
 
+/**
+ * @brief How a subject delivers notifications to one observer.
+ */
+enum class Delivery {
+    Async, ///< Through the subject's NotificationDispatcher if it has one, otherwise synchronously.
+    Sync,  ///< Always on the thread that changed the subject, before notify() returns.
+};
+
 /**
  * @brief Abstract base class for subjects that notify observers about changes.
+ *
+ * Without a dispatcher every observer is notified synchronously. Once setDispatcher()
+ * is called, observers attached with Delivery::Async receive their notifications on
+ * the dispatcher thread, so a slow observer no longer delays the change itself.
  */
 class Subject {
 private:
-    std::vector<Observer*> observers; ///< List of registered observers.
+    struct Registration {
+        Observer* observer;
+        Delivery delivery;
+    };
+
+    std::vector<Registration> observers; ///< List of registered observers.
+    NotificationDispatcher* dispatcher = nullptr; ///< Delivers the asynchronous notifications; not owned.
 
 public:
+    Subject() = default;
     virtual ~Subject() = default;
 
+    /**
+     * @brief A copy, or the target of a move, starts with no observers and no dispatcher.
+     *
+     * An observer attaches to one subject and detaches only from it, so a copy that kept
+     * the registrations would go on calling observers after they are destroyed. Attach
+     * an observer to each copy that it should follow. Assignment keeps the target's own
+     * observers and dispatcher.
+     */
+    Subject(const Subject&) noexcept {}
+    Subject(Subject&&) noexcept {}
+    Subject& operator=(const Subject&) noexcept { return *this; }
+    Subject& operator=(Subject&&) noexcept { return *this; }
+
     /**
      * @brief Add an observer to the list of observers.
      * @param observer The observer to add.
+     * @param delivery Delivery::Sync to keep receiving notifications on the changing thread.
+     */
+    void attach(Observer* observer, Delivery delivery = Delivery::Async) {
+        observers.push_back({observer, delivery});
+    }
+
+    /**
+     * @brief Remove an observer; notifications already queued in a dispatcher are still delivered.
+     * @param observer The observer to remove.
+     */
+    void detach(Observer* observer) {
+        std::erase_if(observers, [observer](const Registration& registration) {
+            return registration.observer == observer;
+        });
+    }
+
+    /**
+     * @brief Routes the notifications of Delivery::Async observers through a dispatcher.
+     * @param asyncDispatcher The dispatcher, which must outlive the subject, or nullptr to notify synchronously again.
+     */
+    void setDispatcher(NotificationDispatcher* asyncDispatcher) {
+        dispatcher = asyncDispatcher;
+    }
+
+    /**
+     * @brief Checks if any observer is attached, so a subject can skip building events nobody receives.
      */
-    void attach(Observer* observer) {
-        observers.push_back(observer);
+    [[nodiscard]] bool hasObservers() const {
+        return !observers.empty();
     }
 
     /**
      * @brief Notify all registered observers about a change.
-     * @param message The notification message.
+     * @param event The change.
      */
-    void notify(const std::string& message) {
-        for (auto* observer : observers) {
-            observer->update(message);
+    void notify(const MenuEvent& event) {
+        for (const auto& [observer, delivery] : observers) {
+            if (dispatcher != nullptr && delivery == Delivery::Async) {
+                dispatcher->post(*observer, event);
+            } else {
+                observer->update(event);
+            }
         }
     }
 };
@@ -0,0 +1,70 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * @brief Compact id of an interned string.
+ *
+ * Two equal strings always map to the same Symbol, so symbols can be compared
+ * and hashed as plain integers.
+ */
+using Symbol = std::uint32_t;
+
+/**
+ * @class SymbolTable
+ * @brief Global flyweight pool for dish and ingredient names.
+ *
+ * Each distinct name is stored exactly once, in large contiguous blocks, and is
+ * identified by a 4-byte Symbol. Interned text is never freed or moved, so the
+ * views returned by view() stay valid for the lifetime of the program.
+ *
+ * find() and view() take no lock, and neither does intern() for a name already in
+ * the table. Names are spread over 64 shards by hash, so only threads interning new
+ * names that fall in the same shard wait for each other. Each shard is an open-
+ * addressing table, replaced by one twice as large when half full; outgrown tables
+ * are kept until exit because a reader may still be probing them.
+ */
+class SymbolTable {
+public:
+    /**
+     * @brief Returns the symbol for the given text, adding it to the table if needed.
+     *
+     * @param text The text to intern.
+     * @return The symbol identifying the text.
+     */
+    static Symbol intern(std::string_view text);
+
+    /**
+     * @brief Looks up a symbol without adding the text to the table.
+     *
+     * @param text The text to look up.
+     * @return The symbol, or std::nullopt if the text was never interned.
+     */
+    static std::optional<Symbol> find(std::string_view text);
+
+    /**
+     * @brief Returns the text of an interned symbol.
+     *
+     * @param symbol A symbol previously returned by intern().
+     * @return A view of the interned text.
+     */
+    static std::string_view view(Symbol symbol);
+
+    /**
+     * @brief Returns the number of distinct interned strings.
+     */
+    static std::size_t size();
+
+    /**
+     * @brief Returns the approximate number of heap bytes owned by the table.
+     *
+     * Includes the text blocks, the symbol entries and the lookup tables, outgrown ones too.
+     */
+    static std::size_t memoryUsage();
+};
+
+#endif // SYMBOL_TABLE_H
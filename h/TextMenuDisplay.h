@@ -0,0 +1,17 @@
+#ifndef TEXTMENUDISPLAY_H
+#define TEXTMENUDISPLAY_H
+
+
+#include "MenuDisplayStrategy.h"
+
+/**
+ * @brief Strategy encoding a menu as the plain text of print(): its title, then one line per dish.
+ */
+class TextMenuDisplay final : public MenuDisplayStrategy {
+public:
+    void encode(const Menu& menu, MenuRenderer& out) const override {
+        out.menuListing(menu);
+    }
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Fixed set of worker threads that balance their tasks by work stealing.
+ *
+ * Every worker owns a task deque. A task submitted by a worker goes to the back of
+ * its own deque and is run from there, newest first, so a chain of dependent tasks
+ * stays on one warm core. An idle worker steals the oldest task from the front of
+ * another worker's deque. Tasks submitted from other threads are spread over the
+ * deques in turn. Submitting takes only the lock of the target deque while every
+ * worker is busy; the shared sleep lock is taken only to wake a sleeping worker.
+ *
+ * The destructor runs every task already submitted, then stops the workers.
+ */
+class ThreadPool {
+public:
+    using Task = std::move_only_function<void()>;
+
+    /**
+     * @brief Starts the workers.
+     *
+     * @param threads The number of workers; 0 uses one per hardware thread.
+     */
+    explicit ThreadPool(std::size_t threads = 0);
+
+    /**
+     * @brief Runs the remaining tasks, then joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Queues a task; it may be called from inside another task.
+     *
+     * A task that throws is counted in failures() and does not stop its worker.
+     *
+     * @param task The function to run on a worker.
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Blocks until every submitted task has run, including the tasks they submitted.
+     *
+     * Must not be called from inside a task.
+     */
+    void wait();
+
+    /**
+     * @brief Runs body(0), ..., body(count - 1) as tasks and blocks until they have all returned.
+     *
+     * Unlike wait(), it waits only for these calls, so other work may go on in the pool.
+     * Must not be called from inside a task.
+     *
+     * @param count The number of calls.
+     * @param body The function to call with each index; it must be safe to call from several workers at once.
+     * @throws Whatever the first failing call threw, once every call has returned.
+     */
+    void forEach(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    /**
+     * @brief Returns the number of workers.
+     */
+    [[nodiscard]] std::size_t size() const { return workers.size(); }
+
+    /**
+     * @brief Returns the number of tasks a worker took from another worker's deque.
+     */
+    [[nodiscard]] std::uint64_t steals() const { return stealCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Returns the number of tasks that ended with an exception.
+     */
+    [[nodiscard]] std::uint64_t failures() const { return failureCount.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool tryRunOne(std::size_t self);
+    void run(std::size_t self);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> nextWorker{0};     ///< Deque of the next task submitted from outside.
+    std::atomic<std::size_t> queued{0};         ///< Tasks waiting in a deque.
+    std::atomic<std::size_t> unfinished{0};     ///< Tasks submitted and not finished yet.
+    std::atomic<std::size_t> sleepers{0};       ///< Workers waiting for work; submit() wakes one only if there are any.
+    std::atomic<std::uint64_t> stealCount{0};
+    std::atomic<std::uint64_t> failureCount{0};
+
+    std::mutex sleepMutex;                      ///< Guards the sleeping and idle waits.
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    bool stopping = false;                      ///< Guarded by sleepMutex.
+
+    std::vector<std::jthread> threads;          ///< Started last, once every other member exists.
+};
+
+#endif // THREAD_POOL_H
@@ -0,0 +1,104 @@
+#ifndef TIME_OF_DAY_H
+#define TIME_OF_DAY_H
+
+#include <cstdint>
+#include <compare>
+#include <string>
+#include <string_view>
+#include <iostream>
+
+/**
+ * @brief A time of day stored as minutes since midnight.
+ *
+ * Replaces the "HH:MM" strings that used to be compared lexicographically.
+ * Comparing two TimeOfDay values is a single integer comparison.
+ */
+class TimeOfDay {
+private:
+    std::uint16_t minutes; ///< Minutes since midnight, in [0, MinutesPerDay).
+
+public:
+    static constexpr std::uint16_t MinutesPerDay = 24 * 60; ///< Number of one-minute slots in a day.
+
+    /**
+     * @brief Constructs midnight (00:00).
+     */
+    constexpr TimeOfDay() : minutes(0) {}
+
+    /**
+     * @brief Constructs a time of day from hours and minutes.
+     *
+     * @param hours The hour, in [0, 23].
+     * @param mins The minute, in [0, 59].
+     */
+    constexpr TimeOfDay(int hours, int mins) : minutes(static_cast<std::uint16_t>(hours * 60 + mins)) {}
+
+    /**
+     * @brief Builds a time of day from a minute index.
+     *
+     * @param minutesSinceMidnight The minute of the day, in [0, MinutesPerDay).
+     * @return The corresponding TimeOfDay.
+     */
+    static constexpr TimeOfDay fromMinutes(std::uint16_t minutesSinceMidnight) {
+        return {minutesSinceMidnight / 60, minutesSinceMidnight % 60};
+    }
+
+    /**
+     * @brief Parses a time in "HH:MM" format.
+     *
+     * @param text The time to parse (e.g., "08:30").
+     * @return The parsed TimeOfDay.
+     * @throws InvalidTimeException If the text is not a valid "HH:MM" time.
+     */
+    static TimeOfDay parse(std::string_view text);
+
+    /**
+     * @brief Returns the number of minutes since midnight.
+     */
+    [[nodiscard]] constexpr std::uint16_t minutesSinceMidnight() const {
+        return minutes;
+    }
+
+    /**
+     * @brief Formats the time as "HH:MM".
+     */
+    [[nodiscard]] std::string toString() const;
+
+    constexpr auto operator<=>(const TimeOfDay&) const = default;
+
+    friend std::ostream& operator<<(std::ostream& os, const TimeOfDay& time);
+};
+
+/**
+ * @brief An inclusive interval of the day during which something is available.
+ *
+ * A window whose start is after its end wraps around midnight (e.g., 22:00 - 02:00).
+ */
+struct TimeWindow {
+    TimeOfDay start; ///< First available minute.
+    TimeOfDay end;   ///< Last available minute.
+
+    /**
+     * @brief Returns a window covering the whole day.
+     */
+    static constexpr TimeWindow allDay() {
+        return {TimeOfDay(0, 0), TimeOfDay::fromMinutes(TimeOfDay::MinutesPerDay - 1)};
+    }
+
+    /**
+     * @brief Checks whether the given time falls inside the window.
+     *
+     * @param time The time to check.
+     * @return True if the time is inside the window, false otherwise.
+     */
+    [[nodiscard]] constexpr bool contains(TimeOfDay time) const {
+        if (start <= end) {
+            return start <= time && time <= end;
+        }
+        return time >= start || time <= end;
+    }
+
+    constexpr bool operator==(const TimeWindow&) const = default;
+};
+
+#endif // TIME_OF_DAY_H
@@ -9,6 +9,7 @@
 #include "../h/InvalidTimeException.h"
 #include "../h/EmptyMenuException.h"
 #include "../h/InvalidDishException.h"
+#include "../h/DuplicateCategoryException.h"
 #include "MenuContext.h"
 #include "BreakfastMenuDisplay.h"
 #include "LunchMenuDisplay.h"
@@ -17,6 +18,26 @@
 #include "MenuInventory.h"
 #include"Menu.h"
 #include "MenuManager.h"
+#include "AvailabilityTimeline.h"
+#include "DishCatalog.h"
+#include "MenuGenerator.h"
+#include "MenuSnapshot.h"
+#include "MenuImporter.h"
+#include "MenuArena.h"
+#include "NotificationDispatcher.h"
+#include "MenuJournal.h"
+#include "MenuVersionStore.h"
+#include "OrderPipeline.h"
+#include "MenuSearchIndex.h"
+#include "MenuRenderCache.h"
+#include "MenuQuery.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <filesystem>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
 void initializeMenu(Menu& menu) {
     try {
         menu.checkAvailability("10:00");         // Call through the Menu instance
@@ -87,10 +108,12 @@ int main() {
         std::cout << "\n";
     }
     std::cout << "Number of Dish instances: " << Dish::getInstanceCount() << "\n";
+    std::cout << "Distinct dish and ingredient names: " << SymbolTable::size() << "\n";  ///< Shared through the SymbolTable
 
     // Calculate the average price of dishes (template instantiation)
-    std::vector<float> prices = {dish1.getPrice(), dish2.getPrice(), dish3.getPrice(), dish4.getPrice(), dish5.getPrice(), dish6.getPrice()};
-    float averagePrice = calculateAverage(prices);  ///< Template instantiation for float
+    std::vector<double> prices = {dish1.getPrice().toRon(), dish2.getPrice().toRon(), dish3.getPrice().toRon(),
+                                  dish4.getPrice().toRon(), dish5.getPrice().toRon(), dish6.getPrice().toRon()};
+    double averagePrice = calculateAverage(prices);  ///< Template instantiation for double
     std::cout << "Average price of dishes: " << averagePrice << " RON\n";
 
     // Another example of template instantiation with an int vector
@@ -105,28 +128,32 @@ int main() {
 
     // Example of calculating the total price for ordered dishes
     std::vector<Dish> orderedDishes = {dish1, dish3};  ///< Example of ordered dishes: Margherita Pizza, Chocolate Cake
-    float totalPrice = Menu::calculateTotalPrice(orderedDishes);  ///< Calculate the total price
+    Money totalPrice = Menu::calculateTotalPrice(orderedDishes);  ///< Calculate the exact total price
     std::cout << "Total price for ordered dishes: " << totalPrice << " RON\n";
 
-    // Check if each menu is vegetarian
-    std::cout << "---------- Vegetarian Check ----------\n";
-    bool allVegetarian = true;
-    for (const auto& dish : breakfastCategory.getDishes()) {
-        if (!dish.isVegetarian()) {
-            allVegetarian = false;
-            break;
+    // Flatten the lunch menu into the column store and scan it without touching Dish objects
+    {
+        DishCatalog catalog;
+        const MenuView lunchView = catalog.addMenu(lunch);  // Follows the menu's changes until the catalog goes away
+        for (std::uint32_t i = 0; i < lunchView.size(); ++i) {
+            const CategoryView category = lunchView.category(i);
+            std::cout << category.getName() << " (catalog): " << category.size() << " dishes, "
+                      << category.vegetarianDishes().size() << " vegetarian, total " << category.totalPrice() << " RON\n";
         }
     }
-    std::cout << "Is the breakfast menu vegetarian? " << (allVegetarian ? "Yes" : "No") << "\n";
 
-    allVegetarian = true;
-    for (const auto& dish : lunchCategory.getDishes()) {
-        if (!dish.isVegetarian()) {
-            allVegetarian = false;
-            break;
-        }
+    // Look up categories and dishes by name through the menu's index
+    if (const Dish* salad = lunch.findDish("Lunch", "Chicken Caesar Salad")) {
+        std::cout << "Found " << salad->getName() << " in the lunch menu for " << salad->getPrice() << " RON\n";
     }
-    std::cout << "Is the lunch menu vegetarian? " << (allVegetarian ? "Yes" : "No") << "\n\n";
+    std::cout << "Lunch menu has a Drinks category? " << (lunch.findCategory("Drinks") != nullptr ? "Yes" : "No") << "\n";
+
+    // Check if each menu is vegetarian
+    std::cout << "---------- Vegetarian Check ----------\n";
+    std::cout << "Is the breakfast menu vegetarian? " << (breakfastCategory.isVegetarian() ? "Yes" : "No") << "\n";
+    std::cout << "Is the lunch menu vegetarian? " << (lunchCategory.isVegetarian() ? "Yes" : "No") << "\n";
+    std::cout << "Vegan and gluten-free dishes on the lunch menu: "
+              << lunch.filter(DietaryFilter::vegan() & DietaryFilter::glutenFree()).size() << "\n\n";
 
     // Check menu availability at a specific time (e.g., 14:00 for lunch)
     std::string time = "14:00";  ///< Example time: 14:00 (lunch time)
@@ -150,6 +177,214 @@ int main() {
         std::cout << "Dinner menu is not available at " << time << ".\n";
     }
 
+    // Precompute availability once so every later lookup is a single bit test
+    AvailabilityTimeline timeline;
+    const auto breakfastId = timeline.addMenu(breakfast);
+    timeline.addMenu(lunch);
+    timeline.addMenu(dinner);
+    dessertCategory.setAvailability({TimeOfDay(12, 0), TimeOfDay(22, 0)});
+    timeline.addCategory(dessertCategory);
+
+    const TimeOfDay now = TimeOfDay::parse(time);
+    std::cout << "Entries available at " << now << " (timeline): " << timeline.availableAt(now).size()
+              << " of " << timeline.size() << "\n";
+    std::cout << "Breakfast available at 09:15 (timeline)? "
+              << (timeline.isAvailable(breakfastId, TimeOfDay(9, 15)) ? "Yes" : "No") << "\n";
+
+    // Stream a seeded synthetic catalog; only one category is kept in memory at a time
+    MenuGenerator generator;
+    std::size_t vegetarianSynthetic = 0;
+    const std::size_t syntheticCategories = generator.streamCategories(10000, 0, [&](Category&& category) {
+        vegetarianSynthetic += category.filter(DietaryFilter::vegetarian()).size();
+    });
+    std::cout << "Synthetic catalog: 10000 dishes in " << syntheticCategories << " categories, "
+              << vegetarianSynthetic << " vegetarian\n";
+
+    // Save the lunch menu as a binary snapshot and load it back without rebuilding objects
+    const std::string snapshotPath = (std::filesystem::temp_directory_path() / "lunch.menusnap").string();
+    MenuSnapshot::write(lunch, snapshotPath);
+    const MenuSnapshot snapshot = MenuSnapshot::open(snapshotPath);
+    std::cout << "Snapshot: " << snapshot.categoryCount() << " categories, " << snapshot.dishCount() << " dishes, "
+              << snapshot.fileSize() << " bytes; first dish " << snapshot.dish(0).getName() << " costs "
+              << snapshot.dish(0).getPrice() << " RON\n";
+    std::filesystem::remove(snapshotPath);
+
+    // Import a supplier export; the malformed row is reported and the rest of the file still loads
+    std::istringstream supplierExport("category,dish,price,weight,ingredients\n"
+                                      "Soups,Ciorba de burta,24.50,400,Tripe:MEAT;Sour cream:DAIRY\n"
+                                      "Soups,Borsch,abc,300,Beetroot:VEGETABLE\n"
+                                      "Soups,\"Supa crema, ciuperci\",19,350,Mushrooms:VEGETABLE;Cream:DAIRY\n");
+    std::vector<Dish> importedDishes;
+    const ImportReport importReport = MenuImporter().importDishes(supplierExport, [&](std::string_view, Dish&& dish) {
+        importedDishes.push_back(std::move(dish));
+    });
+    std::cout << "Imported " << importReport.dishes << " dishes, " << importReport.rejected << " rejected\n";
+    for (const auto& error : importReport.errors) {
+        std::cout << "  " << error.what() << "\n";
+    }
+
+    // Copy the lunch menu into an arena: its categories and dishes share one block, freed at once
+    MenuArena arena;
+    const Lunch& arenaLunch = arena.copyMenu(lunch);
+    std::cout << "Arena lunch menu: " << arenaLunch.getCategory().size() << " categories in "
+              << arena.reservedBytes() << " bytes, Margherita Pizza "
+              << (arenaLunch.findDish("Margherita Pizza") != nullptr ? "found" : "missing") << "\n";
+
+    // Log the changes of a menu from a background thread: addCategory no longer waits for the console
+    {
+        NotificationDispatcher dispatcher;
+        MenuChangeLogger asyncLogger;
+        Lunch specials{std::pmr::vector<Category>()};
+        specials.setDispatcher(&dispatcher);
+        specials.attach(&asyncLogger);
+        specials.addCategory(Category("Soups", {}));
+        specials.addDish("Soups", Dish("Ciorba de perisoare", 18.0, 400.0f, {}));
+        specials.updateDishPrice("Soups", "Ciorba de perisoare", 19.5);
+        specials.removeCategory("Soups");
+        dispatcher.flush();  // [MenuChangeLogger] Category added: Soups ... Price changed: Ciorba de perisoare (Soups) 18 -> 19.50 RON ...
+        std::cout << "Dispatcher delivered " << dispatcher.delivered() << " notifications\n";
+    }
+
+    // Journal the changes of the day, then rebuild the menu as a restart would: last snapshot + journal tail
+    const std::string journalDirectory = (std::filesystem::temp_directory_path() / "oop_menu_journal").string();
+    std::filesystem::remove_all(journalDirectory);
+    {
+        Lunch dailyMenu({lunchCategory, dessertCategory});
+        MenuJournal journal(dailyMenu, journalDirectory);
+        dailyMenu.updateDishPrice("Lunch", "Margherita Pizza", 22.0);
+        dailyMenu.removeCategory("Desserts");
+    }  // The journal commits its last records when it is destroyed
+    const JournalRecovery recovery = MenuJournal::recover(journalDirectory);
+    std::cout << "Recovered " << recovery.menu->getCategory().size() << " categories from snapshot " << recovery.generation
+              << " and " << recovery.records << " journal records; Margherita Pizza now costs "
+              << recovery.menu->findDish("Margherita Pizza")->getPrice() << " RON\n";
+    std::filesystem::remove_all(journalDirectory);
+
+    // Publish the lunch menu to request threads, which read it without locks while a price update is published
+    MenuManager& manager = MenuManager::getInstance();
+    manager.setMenu(lunch.clone());
+    std::atomic<int> lockFreeReads{0};
+    {
+        std::vector<std::jthread> requestThreads;
+        for (int thread = 0; thread < 4; ++thread) {
+            requestThreads.emplace_back([&manager, &lockFreeReads] {
+                for (int request = 0; request < 1000; ++request) {
+                    manager.read([](const Menu& menu) { return menu.findDish("Margherita Pizza")->getPrice(); });
+                    lockFreeReads.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+        manager.update([](Menu& menu) { menu.updateDishPrice("Lunch", "Margherita Pizza", 24.0); });
+    }
+    std::cout << "MenuManager published version " << manager.version() << " during " << lockFreeReads.load()
+              << " lock-free reads; Margherita Pizza now costs "
+              << manager.read([](const Menu& menu) { return menu.findDish("Margherita Pizza")->getPrice(); }) << " RON\n";
+
+    // Send two orders through the kitchen pipeline, validated and priced against the published lunch menu
+    {
+        std::mutex finishedMutex;
+        std::vector<Order> finishedOrders;
+        ThreadPool kitchen;
+        OrderPipeline orders(manager, kitchen, {.prepare = {}, .onFinished = [&](const Order& order) {
+            const std::scoped_lock lock(finishedMutex);
+            finishedOrders.push_back(order);
+        }});
+        orders.submit({.id = 1, .lines = {{.categoryName = "Lunch", .dishName = "Margherita Pizza", .quantity = 2},
+                                          {.categoryName = "Desserts", .dishName = "Chocolate Cake"}}});
+        orders.submit({.id = 2, .lines = {{.categoryName = "Lunch", .dishName = "Beef Burger"}}});
+        orders.drain();
+        std::ranges::sort(finishedOrders, {}, &Order::id);
+        for (const auto& order : finishedOrders) {
+            std::cout << order;
+        }
+    }
+
+    // Track the kitchen stock: selling the last flour makes the pancakes unavailable until the next delivery
+    {
+        IngredientStock stock;
+        stock.setStock(ingr6, 5);
+        stock.setStock(ingr7, 1);
+        stock.trackDish(dish4);
+        const bool cakeSold = stock.reserve(dish3);
+        std::cout << "Chocolate Cake " << (cakeSold ? "sold" : "out of stock") << "; Pancakes "
+                  << (stock.isAvailable(dish4) ? "available" : "unavailable") << ", reserve "
+                  << (stock.reserve(dish4) ? "succeeded" : "failed") << " with " << *stock.unitsOf(ingr6) << " units of "
+                  << ingr6.getName() << " left";
+        stock.restock(ingr7, 10);
+        std::cout << "; after the delivery Pancakes are " << (stock.isAvailable(dish4) ? "available" : "unavailable") << "\n";
+    }
+
+    // Search the lunch menu as guests type: prefixes, typos, diacritics and ingredients
+    {
+        Lunch searchableMenu({lunchCategory, dessertCategory});
+        MenuSearchIndex searchIndex(searchableMenu);
+        searchableMenu.addDish("Lunch", Dish("Ciorbă de burtă", 22.0, 400, {ingr4}));
+        for (const std::string_view query : {"ciorba", "Piza", "choc", "mozz"}) {
+            std::cout << "Search \"" << query << "\":";
+            for (const SearchHit& hit : searchIndex.search(query, 3)) {
+                std::cout << " " << hit.dish->getName() << " (" << hit.category->getName() << ")";
+            }
+            std::cout << "\n";
+        }
+    }
+
+    // Redisplay the lunch menu from cached text: after a price change only that category is rendered again
+    {
+        Lunch kioskMenu({lunchCategory, dessertCategory});
+        MenuRenderCache renderCache(kioskMenu);
+        renderCache.display();
+        kioskMenu.updateDishPrice("Desserts", "Chocolate Cake", Money(16.0));
+        renderCache.display();
+        std::cout << "Render cache: " << renderCache.hits() << " hits, " << renderCache.misses() << " misses\n";
+    }
+
+    // Query the lunch menu with filters composed at compile time into one loop
+    {
+        const auto affordableVegetarian = query::availableAt(TimeOfDay(12, 0)) && query::price(0.0, 20.0)
+                                          && query::diet(DietaryFilter::vegetarian());
+        std::array<const Dish*, 8> found{};
+        const std::size_t count = query::select(lunch, affordableVegetarian, found);
+        std::cout << "Vegetarian dishes up to 20 RON at noon:";
+        for (const Dish* dish : std::span(found).first(count)) {
+            std::cout << " " << dish->getName();
+        }
+        std::cout << "; dishes without dairy outside Desserts: "
+                  << query::count(lunch, query::excludes(FoodType::DAIRY) && !query::inCategory("Desserts")) << "\n";
+    }
+
+    // Sort the lunch menu on the kitchen's threads: cheapest first, the most ordered first at the same price
+    {
+        Lunch sortedMenu({lunchCategory, dessertCategory});
+        sortedMenu.addDish("Lunch", Dish("Pasta al Pomodoro", 20.0, 300, {ingr5, ingr3, ingr2}));
+        const std::unordered_map<std::string_view, std::uint64_t> ordersServed{{"Margherita Pizza", 80}, {"Pasta al Pomodoro", 120}};
+        const DishOrdering byPrice({{DishSortField::Price}, {DishSortField::Popularity, true}}, [&](const Dish& dish) {
+            const auto served = ordersServed.find(dish.getName());
+            return served == ordersServed.end() ? std::uint64_t{0} : served->second;
+        });
+        ThreadPool sorters(2);
+        sortedMenu.sortCategories(sorters, byPrice);
+        std::cout << "Sorted by price:";
+        for (const auto& category : sortedMenu.getCategory()) {
+            std::cout << " " << category.getName() << " [";
+            for (const auto& dish : category.getDishes()) {
+                std::cout << (&dish == &category.getDishes().front() ? "" : ", ") << dish.getName();
+            }
+            std::cout << "]";
+        }
+        std::cout << "\n";
+    }
+
+    // Keep every version of the dinner menu, then look up what a dish cost when an order was placed
+    {
+        Dinner auditedMenu({dinnerCategory});
+        MenuVersionStore versions(auditedMenu);
+        const MenuVersionStore::Timestamp orderPlaced = MenuVersionStore::Clock::now();
+        auditedMenu.updateDishPrice("Dinner", "Grilled Salmon", auditedMenu.findDish("Grilled Salmon")->getPrice() + Money(5.0));
+        std::cout << "Grilled Salmon cost " << versions.dishAsOf("Dinner", "Grilled Salmon", orderPlaced)->getPrice()
+                  << " RON when the order was placed and costs " << auditedMenu.findDish("Grilled Salmon")->getPrice()
+                  << " RON now (" << versions.storedDishes() << " dish versions stored)\n";
+    }
+
     // ------------ Strategy Pattern Integration ------------
 
     // Create strategy instances for Breakfast, Lunch, and Dinner
@@ -174,6 +409,19 @@ int main() {
     std::cout << "\n---------- Strategy Pattern: Dinner Menu ----------\n";
     menuContext.displayMenu("Dinner");
 
+    // Encode the dinner menu for the kiosks in the wire format each one asks for, chosen at runtime
+    std::cout << "\n---------- Strategy Pattern: Wire Formats ----------\n";
+    for (const MenuFormat format : {MenuFormat::Text, MenuFormat::Json, MenuFormat::Binary}) {
+        menuContext.setFormat(format);
+        MenuRenderer encoded;
+        menuContext.encodeMenu(dinner, encoded);
+        if (format == MenuFormat::Binary) {
+            std::cout << "Binary: " << encoded.view().size() << " bytes\n";
+        } else {
+            std::cout << encoded.view() << "\n";
+        }
+    }
+
     // ------------ End of Strategy Pattern Integration ------------
 
     // Handle exceptions with try-catch blocks
@@ -208,6 +456,13 @@ int main() {
     Category pancakesCategory("Pancakes", {});
     breakfast.addCategory(pancakesCategory); // [MenuChangeLogger] Category added: Pancakes
 
+    // Category names are unique inside a menu
+    try {
+        breakfast.addCategory(pancakesCategory);
+    } catch (const DuplicateCategoryException& e) {
+        std::cout << "Caught DuplicateCategoryException: " << e.what() << std::endl;
+    }
+
     // Remove the category from the menu
     breakfast.removeCategory("Pancakes");    // [MenuChangeLogger] Category removed: Pancakes
 
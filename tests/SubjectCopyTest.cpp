@@ -0,0 +1,91 @@
+// Copies of a menu must not carry the observers of the original: an observer detaches only
+// from the menu it was attached to, so a copy keeping it would call it after its destruction
+#include "../h/Lunch.h"
+#include "../h/MenuVersionStore.h"
+#include "../h/Observer.h"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << what << "\n";
+        ++failures;
+    }
+}
+
+class CountingObserver : public Observer {
+public:
+    void update(const MenuEvent&) override { ++events; }
+    int events = 0;
+};
+
+Lunch makeMenu() {
+    std::pmr::vector<Dish> dishes;
+    dishes.emplace_back("Soup", Money(12.0), 300.0f, std::pmr::vector<Ingredient>{});
+    std::pmr::vector<Category> categories;
+    categories.emplace_back("Starters", std::move(dishes));
+    return Lunch(std::move(categories));
+}
+
+void cloneOutlivesObserver() {
+    Lunch menu = makeMenu();
+    std::unique_ptr<Menu> clone;
+    {
+        MenuVersionStore versions(menu);
+        clone = menu.clone();
+    }
+    // The store is gone; the clone must not notify it
+    check(!clone->hasObservers(), "a clone starts with no observers");
+    check(clone->updateDishPrice("Starters", "Soup", Money(13.0)), "the clone can be changed");
+    clone->addCategory(Category("Desserts", std::pmr::vector<Dish>{}));
+    check(clone->findDish("Starters", "Soup")->getPrice() == Money(13.0), "the clone holds the change");
+}
+
+void copiesStartWithoutObservers() {
+    Lunch menu = makeMenu();
+    CountingObserver observer;
+    menu.attach(&observer, Delivery::Sync);
+
+    Lunch copy = menu;
+    copy.updateDishPrice("Starters", "Soup", Money(14.0));
+    check(observer.events == 0, "a change of a copy does not notify the original's observers");
+
+    Lunch moved = std::move(copy);
+    moved.updateDishPrice("Starters", "Soup", Money(15.0));
+    check(observer.events == 0, "a moved-to menu starts with no observers");
+
+    menu.updateDishPrice("Starters", "Soup", Money(16.0));
+    check(observer.events == 1, "the original still notifies its observers");
+}
+
+void assignmentKeepsTargetObservers() {
+    Lunch source = makeMenu();
+    CountingObserver sourceObserver;
+    source.attach(&sourceObserver, Delivery::Sync);
+    Lunch target = makeMenu();
+    CountingObserver targetObserver;
+    target.attach(&targetObserver, Delivery::Sync);
+
+    target = source;
+    target.updateDishPrice("Starters", "Soup", Money(17.0));
+    check(targetObserver.events == 1, "assignment keeps the target's observers");
+    check(sourceObserver.events == 0, "assignment does not take the source's observers");
+    target.detach(&targetObserver);
+}
+
+} // namespace
+
+int main() {
+    cloneOutlivesObserver();
+    copiesStartWithoutObservers();
+    assignmentKeepsTargetObservers();
+    if (failures == 0) {
+        std::cout << "SubjectCopyTest passed\n";
+    }
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}